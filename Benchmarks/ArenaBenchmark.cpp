@@ -0,0 +1,116 @@
+#include <memory_resource>
+#include <string>
+#include <string_view>
+#include <vector>
+
+#include "Benchmark.h"
+#include "MonotonicArena.h"
+#include "StringClass.h"
+
+// Request scoped strings: 10000 requests, each making 64 strings of 23 to 86 characters (too long to fit inline) and then throwing all of them away
+// Before: every StringClass has its own new[] and delete[]. After: they come from a MonotonicArena that is reset once per request
+// std::string and std::pmr::string with a std::pmr::monotonic_buffer_resource do the same thing, for comparison
+// Copies: 1M copies of one long string, kept until the end, then all freed at once
+
+static const size_t s_Requests = 10000;
+static const size_t s_StringsPerRequest = 64;
+
+static const std::string s_Source = "GET /api/v1/users/12345/profile?fields=name,email,avatar&format=json HTTP/1.1 Host: example.com";
+
+// A different part of the source for each string
+static std::string_view Piece(size_t i)
+{
+	size_t length = 23 + (i * 7) % 64;
+	size_t start = (i * 13) % (s_Source.size() - length);
+	return std::string_view(s_Source).substr(start, length);
+}
+
+void RunArenaBenchmarks()
+{
+	BenchmarkReport::Get().BeginSuite("Arena strings: 10000 requests of 64 strings each");
+	const size_t count = s_Requests * s_StringsPerRequest;
+	size_t check = 0;
+
+	RunCountingBenchmark("StringClass, new[] and delete[]", count, [&]()
+	{
+		std::vector<StringClass> strings;
+		strings.reserve(s_StringsPerRequest);
+		for (size_t request = 0; request < s_Requests; request++)
+		{
+			for (size_t i = 0; i < s_StringsPerRequest; i++)
+				strings.emplace_back(Piece(request + i));
+			check += strings.back().Size();
+			strings.clear();
+		}
+	});
+
+	MonotonicArena arena;
+	RunCountingBenchmark("StringClass, MonotonicArena", count, [&]()
+	{
+		std::vector<StringClass> strings;
+		strings.reserve(s_StringsPerRequest);
+		for (size_t request = 0; request < s_Requests; request++)
+		{
+			for (size_t i = 0; i < s_StringsPerRequest; i++)
+				strings.emplace_back(Piece(request + i), arena);
+			check += strings.back().Size();
+			strings.clear();
+			arena.Reset();
+		}
+	});
+
+	RunCountingBenchmark("std::string", count, [&]()
+	{
+		std::vector<std::string> strings;
+		strings.reserve(s_StringsPerRequest);
+		for (size_t request = 0; request < s_Requests; request++)
+		{
+			for (size_t i = 0; i < s_StringsPerRequest; i++)
+				strings.emplace_back(Piece(request + i));
+			check += strings.back().size();
+			strings.clear();
+		}
+	});
+
+	// The pmr vector uses the resource too, so it is made again for every request
+	std::vector<char> buffer(64 * 1024);
+	RunCountingBenchmark("std::pmr::string, monotonic_buffer_resource", count, [&]()
+	{
+		for (size_t request = 0; request < s_Requests; request++)
+		{
+			std::pmr::monotonic_buffer_resource resource(buffer.data(), buffer.size());
+			std::pmr::vector<std::pmr::string> strings(&resource);
+			strings.reserve(s_StringsPerRequest);
+			for (size_t i = 0; i < s_StringsPerRequest; i++)
+				strings.emplace_back(Piece(request + i));
+			check += strings.back().size();
+		}
+	});
+	DoNotOptimize(check);
+
+	BenchmarkReport::Get().BeginSuite("Arena strings: 1M copies of a 86 character string");
+	const size_t copyCount = 1 << 20;
+	StringClass source(s_Source.substr(0, 86));
+
+	RunCountingBenchmark("StringClass, new[] and delete[]", copyCount, [&]()
+	{
+		std::vector<StringClass> strings;
+		strings.reserve(copyCount);
+		for (size_t i = 0; i < copyCount; i++)
+			strings.emplace_back(source);
+		DoNotOptimize(strings.back());
+	});
+
+	MonotonicArena bigArena(1 << 20);
+	RunCountingBenchmark("StringClass, MonotonicArena", copyCount, [&]()
+	{
+		std::vector<StringClass> strings;
+		strings.reserve(copyCount);
+		for (size_t i = 0; i < copyCount; i++)
+			strings.emplace_back(source, bigArena);
+		DoNotOptimize(strings.back());
+		strings.clear();
+		bigArena.Reset();
+	});
+	std::cout << "  The arena ended up with " << bigArena.BlockCount() << " blocks of 1 MB" << std::endl;
+}
@@ -0,0 +1,224 @@
+#pragma once
+
+#include <chrono>
+#include <cstdio>
+#include <cstdint>
+#include <iomanip>
+#include <iostream>
+#include <string>
+#include <type_traits>
+#include <vector>
+
+#if defined(_MSC_VER)
+#include <intrin.h>
+#endif
+
+// A small timer, started when it is created
+class Timer
+{
+private:
+	std::chrono::high_resolution_clock::time_point m_Start;
+public:
+	Timer() { Reset(); }
+
+	void Reset() { m_Start = std::chrono::high_resolution_clock::now(); }
+
+	double ElapsedSeconds() const
+	{
+		return std::chrono::duration<double>(std::chrono::high_resolution_clock::now() - m_Start).count();
+	}
+};
+
+// Stops the optimiser from deleting work whose result is never used
+// The compiler has to assume the empty asm block reads (and may change) the value, so it has to actually compute it
+// Small values can stay in a register, so calling this inside a loop costs next to nothing
+// A checksum handed to it usually keeps adding up over every run, so make it unsigned (or a float): a signed integer that overflows is undefined behaviour
+template<typename T>
+inline void DoNotOptimize(T& value)
+{
+#if defined(_MSC_VER)
+	static void* volatile s_Sink;
+	s_Sink = &value;
+	_ReadWriteBarrier();
+#else
+	if constexpr (std::is_trivially_copyable_v<T> && sizeof(T) <= sizeof(void*))
+		asm volatile("" : "+r"(value) : : "memory");
+	else
+		asm volatile("" : "+m"(value) : : "memory");
+#endif
+}
+
+template<typename T>
+inline void DoNotOptimize(const T& value)
+{
+#if defined(_MSC_VER)
+	static const void* volatile s_Sink;
+	s_Sink = &value;
+	_ReadWriteBarrier();
+#else
+	asm volatile("" : : "m"(value) : "memory");
+#endif
+}
+
+// Forces all pending writes to memory to happen before this point
+inline void ClobberMemory()
+{
+#if defined(_MSC_VER)
+	_ReadWriteBarrier();
+#else
+	asm volatile("" : : : "memory");
+#endif
+}
+
+// How many times operator new has been called since the programme started
+// Main.cpp replaces the global operator new and delete to count them, so this includes every new, std::vector and std::string allocation
+uint64_t AllocationCount();
+
+struct BenchmarkResult
+{
+	std::string Suite;
+	std::string Name;
+	double Seconds = 0.0;		// Of the fastest run
+	uint64_t Operations = 0;	// Per run
+	uint64_t Bytes = 0;			// Per run, 0 if the benchmark doesn't move memory
+	double Allocations = -1.0;	// Heap allocations per operation, or -1 when they weren't counted
+
+	bool CountedAllocations() const { return Allocations >= 0.0; }
+
+	double NanosecondsPerOperation() const { return Seconds * 1e9 / (double)Operations; }
+	double OperationsPerSecond() const { return (double)Operations / Seconds; }
+	double GigabytesPerSecond() const { return (double)Bytes / Seconds / 1e9; }
+};
+
+// Keeps every result so a suite can compare them once it is done
+class BenchmarkReport
+{
+private:
+	std::vector<BenchmarkResult> m_Results;
+	std::string m_Suite;
+public:
+	static BenchmarkReport& Get()
+	{
+		static BenchmarkReport s_Instance;
+		return s_Instance;
+	}
+
+	void BeginSuite(const std::string& name)
+	{
+		m_Suite = name;
+		std::cout << std::endl << "== " << name << " ==" << std::endl;
+	}
+
+	const BenchmarkResult& Add(BenchmarkResult result)
+	{
+		result.Suite = m_Suite;
+		m_Results.push_back(result);
+
+		// The allocations are shown after the name, but kept out of it, so a result keeps its name when they change
+		std::string label = result.Name;
+		if (result.CountedAllocations())
+		{
+			char count[32];
+			snprintf(count, sizeof(count), " (%.2f allocs)", result.Allocations);
+			label += count;
+		}
+		std::cout << "  " << std::left << std::setw(48) << label << std::right << std::fixed << std::setprecision(2)
+			<< std::setw(10) << result.NanosecondsPerOperation() << " ns/op"
+			<< std::setw(12) << result.OperationsPerSecond() / 1e6 << " Mops/s";
+		if (result.Bytes)
+			std::cout << std::setw(10) << result.GigabytesPerSecond() << " GB/s";
+		std::cout << std::endl;
+		return m_Results.back();
+	}
+
+	const std::vector<BenchmarkResult>& GetResults() const { return m_Results; }
+
+	// Every result so far, so runs can be kept and compared over time
+	// { "results": [ { "suite", "name", "seconds", "operations", "bytes", "nanosecondsPerOperation", "allocations" }, ... ] }
+	// allocations is per operation, and null for the benchmarks that didn't count them
+	void WriteJson(std::ostream& stream) const
+	{
+		auto writeString = [&](const std::string& string)
+		{
+			stream << '"';
+			for (char c : string)
+			{
+				if (c == '"' || c == '\\')
+					stream << '\\' << c;
+				else if ((unsigned char)c < 0x20)
+				{
+					char escaped[8];
+					snprintf(escaped, sizeof(escaped), "\\u%04x", (unsigned)c);
+					stream << escaped;
+				}
+				else
+					stream << c;
+			}
+			stream << '"';
+		};
+
+		stream << std::defaultfloat << std::setprecision(10) << "{\n  \"results\": [";
+		for (size_t i = 0; i < m_Results.size(); i++)
+		{
+			const BenchmarkResult& result = m_Results[i];
+			stream << (i == 0 ? "\n" : ",\n") << "    { \"suite\": ";
+			writeString(result.Suite);
+			stream << ", \"name\": ";
+			writeString(result.Name);
+			stream << ", \"seconds\": " << result.Seconds << ", \"operations\": " << result.Operations << ", \"bytes\": " << result.Bytes
+				<< ", \"nanosecondsPerOperation\": " << result.NanosecondsPerOperation() << ", \"allocations\": ";
+			if (result.CountedAllocations())
+				stream << result.Allocations;
+			else
+				stream << "null";
+			stream << " }";
+		}
+		stream << "\n  ]\n}\n";
+	}
+};
+
+// Runs func() a few times and keeps the fastest run, which is the one with the least noise from the rest of the system
+// operations is how many operations a single call of func() does, so we can report the cost of one operation
+// Only measures: the result still has to be added to the report
+template<typename F>
+BenchmarkResult MeasureBenchmark(const std::string& name, uint64_t operations, F&& func, uint64_t bytes = 0, int runs = 5)
+{
+	func();	// Warm up the caches and the branch predictor
+
+	double best = 1e300;
+	for (int i = 0; i < runs; i++)
+	{
+		Timer timer;
+		func();
+		ClobberMemory();
+		double seconds = timer.ElapsedSeconds();
+		if (seconds < best)
+			best = seconds;
+	}
+
+	BenchmarkResult result;
+	result.Name = name;
+	result.Seconds = best;
+	result.Operations = operations;
+	result.Bytes = bytes;
+	return result;
+}
+
+template<typename F>
+const BenchmarkResult& RunBenchmark(const std::string& name, uint64_t operations, F&& func, uint64_t bytes = 0, int runs = 5)
+{
+	return BenchmarkReport::Get().Add(MeasureBenchmark(name, operations, func, bytes, runs));
+}
+
+// The same, and counts the allocations of one extra run
+template<typename F>
+const BenchmarkResult& RunCountingBenchmark(const std::string& name, uint64_t operations, F&& func, uint64_t bytes = 0, int runs = 5)
+{
+	uint64_t before = AllocationCount();
+	func();
+	double allocations = (double)(AllocationCount() - before) / (double)operations;
+
+	BenchmarkResult result = MeasureBenchmark(name, operations, func, bytes, runs);
+	result.Allocations = allocations;
+	return BenchmarkReport::Get().Add(result);
+}
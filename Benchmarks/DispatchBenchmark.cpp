@@ -0,0 +1,192 @@
+#include <algorithm>
+#include <memory>
+#include <random>
+#include <vector>
+
+#include "Benchmark.h"
+#include "Dispatch.h"
+
+// Compares the cost of one GetClassName() call for each way of dispatching it
+// Homogeneous: every object is an InheritingClass, so an indirect call always goes to the same place and the branch predictor gets it right
+// Grouped: half PlainClass then half InheritingClass. The target changes once, so it is still predictable
+// Shuffled: the two types are mixed randomly. The difference between grouped and shuffled is roughly the cost of the mispredicted indirect calls
+// (we can't read the hardware misprediction counters portably, so that difference is what we report)
+
+static const size_t s_ObjectCount = 10000;	// Small enough to stay in cache, so we measure the call and not the memory
+static const int s_Passes = 100;
+// Every loop below calls DoNotOptimize(total) after each call. Otherwise the calls that can be inlined get folded into a constant and skipped altogether
+
+enum class Layout { Homogeneous, Grouped, Shuffled };
+
+static const char* LayoutName(Layout layout)
+{
+	switch (layout)
+	{
+	case Layout::Homogeneous: return "homogeneous";
+	case Layout::Grouped: return "grouped";
+	default: return "shuffled";
+	}
+}
+
+// true means InheritingClass, false means PlainClass
+static std::vector<bool> MakeTypeOrder(Layout layout)
+{
+	std::vector<bool> order(s_ObjectCount, true);
+	if (layout == Layout::Homogeneous)
+		return order;
+
+	for (size_t i = 0; i < s_ObjectCount / 2; i++)
+		order[i] = false;
+	if (layout == Layout::Shuffled)
+	{
+		std::vector<char> shuffled(order.begin(), order.end());
+		std::shuffle(shuffled.begin(), shuffled.end(), std::mt19937(1234));
+		order.assign(shuffled.begin(), shuffled.end());
+	}
+	return order;
+}
+
+template<typename F>
+static void Run(const std::string& name, Layout layout, F&& func)
+{
+	RunBenchmark(name + " (" + LayoutName(layout) + ")", s_ObjectCount * s_Passes, [&]()
+	{
+		size_t total = 0;
+		for (int pass = 0; pass < s_Passes; pass++)
+		{
+			total += func();
+			DoNotOptimize(total);
+		}
+		DoNotOptimize(total);
+	});
+}
+
+static void BenchmarkVirtual(Layout layout)
+{
+	std::vector<std::unique_ptr<Printable>> storage;
+	std::vector<Printable*> objects;
+	for (bool inheriting : MakeTypeOrder(layout))
+	{
+		if (inheriting)
+			storage.push_back(std::make_unique<InheritingClass>("Cherno"));
+		else
+			storage.push_back(std::make_unique<PlainClass>());
+		objects.push_back(storage.back().get());
+	}
+
+	Run("virtual Printable*", layout, [&]()
+	{
+		size_t total = 0;
+		for (Printable* obj : objects)
+		{
+			total += obj->GetClassName().size();
+			DoNotOptimize(total);
+		}
+		return total;
+	});
+}
+
+static void BenchmarkVariant(Layout layout)
+{
+	std::vector<PrintableVariant> objects;
+	for (bool inheriting : MakeTypeOrder(layout))
+	{
+		if (inheriting)
+			objects.emplace_back(InheritingClass("Cherno"));
+		else
+			objects.emplace_back(PlainClass());
+	}
+
+	Run("std::variant + std::visit", layout, [&]()
+	{
+		size_t total = 0;
+		for (PrintableVariant& obj : objects)
+		{
+			total += GetClassName(obj).size();
+			DoNotOptimize(total);
+		}
+		return total;
+	});
+}
+
+static void BenchmarkFunctionTable(Layout layout)
+{
+	std::vector<PlainClass> plains(s_ObjectCount);
+	std::vector<InheritingClass> inheritings(s_ObjectCount, InheritingClass("Cherno"));
+	std::vector<PrintableRef> objects;
+	size_t index = 0;
+	for (bool inheriting : MakeTypeOrder(layout))
+	{
+		if (inheriting)
+			objects.emplace_back(inheritings[index++]);
+		else
+			objects.emplace_back(plains[index++]);
+	}
+
+	Run("function pointer table", layout, [&]()
+	{
+		size_t total = 0;
+		for (const PrintableRef& obj : objects)
+		{
+			total += obj.GetClassName().size();
+			DoNotOptimize(total);
+		}
+		return total;
+	});
+}
+
+// CRTP can't mix types in one container, so the heterogeneous versions run one loop per type
+static void BenchmarkStatic(Layout layout)
+{
+	std::vector<bool> order = MakeTypeOrder(layout);
+	size_t inheritingCount = std::count(order.begin(), order.end(), true);
+	std::vector<StaticPlainClass> plains(s_ObjectCount - inheritingCount);
+	std::vector<StaticInheritingClass> inheritings(inheritingCount, StaticInheritingClass("Cherno"));
+
+	Run("CRTP (one loop per type)", layout, [&]()
+	{
+		size_t total = 0;
+		for (StaticPlainClass& obj : plains)
+		{
+			total += PrintThingStatic(obj).size();
+			DoNotOptimize(total);
+		}
+		for (StaticInheritingClass& obj : inheritings)
+		{
+			total += PrintThingStatic(obj).size();
+			DoNotOptimize(total);
+		}
+		return total;
+	});
+}
+
+// The best case: a non-virtual call the compiler can inline
+static void BenchmarkDirect()
+{
+	std::vector<InheritingClass> objects(s_ObjectCount, InheritingClass("Cherno"));
+
+	Run("direct call (inlined)", Layout::Homogeneous, [&]()
+	{
+		size_t total = 0;
+		for (InheritingClass& obj : objects)
+		{
+			total += obj.InheritingClass::GetClassName().size();
+			DoNotOptimize(total);
+		}
+		return total;
+	});
+}
+
+void RunDispatchBenchmarks()
+{
+	BenchmarkReport::Get().BeginSuite("Dispatch: GetClassName() per call");
+
+	BenchmarkDirect();
+	for (Layout layout : { Layout::Homogeneous, Layout::Grouped, Layout::Shuffled })
+	{
+		BenchmarkVirtual(layout);
+		BenchmarkVariant(layout);
+		BenchmarkFunctionTable(layout);
+		BenchmarkStatic(layout);
+	}
+}
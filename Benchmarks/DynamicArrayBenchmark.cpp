@@ -0,0 +1,115 @@
+#include <ratio>
+#include <string>
+#include <vector>
+
+#include "Benchmark.h"
+#include "DynamicArray.h"
+#include "Vertex.h"
+
+// DynamicArray against std::vector, filling arrays of Vertex
+// Push and emplace: 3 vertices (like main) into 1M new arrays, 1K into 1K arrays, and 16M (192 MB) into one array, with and without a Reserve first
+// Without reserve std::vector copies every vertex again each time it grows. DynamicArray reallocs, or moves the pages with mremap once it is 1 MB or more,
+// and with 3 inline vertices the small arrays never touch the heap at all
+// Bulk fill: making room for 16M vertices and then writing them. std::vector::resize() has to construct them all first, ResizeUninitialized() doesn't
+//
+// DynamicArray gets its memory from malloc and mmap, not operator new, so there is no allocation count here
+
+template<typename Array, typename Fill>
+static void RunFill(const std::string& name, size_t arrays, size_t count, Fill&& fill)
+{
+	float sum = 0.0f;
+	RunBenchmark(name, arrays * count, [&]()
+	{
+		for (size_t i = 0; i < arrays; i++)
+		{
+			Array vertices;
+			fill(vertices, count);
+			sum += vertices[count - 1].x;
+			DoNotOptimize(vertices);
+		}
+		DoNotOptimize(sum);
+	}, arrays * count * sizeof(Vertex), count > (1 << 20) ? 3 : 5);
+}
+
+static void RunCount(size_t arrays, size_t count)
+{
+	BenchmarkReport::Get().BeginSuite("DynamicArray: " + std::to_string(arrays) + " arrays of " + std::to_string(count) + " vertices");
+
+	RunFill<std::vector<Vertex>>("std::vector, push_back", arrays, count, [](std::vector<Vertex>& vertices, size_t count)
+	{
+		for (size_t i = 0; i < count; i++)
+			vertices.push_back(Vertex((float)i, 2.0f, 3.0f));
+	});
+	RunFill<std::vector<Vertex>>("std::vector, emplace_back", arrays, count, [](std::vector<Vertex>& vertices, size_t count)
+	{
+		for (size_t i = 0; i < count; i++)
+			vertices.emplace_back((float)i, 2.0f, 3.0f);
+	});
+	RunFill<std::vector<Vertex>>("std::vector, reserve and emplace_back", arrays, count, [](std::vector<Vertex>& vertices, size_t count)
+	{
+		vertices.reserve(count);
+		for (size_t i = 0; i < count; i++)
+			vertices.emplace_back((float)i, 2.0f, 3.0f);
+	});
+
+	RunFill<DynamicArray<Vertex>>("DynamicArray, PushBack", arrays, count, [](DynamicArray<Vertex>& vertices, size_t count)
+	{
+		for (size_t i = 0; i < count; i++)
+			vertices.PushBack(Vertex((float)i, 2.0f, 3.0f));
+	});
+	RunFill<DynamicArray<Vertex>>("DynamicArray, EmplaceBack", arrays, count, [](DynamicArray<Vertex>& vertices, size_t count)
+	{
+		for (size_t i = 0; i < count; i++)
+			vertices.EmplaceBack((float)i, 2.0f, 3.0f);
+	});
+	RunFill<DynamicArray<Vertex, 0, std::ratio<2>>>("DynamicArray, EmplaceBack, growing 2x", arrays, count, [](DynamicArray<Vertex, 0, std::ratio<2>>& vertices, size_t count)
+	{
+		for (size_t i = 0; i < count; i++)
+			vertices.EmplaceBack((float)i, 2.0f, 3.0f);
+	});
+	RunFill<DynamicArray<Vertex>>("DynamicArray, Reserve and EmplaceBack", arrays, count, [](DynamicArray<Vertex>& vertices, size_t count)
+	{
+		vertices.Reserve(count);
+		for (size_t i = 0; i < count; i++)
+			vertices.EmplaceBack((float)i, 2.0f, 3.0f);
+	});
+	RunFill<DynamicArray<Vertex, 3>>("DynamicArray, 3 inline, EmplaceBack", arrays, count, [](DynamicArray<Vertex, 3>& vertices, size_t count)
+	{
+		for (size_t i = 0; i < count; i++)
+			vertices.EmplaceBack((float)i, 2.0f, 3.0f);
+	});
+}
+
+static void RunBulkFill(size_t count)
+{
+	BenchmarkReport::Get().BeginSuite("DynamicArray: bulk fill of " + std::to_string(count) + " vertices");
+
+	RunFill<std::vector<Vertex>>("std::vector, resize and write", 1, count, [](std::vector<Vertex>& vertices, size_t count)
+	{
+		vertices.resize(count);
+		for (size_t i = 0; i < count; i++)
+			vertices[i] = Vertex((float)i, 2.0f, 3.0f);
+	});
+	RunFill<DynamicArray<Vertex>>("DynamicArray, Resize and write", 1, count, [](DynamicArray<Vertex>& vertices, size_t count)
+	{
+		vertices.Resize(count);
+		for (size_t i = 0; i < count; i++)
+			vertices[i] = Vertex((float)i, 2.0f, 3.0f);
+	});
+	RunFill<DynamicArray<Vertex>>("DynamicArray, ResizeUninitialized and write", 1, count, [](DynamicArray<Vertex>& vertices, size_t count)
+	{
+		vertices.ResizeUninitialized(count);
+		for (size_t i = 0; i < count; i++)
+			vertices[i] = Vertex((float)i, 2.0f, 3.0f);
+	});
+}
+
+void RunDynamicArrayBenchmarks()
+{
+	RunCount(1 << 20, 3);
+	RunCount(1 << 10, 1 << 10);
+	RunCount(1, 1 << 24);
+	RunBulkFill(1 << 24);
+	std::cout << "  sizeof(std::vector<Vertex>) = " << sizeof(std::vector<Vertex>) << ", sizeof(DynamicArray<Vertex>) = " << sizeof(DynamicArray<Vertex>)
+		<< ", sizeof(DynamicArray<Vertex, 3>) = " << sizeof(DynamicArray<Vertex, 3>) << std::endl;
+}
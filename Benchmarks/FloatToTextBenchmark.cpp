@@ -0,0 +1,141 @@
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+#include <iomanip>
+#include <sstream>
+#include <vector>
+
+#include "Benchmark.h"
+#include "FloatToText.h"
+
+// Writing 1 million Vector2s and Vertices as text, one per line
+// iostream: the operator<< from Vector.h and Vertex.h into a std::ostringstream
+// snprintf: "%.9g", which always reads back as the same float but isn't the shortest text
+// WriteVector2s / WriteVertices: Ryu into one preallocated buffer
+// MB/s is of the text that was written
+
+static const size_t s_Count = 1000000;
+
+// Positions like a game would have: some whole numbers, some fractions, a few very small and very big ones
+static float MakeFloat(uint32_t& state)
+{
+	state = state * 1664525u + 1013904223u;
+	uint32_t kind = state >> 28;
+	float value = (float)((state >> 8) & 0xfffff) / 64.0f - 8192.0f;
+	if (kind == 0)
+		return (float)(int)value;
+	if (kind == 1)
+		return value * 1e-7f;
+	if (kind == 2)
+		return value * 1e12f;
+	return value;
+}
+
+// Everything WriteFloat writes has to read back as the same float
+static void CheckRoundTrip(const std::vector<Vertex>& vertices)
+{
+	char buffer[MaxFloatTextSize + 1];
+	for (const Vertex& vertex : vertices)
+	{
+		for (float value : { vertex.x, vertex.y, vertex.z })
+		{
+			*WriteFloat(buffer, value) = 0;
+			if (strtof(buffer, nullptr) != value)
+			{
+				std::cout << "  " << buffer << " doesn't read back as the same float!" << std::endl;
+				return;
+			}
+		}
+	}
+}
+
+void RunFloatToTextBenchmarks()
+{
+	BenchmarkReport::Get().BeginSuite("Float to text: 1M Vector2s and Vertices, one per line");
+
+	std::vector<Vector2> vectors(s_Count);
+	std::vector<Vertex> vertices(s_Count);
+	uint32_t state = 1;
+	for (size_t i = 0; i < s_Count; i++)
+	{
+		vectors[i] = Vector2(MakeFloat(state), MakeFloat(state));
+		vertices[i] = Vertex(MakeFloat(state), MakeFloat(state), MakeFloat(state));
+	}
+	CheckRoundTrip(vertices);
+
+	std::vector<char> buffer(s_Count * (MaxVertexTextSize + 1));
+	size_t written = 0;
+
+	// Every version runs once first to find out how much text it writes
+	auto measure = [&](const char* name, auto&& write)
+	{
+		written = 0;
+		write();
+		RunBenchmark(name, s_Count, write, written, 3);
+	};
+
+	measure("Vector2 iostream operator<<", [&]()
+	{
+		std::ostringstream stream;
+		for (const Vector2& vector : vectors)
+			stream << vector << '\n';
+		written = stream.str().size();
+	});
+
+	measure("Vector2 iostream, fixed 3 decimals", [&]()
+	{
+		std::ostringstream stream;
+		stream << std::fixed << std::setprecision(3);
+		for (const Vector2& vector : vectors)
+			stream << vector << '\n';
+		written = stream.str().size();
+	});
+
+	measure("Vector2 snprintf %.9g", [&]()
+	{
+		char* position = buffer.data();
+		for (const Vector2& vector : vectors)
+			position += snprintf(position, MaxVector2TextSize + 1, "(%.9g | %.9g)\n", vector.x, vector.y);
+		written = position - buffer.data();
+	});
+
+	measure("WriteVector2s shortest", [&]()
+	{
+		written = WriteVector2s(vectors, buffer.data());
+		DoNotOptimize(buffer[0]);
+	});
+
+	measure("WriteVector2s fixed 3 decimals", [&]()
+	{
+		written = WriteVector2s(vectors, buffer.data(), 3);
+		DoNotOptimize(buffer[0]);
+	});
+
+	measure("Vertex iostream operator<<", [&]()
+	{
+		std::ostringstream stream;
+		for (const Vertex& vertex : vertices)
+			stream << vertex << '\n';
+		written = stream.str().size();
+	});
+
+	measure("Vertex snprintf %.9g", [&]()
+	{
+		char* position = buffer.data();
+		for (const Vertex& vertex : vertices)
+			position += snprintf(position, MaxVertexTextSize + 1, "(%.9g | %.9g | %.9g)\n", vertex.x, vertex.y, vertex.z);
+		written = position - buffer.data();
+	});
+
+	measure("WriteVertices shortest", [&]()
+	{
+		written = WriteVertices(vertices, buffer.data());
+		DoNotOptimize(buffer[0]);
+	});
+
+	measure("WriteVertices fixed 3 decimals", [&]()
+	{
+		written = WriteVertices(vertices, buffer.data(), 3);
+		DoNotOptimize(buffer[0]);
+	});
+}
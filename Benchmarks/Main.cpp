@@ -0,0 +1,149 @@
+// Benchmarks for the things in the course project
+// Build this in Release, debug builds don't tell you anything about performance
+// Run it with no arguments to run every suite, or pass the names of the suites you want: Benchmarks.exe dispatch
+// --json results.json also writes every result to a file, to keep track of them over time: Benchmarks.exe ownership --json ownership.json
+
+#include <atomic>
+#include <cstdlib>
+#include <cstring>
+#include <fstream>
+#include <iostream>
+#include <new>
+#include <vector>
+
+#include "Benchmark.h"
+
+void RunDispatchBenchmarks();
+void RunTypeNameBenchmarks();
+void RunPolyCollectionBenchmarks();
+void RunVectorBenchmarks();
+void RunVectorExpressionBenchmarks();
+void RunVector2KernelsBenchmarks();
+void RunFloatToTextBenchmarks();
+void RunTransformBenchmarks();
+void RunParticleBenchmarks();
+void RunVerletBenchmarks();
+void RunStringBenchmarks();
+void RunSharedStringBenchmarks();
+void RunStringBuilderBenchmarks();
+void RunStringSearchBenchmarks();
+void RunArenaBenchmarks();
+void RunUtfBenchmarks();
+void RunScopedPtrBenchmarks();
+void RunRefCountedBenchmarks();
+void RunOwnershipBenchmarks();
+void RunDynamicArrayBenchmarks();
+void RunSlotMapBenchmarks();
+void RunMeshLoaderBenchmarks();
+void RunMeshIndexingBenchmarks();
+
+// Every allocation in the programme goes through these, so benchmarks can count them with AllocationCount()
+// new[] and delete[] call these too. The count is relaxed, it only has to be right once the threads are done
+static std::atomic<uint64_t> s_AllocationCount{ 0 };
+
+uint64_t AllocationCount()
+{
+	return s_AllocationCount.load(std::memory_order_relaxed);
+}
+
+void* operator new(size_t size)
+{
+	s_AllocationCount.fetch_add(1, std::memory_order_relaxed);
+	if (void* memory = malloc(size > 0 ? size : 1))
+		return memory;
+	throw std::bad_alloc();
+}
+
+void operator delete(void* memory) noexcept
+{
+	free(memory);
+}
+
+void operator delete(void* memory, size_t) noexcept
+{
+	free(memory);
+}
+
+struct BenchmarkSuite
+{
+	const char* Name;
+	void (*Run)();
+};
+
+static const BenchmarkSuite s_Suites[] =
+{
+	{ "dispatch", RunDispatchBenchmarks },
+	{ "typename", RunTypeNameBenchmarks },
+	{ "polycollection", RunPolyCollectionBenchmarks },
+	{ "vector", RunVectorBenchmarks },
+	{ "expression", RunVectorExpressionBenchmarks },
+	{ "kernels", RunVector2KernelsBenchmarks },
+	{ "floattext", RunFloatToTextBenchmarks },
+	{ "transform", RunTransformBenchmarks },
+	{ "particles", RunParticleBenchmarks },
+	{ "verlet", RunVerletBenchmarks },
+	{ "string", RunStringBenchmarks },
+	{ "sharedstring", RunSharedStringBenchmarks },
+	{ "builder", RunStringBuilderBenchmarks },
+	{ "search", RunStringSearchBenchmarks },
+	{ "arena", RunArenaBenchmarks },
+	{ "utf", RunUtfBenchmarks },
+	{ "scopedptr", RunScopedPtrBenchmarks },
+	{ "refcount", RunRefCountedBenchmarks },
+	{ "ownership", RunOwnershipBenchmarks },
+	{ "dynamicarray", RunDynamicArrayBenchmarks },
+	{ "slotmap", RunSlotMapBenchmarks },
+	{ "meshload", RunMeshLoaderBenchmarks },
+	{ "meshindexing", RunMeshIndexingBenchmarks },
+};
+
+int main(int argc, char** argv)
+{
+	const char* jsonPath = nullptr;
+	std::vector<const char*> names;
+	for (int i = 1; i < argc; i++)
+	{
+		if (strcmp(argv[i], "--json") == 0 && i + 1 < argc)
+			jsonPath = argv[++i];
+		else
+			names.push_back(argv[i]);
+	}
+
+	bool ranAny = false;
+	for (const BenchmarkSuite& suite : s_Suites)
+	{
+		bool selected = names.empty();
+		for (const char* name : names)
+		{
+			if (strcmp(name, suite.Name) == 0)
+				selected = true;
+		}
+
+		if (selected)
+		{
+			suite.Run();
+			ranAny = true;
+		}
+	}
+
+	if (!ranAny)
+	{
+		std::cout << "Unknown suite. Available suites:" << std::endl;
+		for (const BenchmarkSuite& suite : s_Suites)
+			std::cout << "  " << suite.Name << std::endl;
+		return 1;
+	}
+
+	if (jsonPath)
+	{
+		std::ofstream file(jsonPath);
+		BenchmarkReport::Get().WriteJson(file);
+		if (!file)
+		{
+			std::cout << "Couldn't write " << jsonPath << std::endl;
+			return 1;
+		}
+		std::cout << std::endl << "Wrote " << BenchmarkReport::Get().GetResults().size() << " results to " << jsonPath << std::endl;
+	}
+	return 0;
+}
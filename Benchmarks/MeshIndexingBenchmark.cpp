@@ -0,0 +1,166 @@
+#include <algorithm>
+#include <array>
+#include <cmath>
+#include <cstdio>
+#include <random>
+#include <string>
+#include <unordered_map>
+#include <vector>
+
+#include "Benchmark.h"
+#include "DynamicArray.h"
+#include "MeshIndexing.h"
+#include "Vertex.h"
+
+// Welding and vertex cache optimisation on a few sample meshes, all stored as a triangle list with 3 vertices per triangle to start with
+// Terrain: a 512 x 512 grid of squares, with the triangles in rows like it is usually generated
+// Sphere: 256 rings of 512 segments, and a small one of 64 x 128 (whose vertices fit in 16 bit indices)
+// Shuffled terrain: the same grid with its triangles in a random order, like a mesh that went through a tool that doesn't care
+//
+// Timed: WeldVertices against the same thing done with std::unordered_map, and OptimizeVertexCache
+// Then for every mesh: how much memory the indexed mesh needs compared to the triangle list, and the ACMR (vertices shaded per triangle, with a 16 vertex cache)
+// before and after OptimizeVertexCache. ATVR is the same thing per vertex instead of per triangle: 1 means every vertex is shaded exactly once
+
+struct SampleMesh
+{
+	std::string Name;
+	std::vector<Vertex> Triangles;
+};
+
+static void AddQuad(std::vector<Vertex>& triangles, const Vertex& a, const Vertex& b, const Vertex& c, const Vertex& d)
+{
+	triangles.insert(triangles.end(), { a, b, c, c, b, d });
+}
+
+static SampleMesh MakeTerrain(int size)
+{
+	SampleMesh mesh{ "Terrain " + std::to_string(size) + " x " + std::to_string(size), {} };
+	auto height = [](int x, int y) { return sinf((float)x * 0.05f) * cosf((float)y * 0.07f) * 10.0f; };
+	for (int y = 0; y < size; y++)
+	{
+		for (int x = 0; x < size; x++)
+		{
+			AddQuad(mesh.Triangles, Vertex((float)x, height(x, y), (float)y), Vertex((float)x + 1, height(x + 1, y), (float)y),
+				Vertex((float)x, height(x, y + 1), (float)y + 1), Vertex((float)x + 1, height(x + 1, y + 1), (float)y + 1));
+		}
+	}
+	return mesh;
+}
+
+// Every corner is worked out from its ring and segment with the same code, so shared corners come out as exactly the same floats and weld together
+static SampleMesh MakeSphere(int rings, int segments)
+{
+	SampleMesh mesh{ "Sphere " + std::to_string(rings) + " x " + std::to_string(segments), {} };
+	const float pi = 3.14159265f;
+	auto corner = [&](int ring, int segment)
+	{
+		if (ring == 0 || ring == rings)
+			return Vertex(0.0f, ring == 0 ? 1.0f : -1.0f, 0.0f);	// All of the segments meet at the poles
+		float theta = pi * (float)ring / (float)rings;
+		float phi = 2.0f * pi * (float)(segment % segments) / (float)segments;
+		return Vertex(sinf(theta) * cosf(phi), cosf(theta), sinf(theta) * sinf(phi));
+	};
+	for (int ring = 0; ring < rings; ring++)
+	{
+		for (int segment = 0; segment < segments; segment++)
+			AddQuad(mesh.Triangles, corner(ring, segment), corner(ring, segment + 1), corner(ring + 1, segment), corner(ring + 1, segment + 1));
+	}
+	return mesh;
+}
+
+static SampleMesh Shuffle(SampleMesh mesh)
+{
+	mesh.Name = "Shuffled " + mesh.Name;
+	std::vector<std::array<Vertex, 3>> triangles;
+	for (size_t i = 0; i < mesh.Triangles.size(); i += 3)
+		triangles.push_back({ mesh.Triangles[i], mesh.Triangles[i + 1], mesh.Triangles[i + 2] });
+	std::shuffle(triangles.begin(), triangles.end(), std::mt19937(3));
+	mesh.Triangles.clear();
+	for (const std::array<Vertex, 3>& triangle : triangles)
+		mesh.Triangles.insert(mesh.Triangles.end(), triangle.begin(), triangle.end());
+	return mesh;
+}
+
+struct VertexHash
+{
+	size_t operator()(const Vertex& vertex) const
+	{
+		return std::hash<float>()(vertex.x) ^ (std::hash<float>()(vertex.y) * 31) ^ (std::hash<float>()(vertex.z) * 961);
+	}
+};
+
+struct VertexEqual
+{
+	bool operator()(const Vertex& a, const Vertex& b) const { return a.x == b.x && a.y == b.y && a.z == b.z; }
+};
+
+static void WeldWithUnorderedMap(const std::vector<Vertex>& vertices, std::vector<Vertex>& unique, std::vector<uint32_t>& indices)
+{
+	std::unordered_map<Vertex, uint32_t, VertexHash, VertexEqual> map;
+	unique.clear();
+	indices.clear();
+	for (const Vertex& vertex : vertices)
+	{
+		auto inserted = map.emplace(vertex, (uint32_t)unique.size());
+		if (inserted.second)
+			unique.push_back(vertex);
+		indices.push_back(inserted.first->second);
+	}
+}
+
+static void RunTimings(const SampleMesh& mesh)
+{
+	BenchmarkReport::Get().BeginSuite("Mesh indexing: " + mesh.Name + ", " + std::to_string(mesh.Triangles.size()) + " vertices in");
+	size_t count = mesh.Triangles.size();
+
+	DynamicArray<Vertex> unique;
+	DynamicArray<uint32_t> indices;
+	RunCountingBenchmark("WeldVertices", count, [&]() { WeldVertices(mesh.Triangles, unique, indices); });
+
+	std::vector<Vertex> mapUnique;
+	std::vector<uint32_t> mapIndices;
+	RunCountingBenchmark("std::unordered_map", count, [&]() { WeldWithUnorderedMap(mesh.Triangles, mapUnique, mapIndices); }, 0, 3);
+
+	DynamicArray<uint32_t> optimised;
+	RunBenchmark("OptimizeVertexCache (per triangle)", count / 3, [&]()
+	{
+		optimised = indices;
+		OptimizeVertexCache(optimised, unique.Size());
+	}, 0, 3);
+}
+
+static void PrintResults(const SampleMesh& mesh)
+{
+	DynamicArray<Vertex> unique;
+	DynamicArray<uint32_t> indices;
+	WeldVertices(mesh.Triangles, unique, indices);
+	size_t triangles = indices.Size() / 3;
+
+	float before = AverageCacheMissRatio(indices, unique.Size());
+	OptimizeVertexCache(indices, unique.Size());
+	float after = AverageCacheMissRatio(indices, unique.Size());
+	IndexBuffer buffer(indices, unique.Size());
+
+	size_t listBytes = mesh.Triangles.size() * sizeof(Vertex);
+	size_t indexedBytes = unique.Size() * sizeof(Vertex) + buffer.SizeInBytes();
+	printf("  %-28s %9zu -> %8zu vertices, %2d bit indices, %7.2f MB -> %6.2f MB (%.0f%% less), ACMR %.3f -> %.3f, ATVR %.3f -> %.3f\n",
+		mesh.Name.c_str(), mesh.Triangles.size(), unique.Size(), buffer.Is16Bit() ? 16 : 32, (double)listBytes / (1 << 20), (double)indexedBytes / (1 << 20),
+		100.0 - 100.0 * (double)indexedBytes / (double)listBytes, before, after,
+		before * (float)triangles / (float)unique.Size(), after * (float)triangles / (float)unique.Size());
+}
+
+void RunMeshIndexingBenchmarks()
+{
+	std::vector<SampleMesh> meshes;
+	meshes.push_back(MakeTerrain(512));
+	meshes.push_back(Shuffle(MakeTerrain(512)));
+	meshes.push_back(MakeSphere(256, 512));
+	meshes.push_back(MakeSphere(64, 128));
+
+	for (const SampleMesh& mesh : meshes)
+		RunTimings(mesh);
+
+	BenchmarkReport::Get().BeginSuite("Mesh indexing: memory and ACMR, triangle list -> welded and optimised");
+	for (const SampleMesh& mesh : meshes)
+		PrintResults(mesh);
+}
@@ -0,0 +1,166 @@
+#include <cstdio>
+#include <filesystem>
+#include <fstream>
+#include <random>
+#include <sstream>
+#include <string>
+#include <vector>
+
+#include "Benchmark.h"
+#include "DynamicArray.h"
+#include "FloatToText.h"
+#include "JobSystem.h"
+#include "MeshLoader.h"
+#include "Vertex.h"
+
+// Loading the positions of a 4M vertex mesh, from an OBJ file (with a normal, a texture coordinate and a face for every vertex, like a real one has)
+// and from a binary PLY file, both written to the temp folder first
+// LoadObj and LoadPly against the way it is usually done: an ifstream read line by line, with >> for the numbers and push_back for every vertex
+// The file is in the OS's cache after the first run, so this measures parsing, not the disk. The GB/s column is the size of the file over the time to load it
+
+static const size_t s_VertexCount = 1 << 22;
+
+static std::vector<Vertex> MakeVertices()
+{
+	std::mt19937 random(11);
+	std::uniform_real_distribution<float> distribution(-100.0f, 100.0f);
+	std::vector<Vertex> vertices;
+	vertices.reserve(s_VertexCount);
+	for (size_t i = 0; i < s_VertexCount; i++)
+		vertices.emplace_back(distribution(random), distribution(random), distribution(random));
+	return vertices;
+}
+
+static void WriteObj(const std::string& path, const std::vector<Vertex>& vertices)
+{
+	std::ofstream file(path, std::ios::binary);
+	std::string text;
+	char buffer[3 * MaxFloatTextSize + 8];
+	for (size_t i = 0; i < vertices.size(); i++)
+	{
+		const Vertex& vertex = vertices[i];
+		char* p = buffer;
+		*p++ = 'v';
+		*p++ = ' ';
+		p = WriteFloat(p, vertex.x, 6);
+		*p++ = ' ';
+		p = WriteFloat(p, vertex.y, 6);
+		*p++ = ' ';
+		p = WriteFloat(p, vertex.z, 6);
+		*p++ = '\n';
+		text.append(buffer, p - buffer);
+		text += "vn 0 1 0\nvt 0.5 0.5\n";
+		if (i >= 2)
+			text += "f " + std::to_string(i - 1) + " " + std::to_string(i) + " " + std::to_string(i + 1) + "\n";
+
+		if (text.size() > (1 << 20))
+		{
+			file.write(text.data(), text.size());
+			text.clear();
+		}
+	}
+	file.write(text.data(), text.size());
+}
+
+static void WritePly(const std::string& path, const std::vector<Vertex>& vertices)
+{
+	std::ofstream file(path, std::ios::binary);
+	file << "ply\nformat binary_little_endian 1.0\nelement vertex " << vertices.size() << "\nproperty float x\nproperty float y\nproperty float z\nend_header\n";
+	file.write(reinterpret_cast<const char*>(vertices.data()), vertices.size() * sizeof(Vertex));
+}
+
+static bool NaiveLoadObj(const std::string& path, std::vector<Vertex>& vertices)
+{
+	vertices.clear();
+	std::ifstream file(path);
+	if (!file)
+		return false;
+	std::string line;
+	while (std::getline(file, line))
+	{
+		if (line.size() > 2 && line[0] == 'v' && line[1] == ' ')
+		{
+			std::istringstream stream(line.substr(2));
+			Vertex vertex;
+			stream >> vertex.x >> vertex.y >> vertex.z;
+			vertices.push_back(vertex);
+		}
+	}
+	return true;
+}
+
+static bool NaiveLoadPly(const std::string& path, std::vector<Vertex>& vertices)
+{
+	vertices.clear();
+	std::ifstream file(path, std::ios::binary);
+	if (!file)
+		return false;
+	std::string line;
+	size_t count = 0;
+	while (std::getline(file, line) && line != "end_header")
+	{
+		if (line.compare(0, 15, "element vertex ") == 0)
+			count = std::stoull(line.substr(15));
+	}
+	for (size_t i = 0; i < count; i++)
+	{
+		Vertex vertex;
+		file.read(reinterpret_cast<char*>(&vertex), sizeof(Vertex));
+		vertices.push_back(vertex);
+	}
+	return (bool)file;
+}
+
+static bool Matches(const DynamicArray<Vertex>& loaded, const std::vector<Vertex>& expected)
+{
+	if (loaded.Size() != expected.size())
+		return false;
+	for (size_t i = 0; i < expected.size(); i++)
+	{
+		if (loaded[i].x != expected[i].x || loaded[i].y != expected[i].y || loaded[i].z != expected[i].z)
+			return false;
+	}
+	return true;
+}
+
+static void PrintSpeedUp(const char* format, uint64_t bytes, const BenchmarkResult& naive, const BenchmarkResult& fast)
+{
+	double naiveSpeed = (double)bytes / naive.Seconds / 1e6;
+	double fastSpeed = (double)bytes / fast.Seconds / 1e6;
+	printf("  %s: %.0f MB/s, against %.0f MB/s with ifstream (%.1fx)\n", format, fastSpeed, naiveSpeed, fastSpeed / naiveSpeed);
+}
+
+void RunMeshLoaderBenchmarks()
+{
+	std::string folder = std::filesystem::temp_directory_path().string();
+	std::string objPath = folder + "/MeshLoaderBenchmark.obj";
+	std::string plyPath = folder + "/MeshLoaderBenchmark.ply";
+	{
+		std::vector<Vertex> vertices = MakeVertices();
+		WriteObj(objPath, vertices);
+		WritePly(plyPath, vertices);
+	}
+	uint64_t objBytes = std::filesystem::file_size(objPath);
+	uint64_t plyBytes = std::filesystem::file_size(plyPath);
+
+	std::vector<Vertex> naive;
+	DynamicArray<Vertex> fast;
+
+	BenchmarkReport::Get().BeginSuite("Mesh loading: OBJ, " + std::to_string(s_VertexCount) + " vertices, " + std::to_string(objBytes >> 20) + " MB, "
+		+ std::to_string(JobSystem::Get().ThreadCount()) + " threads");
+	BenchmarkResult naiveObj = RunBenchmark("ifstream, getline and >>", s_VertexCount, [&]() { NaiveLoadObj(objPath, naive); }, objBytes, 3);
+	BenchmarkResult fastObj = RunBenchmark("LoadObj", s_VertexCount, [&]() { LoadObj(objPath.c_str(), fast); }, objBytes, 3);
+	if (!Matches(fast, naive))
+		std::cout << "  LoadObj's vertices are not the same as ifstream's!" << std::endl;
+	PrintSpeedUp("OBJ", objBytes, naiveObj, fastObj);
+
+	BenchmarkReport::Get().BeginSuite("Mesh loading: binary PLY, " + std::to_string(s_VertexCount) + " vertices, " + std::to_string(plyBytes >> 20) + " MB");
+	BenchmarkResult naivePly = RunBenchmark("ifstream, read every vertex", s_VertexCount, [&]() { NaiveLoadPly(plyPath, naive); }, plyBytes, 3);
+	BenchmarkResult fastPly = RunBenchmark("LoadPly", s_VertexCount, [&]() { LoadPly(plyPath.c_str(), fast); }, plyBytes, 3);
+	if (!Matches(fast, naive))
+		std::cout << "  LoadPly's vertices are not the same as ifstream's!" << std::endl;
+	PrintSpeedUp("PLY", plyBytes, naivePly, fastPly);
+
+	std::remove(objPath.c_str());
+	std::remove(plyPath.c_str());
+}
@@ -0,0 +1,263 @@
+#include <algorithm>
+#include <cstdio>
+#include <memory>
+#include <string>
+#include <thread>
+#include <type_traits>
+#include <utility>
+#include <vector>
+
+#include "Benchmark.h"
+#include "RefCounted.h"
+#include "ScopedPtr.h"
+
+// Every way the course owns a heap object, side by side: raw new and delete, ScopedPtr, std::unique_ptr, std::shared_ptr (with and without make_shared),
+// and Ref to a RefCounted and to a LocalRefCounted. Objects stored by value in the vector, with no pointer at all, are the baseline
+// For objects of 32, 64 and 256 bytes, and 1K and 128K of them (the first fits in the caches, the second doesn't for the bigger objects)
+// The reference count of a RefCounted object is part of those bytes, so every style allocates objects of the same size
+//
+// Make: allocating and constructing every object into a vector that already has room for the owners. The heap allocations per object are shown after the name
+// Destroy: destroying them all again
+// Copy: copying the vector of owners. Only the shared ones (and values) can be copied, which for them is adding a reference to every object
+// Move: moving every owner into a second vector, one at a time
+// Walk: reading every object through its owner, after the owners have been shuffled. A pointer has to be followed to somewhere else in memory for each one,
+// which is what costs once they don't fit in the caches. Values sit next to each other and are read in order
+// Run with --json to keep the numbers
+
+template<size_t Size, typename Base>
+struct Payload : Base
+{
+	int Value = 1;
+	char Padding[Size - sizeof(int) - (std::is_empty_v<Base> ? 0 : sizeof(Base))] = {};
+
+	Payload() = default;
+	explicit Payload(int value) : Value(value) {}
+};
+
+struct NoBase {};
+
+template<size_t Size>
+struct Value
+{
+	static constexpr const char* Name = "Value";
+	static constexpr bool Copyable = true;
+	using Object = Payload<Size, NoBase>;
+	using Owner = Object;
+	static Owner Make(int value) { return Object(value); }
+	static const Object& Get(const Owner& owner) { return owner; }
+	static void Destroy(std::vector<Owner>& owners) { owners.clear(); }
+};
+
+template<size_t Size>
+struct Raw
+{
+	static constexpr const char* Name = "Raw new and delete";
+	static constexpr bool Copyable = false;
+	using Object = Payload<Size, NoBase>;
+	using Owner = Object*;
+	static Owner Make(int value) { return new Object(value); }
+	static const Object& Get(const Owner& owner) { return *owner; }
+	static void Destroy(std::vector<Owner>& owners)
+	{
+		for (Owner owner : owners)
+			delete owner;
+		owners.clear();
+	}
+};
+
+template<size_t Size>
+struct Scoped
+{
+	static constexpr const char* Name = "ScopedPtr";
+	static constexpr bool Copyable = false;
+	using Object = Payload<Size, NoBase>;
+	using Owner = ScopedPtr<Object>;
+	static Owner Make(int value) { return MakeScoped<Object>(value); }
+	static const Object& Get(const Owner& owner) { return *owner; }
+	static void Destroy(std::vector<Owner>& owners) { owners.clear(); }
+};
+
+template<size_t Size>
+struct Unique
+{
+	static constexpr const char* Name = "std::unique_ptr";
+	static constexpr bool Copyable = false;
+	using Object = Payload<Size, NoBase>;
+	using Owner = std::unique_ptr<Object>;
+	static Owner Make(int value) { return std::make_unique<Object>(value); }
+	static const Object& Get(const Owner& owner) { return *owner; }
+	static void Destroy(std::vector<Owner>& owners) { owners.clear(); }
+};
+
+template<size_t Size>
+struct MakeShared
+{
+	static constexpr const char* Name = "std::shared_ptr, make_shared";
+	static constexpr bool Copyable = true;
+	using Object = Payload<Size, NoBase>;
+	using Owner = std::shared_ptr<Object>;
+	static Owner Make(int value) { return std::make_shared<Object>(value); }
+	static const Object& Get(const Owner& owner) { return *owner; }
+	static void Destroy(std::vector<Owner>& owners) { owners.clear(); }
+};
+
+// The control block is a second allocation, somewhere else in memory
+template<size_t Size>
+struct SharedFromNew
+{
+	static constexpr const char* Name = "std::shared_ptr, new";
+	static constexpr bool Copyable = true;
+	using Object = Payload<Size, NoBase>;
+	using Owner = std::shared_ptr<Object>;
+	static Owner Make(int value) { return Owner(new Object(value)); }
+	static const Object& Get(const Owner& owner) { return *owner; }
+	static void Destroy(std::vector<Owner>& owners) { owners.clear(); }
+};
+
+template<size_t Size>
+struct AtomicRef
+{
+	static constexpr const char* Name = "Ref, RefCounted";
+	static constexpr bool Copyable = true;
+	using Object = Payload<Size, RefCounted>;
+	using Owner = Ref<Object>;
+	static Owner Make(int value) { return MakeRef<Object>(value); }
+	static const Object& Get(const Owner& owner) { return *owner; }
+	static void Destroy(std::vector<Owner>& owners) { owners.clear(); }
+};
+
+template<size_t Size>
+struct LocalRef
+{
+	static constexpr const char* Name = "Ref, LocalRefCounted";
+	static constexpr bool Copyable = true;
+	using Object = Payload<Size, LocalRefCounted>;
+	using Owner = Ref<Object>;
+	static Owner Make(int value) { return MakeRef<Object>(value); }
+	static const Object& Get(const Owner& owner) { return *owner; }
+	static void Destroy(std::vector<Owner>& owners) { owners.clear(); }
+};
+
+// Like RunBenchmark, but setup() runs before every timed run without being timed, so each phase can be measured on its own
+template<typename Setup, typename F>
+static void RunPhase(const std::string& name, uint64_t operations, Setup&& setup, F&& func, bool countAllocations = false, int runs = 5)
+{
+	double best = 1e300;
+	double allocations = 0.0;
+	for (int i = 0; i < runs + 1; i++)	// The first run is the warm up
+	{
+		setup();
+		uint64_t before = AllocationCount();
+		Timer timer;
+		func();
+		ClobberMemory();
+		double seconds = timer.ElapsedSeconds();
+		allocations = (double)(AllocationCount() - before) / (double)operations;
+		if (i > 0 && seconds < best)
+			best = seconds;
+	}
+
+	BenchmarkResult result;
+	result.Name = name;
+	if (countAllocations)
+		result.Allocations = allocations;
+	result.Seconds = best;
+	result.Operations = operations;
+	BenchmarkReport::Get().Add(result);
+}
+
+template<typename Style>
+static void RunStyle(size_t count)
+{
+	using Owner = typename Style::Owner;
+	const std::string name = Style::Name;
+
+	std::vector<Owner> owners;
+	owners.reserve(count);
+	RunPhase(name + ", make", count, [&]() { Style::Destroy(owners); }, [&]()
+	{
+		for (size_t i = 0; i < count; i++)
+			owners.push_back(Style::Make((int)i));
+	}, true);
+
+	auto fill = [&]()
+	{
+		Style::Destroy(owners);
+		for (size_t i = 0; i < count; i++)
+			owners.push_back(Style::Make((int)i));
+	};
+	RunPhase(name + ", destroy", count, fill, [&]() { Style::Destroy(owners); });
+
+	fill();
+	if constexpr (Style::Copyable)
+	{
+		std::vector<Owner> copies;
+		copies.reserve(count);
+		RunPhase(name + ", copy", count, [&]() { copies.clear(); }, [&]()
+		{
+			copies.insert(copies.end(), owners.begin(), owners.end());
+		});
+	}
+
+	std::vector<Owner> moved;
+	moved.reserve(count);
+	RunPhase(name + ", move", count, [&]()
+	{
+		if (owners.empty())
+			std::swap(owners, moved);
+	}, [&]()
+	{
+		for (Owner& owner : owners)
+			moved.push_back(std::move(owner));
+		owners.clear();
+	});
+	if (owners.empty())
+		std::swap(owners, moved);
+
+	// Values can't be shuffled without moving the objects themselves, so they stay in order
+	if constexpr (!std::is_same_v<Owner, typename Style::Object>)
+	{
+		uint32_t random = 12345;
+		for (size_t i = count - 1; i > 0; i--)
+		{
+			random = random * 1664525 + 1013904223;
+			std::swap(owners[i], owners[random % (i + 1)]);
+		}
+	}
+	uint64_t sum = 0;
+	RunPhase(name + ", walk", count, []() {}, [&]()
+	{
+		for (const Owner& owner : owners)
+			sum += Style::Get(owner).Value;
+		DoNotOptimize(sum);
+	});
+	Style::Destroy(owners);
+}
+
+template<size_t Size>
+static void RunSize(size_t count)
+{
+	static_assert(sizeof(Payload<Size, NoBase>) == Size && sizeof(Payload<Size, RefCounted>) == Size && sizeof(Payload<Size, LocalRefCounted>) == Size,
+		"Every style must allocate objects of the same size");
+	BenchmarkReport::Get().BeginSuite("Ownership: " + std::to_string(count) + " objects of " + std::to_string(Size) + " bytes");
+	RunStyle<Value<Size>>(count);
+	RunStyle<Raw<Size>>(count);
+	RunStyle<Scoped<Size>>(count);
+	RunStyle<Unique<Size>>(count);
+	RunStyle<MakeShared<Size>>(count);
+	RunStyle<SharedFromNew<Size>>(count);
+	RunStyle<AtomicRef<Size>>(count);
+	RunStyle<LocalRef<Size>>(count);
+}
+
+void RunOwnershipBenchmarks()
+{
+	std::thread([]() {}).join();	// So GCC's shared_ptr uses its atomic count, see RefCountedBenchmark.cpp
+
+	for (size_t count : { (size_t)1 << 10, (size_t)1 << 17 })
+	{
+		RunSize<32>(count);
+		RunSize<64>(count);
+		RunSize<256>(count);
+	}
+}
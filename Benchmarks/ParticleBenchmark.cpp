@@ -0,0 +1,103 @@
+#include <vector>
+
+#include "Benchmark.h"
+#include "JobSystem.h"
+#include "ParticleSystem.h"
+
+// Headless particle updates, nothing is drawn
+// Update: moving 1M particles one frame, on one thread and on all threads (Mops/s is millions of particles updated per second)
+// Array of structs: the same maths on a std::vector<Particle>, for comparison with the separate arrays
+// Spawn / kill: the O(1) operations on their own. Steady state: an emitter keeps about 1M particles alive while they die and respawn
+
+static const size_t s_Count = 1 << 20;
+static const float s_DeltaTime = 1.0f / 60.0f;
+
+struct Particle
+{
+	Vector2 Position;
+	Vector2 Velocity;
+	float Lifetime;
+};
+
+void RunParticleBenchmarks()
+{
+	size_t threads = JobSystem::Get().ThreadCount();
+	BenchmarkReport::Get().BeginSuite("Particles: 1M particles (" + std::to_string(threads) + " threads)");
+
+	Vector2 gravity(0.0f, -9.81f);
+	ParticleSystem particles(s_Count);
+	particles.Emit(s_Count, Vector2(0.0f, 0.0f), 64, 32, 5.0f, 1e9f);	// Lives long enough that nothing dies while we measure
+
+	std::vector<Particle> structs(s_Count);
+	for (size_t i = 0; i < s_Count; i++)
+		structs[i] = { particles.GetPosition(i), particles.GetVelocity(i), particles.GetLifetime(i) };
+
+	uint64_t bytes = s_Count * sizeof(float) * 5 * 2;
+
+	RunBenchmark("array of structs, 1 thread", s_Count, [&]()
+	{
+		Vector2 gravityStep = gravity * s_DeltaTime;
+		for (Particle& particle : structs)
+		{
+			particle.Velocity = particle.Velocity + gravityStep;
+			particle.Position = particle.Position + particle.Velocity * s_DeltaTime;
+			particle.Lifetime -= s_DeltaTime;
+		}
+	}, bytes);
+
+	RunBenchmark("separate arrays, 1 thread", s_Count, [&]()
+	{
+		particles.Update(s_DeltaTime, gravity, 1);
+	}, bytes);
+
+	RunBenchmark("separate arrays, all threads", s_Count, [&]()
+	{
+		particles.Update(s_DeltaTime, gravity);
+	}, bytes);
+
+	// Every benchmark ran 6 frames (a warm up and 5 runs), so the structs are 6 frames in and the particle system 12
+	// 6 more frames of one struct particle should land exactly where the particle system has it
+	ParticleSystem check(1);
+	check.Spawn(structs[12345].Position, structs[12345].Velocity, structs[12345].Lifetime);
+	for (int frame = 0; frame < 6; frame++)
+		check.Update(s_DeltaTime, gravity, 1);
+	if (check.GetPosition(0) != particles.GetPosition(12345))
+		std::cout << "  The separate arrays and the structs don't match!" << std::endl;
+
+	RunBenchmark("spawn", s_Count, [&]()
+	{
+		particles.Clear();
+		for (size_t i = 0; i < s_Count; i++)
+			particles.Spawn(Vector2(1.0f, 2.0f), Vector2(3.0f, 4.0f), 1.0f);
+	});
+
+	RunBenchmark("kill (swap-remove)", s_Count, [&]()
+	{
+		particles.Emit(s_Count - particles.Size(), Vector2(), 0, 0, 1.0f, 1.0f);
+		uint32_t random = 1;
+		while (particles.Size() > 0)
+		{
+			random = random * 1664525u + 1013904223u;
+			particles.Kill(random % particles.Size());
+		}
+	});
+
+	// Particles live 1 second and 1M are spawned every second, so about 1M are alive in every frame
+	ParticleEmitter emitter;
+	emitter.Rate = (float)s_Count;
+	emitter.Lifetime = 1.0f;
+	emitter.Speed = 5.0f;
+	particles.Clear();
+	for (int frame = 0; frame < 70; frame++)
+	{
+		emitter.Update(particles, s_DeltaTime);
+		particles.Update(s_DeltaTime, gravity);
+	}
+
+	RunBenchmark("steady state frame (emit and update)", s_Count, [&]()
+	{
+		emitter.Update(particles, s_DeltaTime);
+		particles.Update(s_DeltaTime, gravity);
+	});
+	std::cout << "  " << particles.Size() << " particles alive" << std::endl;
+}
@@ -0,0 +1,86 @@
+#include <algorithm>
+#include <memory>
+#include <random>
+#include <vector>
+
+#include "Benchmark.h"
+#include "PolyCollection.h"
+#include "Printable.h"
+
+// Calls GetClassName() on a million mixed PlainClass and InheritingClass objects
+// The pointer vector gets its objects in a random order, like they would be after a while of creating and destroying things
+// The PolyCollection holds exactly the same objects, grouped by type
+
+static const size_t s_ObjectCount = 1000000;
+
+void RunPolyCollectionBenchmarks()
+{
+	BenchmarkReport::Get().BeginSuite("PolyCollection: GetClassName() over 1M mixed objects");
+
+	std::mt19937 random(42);
+	std::vector<bool> types(s_ObjectCount);
+	for (size_t i = 0; i < s_ObjectCount; i++)
+		types[i] = (random() & 1) != 0;
+
+	std::vector<std::unique_ptr<Printable>> storage;
+	storage.reserve(s_ObjectCount);
+	for (bool inheriting : types)
+	{
+		if (inheriting)
+			storage.push_back(std::make_unique<InheritingClass>("Cherno"));
+		else
+			storage.push_back(std::make_unique<PlainClass>());
+	}
+	std::vector<Printable*> pointers;
+	pointers.reserve(s_ObjectCount);
+	for (std::unique_ptr<Printable>& object : storage)
+		pointers.push_back(object.get());
+	std::shuffle(pointers.begin(), pointers.end(), random);
+
+	PolyCollection<Printable> collection;
+	RunBenchmark("PolyCollection::Emplace", s_ObjectCount, [&]()
+	{
+		collection = PolyCollection<Printable>();
+		for (bool inheriting : types)
+		{
+			if (inheriting)
+				collection.Emplace<InheritingClass>("Cherno");
+			else
+				collection.Emplace<PlainClass>();
+		}
+	}, 0, 3);
+
+	RunBenchmark("std::vector<Printable*>", s_ObjectCount, [&]()
+	{
+		size_t total = 0;
+		for (Printable* obj : pointers)
+		{
+			total += obj->GetClassName().size();
+			DoNotOptimize(total);
+		}
+	});
+
+	RunBenchmark("PolyCollection::ForEach (Printable&)", s_ObjectCount, [&]()
+	{
+		size_t total = 0;
+		collection.ForEach([&](Printable& obj)
+		{
+			total += obj.GetClassName().size();
+			DoNotOptimize(total);
+		});
+	});
+
+	RunBenchmark("PolyCollection::ForEach<Plain, Inheriting>", s_ObjectCount, [&]()
+	{
+		size_t total = 0;
+		collection.ForEach<PlainClass, InheritingClass>([&](auto& obj)
+		{
+			using T = std::decay_t<decltype(obj)>;
+			if constexpr (std::is_same_v<T, Printable>)	// Any segment of a type we didn't list still comes through as a Printable&
+				total += obj.GetClassName().size();
+			else
+				total += obj.T::GetClassName().size();
+			DoNotOptimize(total);
+		});
+	});
+}
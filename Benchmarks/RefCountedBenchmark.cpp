@@ -0,0 +1,148 @@
+#include <memory>
+#include <string>
+#include <thread>
+#include <vector>
+
+#include "Benchmark.h"
+#include "JobSystem.h"
+#include "RefCounted.h"
+
+// Ref (an atomic count inside the object) and Ref to a LocalRefCounted (a plain count) against std::shared_ptr from make_shared
+// Make and destroy: 1M objects made and destroyed one after the other
+// Copy and destroy: 1M copies of a reference to one object, each destroyed straight away
+// Dereference: summing a field through 1M references to different objects, made in a shuffled order so the objects are all over memory
+// Threads: every thread copies and destroys references 1M times, either to one object they all share (so they fight over its count) or each to its own object
+// LocalRefCounted isn't in the threads part, because its count must never be touched by two threads
+//
+// GCC's shared_ptr quietly uses a plain count while the programme has never started a second thread, which is exactly the trick LocalRefCounted makes explicit
+// A thread is started before anything is measured, so shared_ptr is measured as it behaves in any programme that uses threads
+
+struct SharedEntity
+{
+	float X = 0.0f, Y = 0.0f;
+	int Health = 100;
+};
+
+struct AtomicEntity : RefCounted
+{
+	float X = 0.0f, Y = 0.0f;
+	int Health = 100;
+};
+
+struct LocalEntity : LocalRefCounted
+{
+	float X = 0.0f, Y = 0.0f;
+	int Health = 100;
+};
+
+static const size_t s_Count = 1 << 20;
+
+template<typename Pointer, typename Make>
+static void RunSingleThread(const std::string& name, Make&& make)
+{
+	int check = 0;
+	RunCountingBenchmark(name + ", make and destroy", s_Count, [&]()
+	{
+		for (size_t i = 0; i < s_Count; i++)
+		{
+			Pointer entity = make();
+			DoNotOptimize(entity);
+			check += entity->Health;
+		}
+	});
+
+	Pointer original = make();
+	RunBenchmark(name + ", copy and destroy", s_Count, [&]()
+	{
+		for (size_t i = 0; i < s_Count; i++)
+		{
+			Pointer copy = original;
+			DoNotOptimize(copy);
+		}
+	});
+
+	// Made in order, then shuffled, so walking them isn't just walking memory in order
+	std::vector<Pointer> entities;
+	entities.reserve(s_Count);
+	for (size_t i = 0; i < s_Count; i++)
+		entities.push_back(make());
+	uint32_t random = 12345;
+	for (size_t i = s_Count - 1; i > 0; i--)
+	{
+		random = random * 1664525 + 1013904223;
+		std::swap(entities[i], entities[random % (i + 1)]);
+	}
+	float sum = 0.0f;
+	RunBenchmark(name + ", dereference", s_Count, [&]()
+	{
+		for (const Pointer& entity : entities)
+			sum += entity->X + (float)entity->Health;
+		DoNotOptimize(sum);
+	});
+	DoNotOptimize(check);
+}
+
+template<typename Pointer, typename Make>
+static void RunThreads(const std::string& name, size_t threads, Make&& make)
+{
+	Pointer shared = make();
+	RunBenchmark(name + ", " + std::to_string(threads) + " threads, one shared object", s_Count * threads, [&]()
+	{
+		JobSystem::Get().ParallelFor(threads, 1, [&](size_t begin, size_t end)
+		{
+			for (size_t thread = begin; thread < end; thread++)
+			{
+				for (size_t i = 0; i < s_Count; i++)
+				{
+					Pointer copy = shared;
+					DoNotOptimize(copy);
+				}
+			}
+		}, threads);
+	});
+
+	std::vector<Pointer> own;
+	for (size_t i = 0; i < threads; i++)
+		own.push_back(make());
+	RunBenchmark(name + ", " + std::to_string(threads) + " threads, an object each", s_Count * threads, [&]()
+	{
+		JobSystem::Get().ParallelFor(threads, 1, [&](size_t begin, size_t end)
+		{
+			for (size_t thread = begin; thread < end; thread++)
+			{
+				for (size_t i = 0; i < s_Count; i++)
+				{
+					Pointer copy = own[thread];
+					DoNotOptimize(copy);
+				}
+			}
+		}, threads);
+	});
+}
+
+void RunRefCountedBenchmarks()
+{
+	std::thread([]() {}).join();
+
+	auto makeShared = []() { return std::make_shared<SharedEntity>(); };
+	auto makeAtomic = []() { return MakeRef<AtomicEntity>(); };
+	auto makeLocal = []() { return MakeRef<LocalEntity>(); };
+
+	BenchmarkReport::Get().BeginSuite("Reference counting: one thread, 1M operations");
+	RunSingleThread<std::shared_ptr<SharedEntity>>("std::shared_ptr", makeShared);
+	RunSingleThread<Ref<AtomicEntity>>("Ref, RefCounted", makeAtomic);
+	RunSingleThread<Ref<LocalEntity>>("Ref, LocalRefCounted", makeLocal);
+	std::cout << "  sizeof(std::shared_ptr) = " << sizeof(std::shared_ptr<SharedEntity>) << ", sizeof(Ref) = " << sizeof(Ref<AtomicEntity>) << std::endl;
+
+	BenchmarkReport::Get().BeginSuite("Reference counting: copy and destroy 1M times on every thread");
+	size_t threads = JobSystem::Get().ThreadCount();
+	std::vector<size_t> counts;
+	for (size_t count = 1; count < threads; count *= 2)
+		counts.push_back(count);
+	counts.push_back(threads);
+	for (size_t count : counts)
+	{
+		RunThreads<std::shared_ptr<SharedEntity>>("std::shared_ptr", count, makeShared);
+		RunThreads<Ref<AtomicEntity>>("Ref, RefCounted", count, makeAtomic);
+	}
+}
@@ -0,0 +1,163 @@
+#include <cstdlib>
+#include <memory>
+#include <string>
+#include <vector>
+
+#include "Benchmark.h"
+#include "MonotonicArena.h"
+#include "ObjectPool.h"
+#include "ScopedPtr.h"
+
+// ScopedPtr against std::unique_ptr and raw pointers, on a 32 byte object
+// Make and destroy: 1M objects made and destroyed one after the other, with new, from malloc, from an ObjectPool and from a MonotonicArena
+// Vector of owners: 1M owners pushed into a vector without reserve (so every growth moves them), summed through, then destroyed
+// Every name is followed by how many heap allocations one object cost
+
+struct Entity
+{
+	float X = 0.0f, Y = 0.0f;
+	float VelocityX = 1.0f, VelocityY = 2.0f;
+	int Id = 0;
+	int Flags = 0;
+	int Health = 100;
+	int Team = 0;
+
+	Entity() = default;
+	explicit Entity(int id) : Id(id) {}
+};
+
+static const size_t s_Count = 1 << 20;
+
+template<typename Pointer>
+static void PrintSize(const char* name)
+{
+	std::cout << "  sizeof(" << name << ") = " << sizeof(Pointer) << std::endl;
+}
+
+static void RunMakeAndDestroy()
+{
+	BenchmarkReport::Get().BeginSuite("ScopedPtr: make and destroy 1M objects");
+	uint64_t check = 0;
+
+	RunCountingBenchmark("Raw pointer, new and delete", s_Count, [&]()
+	{
+		for (size_t i = 0; i < s_Count; i++)
+		{
+			Entity* entity = new Entity((int)i);
+			DoNotOptimize(entity);
+			check += entity->Health;
+			delete entity;
+		}
+	});
+
+	RunCountingBenchmark("std::unique_ptr, make_unique", s_Count, [&]()
+	{
+		for (size_t i = 0; i < s_Count; i++)
+		{
+			std::unique_ptr<Entity> entity = std::make_unique<Entity>((int)i);
+			DoNotOptimize(entity);
+			check += entity->Health;
+		}
+	});
+
+	RunCountingBenchmark("ScopedPtr, MakeScoped", s_Count, [&]()
+	{
+		for (size_t i = 0; i < s_Count; i++)
+		{
+			ScopedPtr<Entity> entity = MakeScoped<Entity>((int)i);
+			DoNotOptimize(entity);
+			check += entity->Health;
+		}
+	});
+
+	// The function pointer has to be stored in every unique_ptr, and is called through that pointer
+	RunCountingBenchmark("std::unique_ptr, malloc and &free", s_Count, [&]()
+	{
+		for (size_t i = 0; i < s_Count; i++)
+		{
+			std::unique_ptr<Entity, void(*)(void*)> entity(new (malloc(sizeof(Entity))) Entity((int)i), free);
+			DoNotOptimize(entity);
+			check += entity->Health;
+		}
+	});
+
+	RunCountingBenchmark("ScopedPtr, malloc and FreeDelete", s_Count, [&]()
+	{
+		for (size_t i = 0; i < s_Count; i++)
+		{
+			ScopedPtr<Entity, FreeDelete> entity(new (malloc(sizeof(Entity))) Entity((int)i));
+			DoNotOptimize(entity);
+			check += entity->Health;
+		}
+	});
+
+	ObjectPool<Entity> pool;
+	RunCountingBenchmark("ScopedPtr, ObjectPool", s_Count, [&]()
+	{
+		for (size_t i = 0; i < s_Count; i++)
+		{
+			ScopedPtr<Entity, PoolDelete<Entity>> entity = pool.MakeScoped((int)i);
+			DoNotOptimize(entity);
+			check += entity->Health;
+		}
+	});
+
+	MonotonicArena arena(1 << 20);
+	RunCountingBenchmark("ScopedPtr, MonotonicArena", s_Count, [&]()
+	{
+		for (size_t i = 0; i < s_Count; i++)
+		{
+			ScopedPtr<Entity, ArenaDelete<Entity>> entity = MakeScopedIn<Entity>(arena, (int)i);
+			DoNotOptimize(entity);
+			check += entity->Health;
+		}
+		arena.Reset();
+	});
+	DoNotOptimize(check);
+
+	PrintSize<Entity*>("Entity*");
+	PrintSize<std::unique_ptr<Entity>>("std::unique_ptr<Entity>");
+	PrintSize<ScopedPtr<Entity>>("ScopedPtr<Entity>");
+	PrintSize<std::unique_ptr<Entity, void(*)(void*)>>("std::unique_ptr<Entity, void(*)(void*)>");
+	PrintSize<ScopedPtr<Entity, FreeDelete>>("ScopedPtr<Entity, FreeDelete>");
+	PrintSize<ScopedPtr<Entity, ArenaDelete<Entity>>>("ScopedPtr<Entity, ArenaDelete<Entity>>");
+	PrintSize<ScopedPtr<Entity, PoolDelete<Entity>>>("ScopedPtr<Entity, PoolDelete<Entity>>");
+}
+
+template<typename Owner, typename Make>
+static void RunVectorOfOwners(const std::string& name, Make&& make)
+{
+	float sum = 0.0f;
+	RunCountingBenchmark(name, s_Count, [&]()
+	{
+		std::vector<Owner> owners;
+		for (size_t i = 0; i < s_Count; i++)
+			owners.push_back(make((int)i));
+		for (const Owner& owner : owners)
+			sum += owner->X + owner->VelocityX;
+		DoNotOptimize(sum);
+	});
+}
+
+void RunScopedPtrBenchmarks()
+{
+	RunMakeAndDestroy();
+
+	BenchmarkReport::Get().BeginSuite("ScopedPtr: vector of 1M owners");
+	float sum = 0.0f;
+	RunCountingBenchmark("Raw pointer, deleted by hand", s_Count, [&]()
+	{
+		std::vector<Entity*> entities;
+		for (size_t i = 0; i < s_Count; i++)
+			entities.push_back(new Entity((int)i));
+		for (const Entity* entity : entities)
+			sum += entity->X + entity->VelocityX;
+		DoNotOptimize(sum);
+		for (Entity* entity : entities)
+			delete entity;
+	});
+	RunVectorOfOwners<std::unique_ptr<Entity>>("std::unique_ptr", [](int id) { return std::make_unique<Entity>(id); });
+	RunVectorOfOwners<ScopedPtr<Entity>>("ScopedPtr", [](int id) { return MakeScoped<Entity>(id); });
+	ObjectPool<Entity> pool(4096);
+	RunVectorOfOwners<ScopedPtr<Entity, PoolDelete<Entity>>>("ScopedPtr, ObjectPool", [&](int id) { return pool.MakeScoped(id); });
+}
@@ -0,0 +1,68 @@
+#include <memory>
+#include <string>
+#include <vector>
+
+#include "Benchmark.h"
+#include "SharedString.h"
+#include "StringClass.h"
+
+// Fan out: one string copied into 1M holders, and the holders destroyed again
+// StringClass and std::string copy the characters every time. SharedString and LocalSharedString only add 1 to the reference count
+// std::shared_ptr<const std::string> shares too, but its count lives in a separate control block and the pointer is twice the size
+// Note that libstdc++ quietly uses a plain count for shared_ptr while a programme has never started a thread, so with GCC it compares with LocalSharedString, not SharedString
+
+static const size_t s_Count = 1 << 20;
+
+template<typename T>
+struct Holder
+{
+	T Name;
+	uint32_t Id;
+};
+
+template<typename T>
+static void RunFanOut(const char* typeName, const T& source)
+{
+	std::vector<Holder<T>> holders;
+	holders.reserve(s_Count);
+	RunCountingBenchmark(typeName, s_Count, [&]()
+	{
+		holders.clear();
+		for (size_t i = 0; i < s_Count; i++)
+			holders.push_back({ source, (uint32_t)i });
+		DoNotOptimize(holders.back());
+	});
+}
+
+static void RunFanOuts(const char* text)
+{
+	RunFanOut("StringClass", StringClass(text));
+	RunFanOut("std::string", std::string(text));
+	RunFanOut("std::shared_ptr<const std::string>", std::make_shared<const std::string>(text));
+	RunFanOut("SharedString (atomic)", SharedString(text));
+	RunFanOut("LocalSharedString (not atomic)", LocalSharedString(text));
+}
+
+void RunSharedStringBenchmarks()
+{
+	BenchmarkReport::Get().BeginSuite("Shared strings: \"Cherno\" copied into 1M holders");
+	RunFanOuts("Cherno");
+
+	BenchmarkReport::Get().BeginSuite("Shared strings: a 66 character string copied into 1M holders");
+	RunFanOuts("A string that is long enough to need the heap in every string type");
+
+	// Copy on write: a change to one holder's copy costs one new buffer, and the others keep the original
+	std::vector<SharedString> holders(s_Count, SharedString("Cherno"));
+	holders[0].MutableData()[0] = 'c';
+	std::cout << "  After changing one copy: " << holders[0] << " (used " << holders[0].UseCount() << " time), "
+		<< holders[1] << " (used " << holders[1].UseCount() << " times)" << std::endl;
+
+	// Appending a string to itself reads the characters that are being replaced
+	SharedString doubled("Cherno");
+	for (int i = 0; i < 4; i++)
+		doubled.Append(doubled.View());
+	SharedString shared = doubled;
+	shared.Append(shared.View());
+	if (doubled.Size() != 96 || shared.Size() != 192 || shared.View().substr(96) != doubled.View() || doubled.View().substr(90) != "Cherno")
+		std::cout << "  Appending a SharedString to itself went wrong!" << std::endl;
+}
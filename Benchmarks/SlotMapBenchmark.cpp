@@ -0,0 +1,117 @@
+#include <string>
+#include <vector>
+
+#include "Benchmark.h"
+#include "DynamicArray.h"
+#include "SlotMap.h"
+#include "Vertex.h"
+
+// Removing vertices from the middle of a list and adding new ones, over and over, with the list always the same size
+// Every operation erases the vertex at a random position and pushes a new one on the end
+// std::vector::erase and DynamicArray::Erase keep the order, so every later vertex moves down one place: O(n), and it shows more the longer the list is
+// UnorderedErase moves only the last vertex into the gap. SlotMap does the same, and also keeps every vertex's key working
+// Walk: summing every vertex afterwards. A SlotMap's values are packed together like a vector's, so it walks just as fast
+
+static std::vector<uint32_t> MakeRandoms(size_t count)
+{
+	std::vector<uint32_t> randoms(count);
+	uint32_t random = 12345;
+	for (uint32_t& value : randoms)
+	{
+		random = random * 1664525 + 1013904223;
+		value = random >> 8;
+	}
+	return randoms;
+}
+
+static void RunSize(size_t count, size_t operations)
+{
+	BenchmarkReport::Get().BeginSuite("Slot map: " + std::to_string(operations) + " erases and pushes on " + std::to_string(count) + " vertices");
+	std::vector<uint32_t> randoms = MakeRandoms(operations);
+
+	std::vector<Vertex> vector(count, Vertex(1.0f, 2.0f, 3.0f));
+	RunBenchmark("std::vector, erase", operations, [&]()
+	{
+		for (size_t i = 0; i < operations; i++)
+		{
+			vector.erase(vector.begin() + randoms[i] % count);
+			vector.emplace_back((float)i, 2.0f, 3.0f);
+		}
+		ClobberMemory();
+	}, 0, 2);	// Erasing in order from a long list takes long enough that fewer runs are plenty
+	RunBenchmark("std::vector, unordered erase", operations, [&]()
+	{
+		for (size_t i = 0; i < operations; i++)
+		{
+			UnorderedErase(vector, randoms[i] % count);
+			vector.emplace_back((float)i, 2.0f, 3.0f);
+		}
+		ClobberMemory();
+	});
+
+	DynamicArray<Vertex> array(count, Vertex(1.0f, 2.0f, 3.0f));
+	RunBenchmark("DynamicArray, Erase", operations, [&]()
+	{
+		for (size_t i = 0; i < operations; i++)
+		{
+			array.Erase(randoms[i] % count);
+			array.EmplaceBack((float)i, 2.0f, 3.0f);
+		}
+		ClobberMemory();
+	}, 0, 2);
+	RunBenchmark("DynamicArray, unordered erase", operations, [&]()
+	{
+		for (size_t i = 0; i < operations; i++)
+		{
+			array.UnorderedErase(randoms[i] % count);
+			array.EmplaceBack((float)i, 2.0f, 3.0f);
+		}
+		ClobberMemory();
+	});
+
+	SlotMap<Vertex> map;
+	map.Reserve(count);
+	for (size_t i = 0; i < count; i++)
+		map.Emplace(1.0f, 2.0f, 3.0f);
+	RunBenchmark("SlotMap, Erase and Emplace", operations, [&]()
+	{
+		for (size_t i = 0; i < operations; i++)
+		{
+			map.Erase(map.KeyAt(randoms[i] % count));
+			map.Emplace((float)i, 2.0f, 3.0f);
+		}
+		ClobberMemory();
+	});
+
+	// Finding vertices by the keys they were given, after all that churn
+	std::vector<SlotMapKey> keys;
+	for (size_t i = 0; i < count; i++)
+		keys.push_back(map.KeyAt(i));
+	float sum = 0.0f;
+	RunBenchmark("SlotMap, Find by key", operations, [&]()
+	{
+		for (size_t i = 0; i < operations; i++)
+			sum += map.Find(keys[randoms[i] % count])->x;
+		DoNotOptimize(sum);
+	});
+
+	RunBenchmark("std::vector, walk", count, [&]()
+	{
+		for (const Vertex& vertex : vector)
+			sum += vertex.x + vertex.y;
+		DoNotOptimize(sum);
+	}, count * sizeof(Vertex));
+	RunBenchmark("SlotMap, walk", count, [&]()
+	{
+		for (const Vertex& vertex : map)
+			sum += vertex.x + vertex.y;
+		DoNotOptimize(sum);
+	}, count * sizeof(Vertex));
+}
+
+void RunSlotMapBenchmarks()
+{
+	RunSize(1 << 10, 1 << 20);
+	RunSize(1 << 16, 1 << 16);
+	RunSize(1 << 20, 1 << 12);
+}
@@ -0,0 +1,99 @@
+#include <cstring>
+#include <string>
+#include <utility>
+#include <vector>
+
+#include "Benchmark.h"
+#include "StringClass.h"
+
+// StringClass with its small string buffer and move operations, against the old StringClass (only a deep-copying copy constructor) and std::string
+// "Cherno" fits in the small string buffer of all of them except the old one. The 41 character string doesn't fit in any of them
+// Copy: copying one string 1M times. Move: moving 1M strings from one vector to another. Vector growth: push_back of 1M strings without reserve
+// Every name is followed by how many heap allocations one string cost
+
+class LegacyStringClass
+{
+private:
+	char* m_Buffer;
+	unsigned int m_Size;
+public:
+	LegacyStringClass(const char* string)
+	{
+		m_Size = (unsigned int)strlen(string);
+		m_Buffer = new char[m_Size + 1];
+		memcpy(m_Buffer, string, m_Size + 1);
+	}
+	LegacyStringClass(const LegacyStringClass& other)
+		: m_Size(other.m_Size)
+	{
+		m_Buffer = new char[m_Size + 1];
+		memcpy(m_Buffer, other.m_Buffer, m_Size + 1);
+	}
+	// The old class had no assignment at all, so the default one would have shared the buffer. This is the copy it should have had
+	LegacyStringClass& operator=(const LegacyStringClass& other)
+	{
+		if (this != &other)
+		{
+			LegacyStringClass copy(other);
+			std::swap(m_Buffer, copy.m_Buffer);
+			std::swap(m_Size, copy.m_Size);
+		}
+		return *this;
+	}
+	~LegacyStringClass() { delete[] m_Buffer; }
+};
+
+static const size_t s_Count = 1 << 20;
+
+template<typename T>
+static void RunStringBenchmarks(const char* typeName, const char* text)
+{
+	T source(text);
+	std::vector<T> copies;
+	copies.reserve(s_Count);
+	RunCountingBenchmark(std::string(typeName) + " copy", s_Count, [&]()
+	{
+		copies.clear();
+		for (size_t i = 0; i < s_Count; i++)
+			copies.emplace_back(source);
+		DoNotOptimize(copies.back());
+	});
+	copies = std::vector<T>();
+
+	// The old class can't be moved, so std::move falls back to its copy assignment
+	std::vector<T> from(s_Count, source), to(s_Count, source);
+	RunCountingBenchmark(std::string(typeName) + " move", s_Count, [&]()
+	{
+		for (size_t i = 0; i < s_Count; i++)
+			to[i] = std::move(from[i]);
+		std::swap(from, to);
+		DoNotOptimize(from.back());
+	});
+	from = std::vector<T>();
+	to = std::vector<T>();
+
+	// Includes making each string. When the vector grows it has to move (or copy) every string it already has
+	RunCountingBenchmark(std::string(typeName) + " vector growth", s_Count, [&]()
+	{
+		std::vector<T> strings;
+		for (size_t i = 0; i < s_Count; i++)
+			strings.push_back(T(text));
+		DoNotOptimize(strings.back());
+	});
+}
+
+void RunStringBenchmarks()
+{
+	const char* shortText = "Cherno";
+	const char* longText = "This string is far too long to fit inline";
+
+	BenchmarkReport::Get().BeginSuite("Strings: 1M copies and moves of \"Cherno\"");
+	RunStringBenchmarks<LegacyStringClass>("old StringClass", shortText);
+	RunStringBenchmarks<StringClass>("StringClass", shortText);
+	RunStringBenchmarks<std::string>("std::string", shortText);
+
+	BenchmarkReport::Get().BeginSuite("Strings: 1M copies and moves of a 41 character string");
+	RunStringBenchmarks<LegacyStringClass>("old StringClass", longText);
+	RunStringBenchmarks<StringClass>("StringClass", longText);
+	RunStringBenchmarks<std::string>("std::string", longText);
+}
@@ -0,0 +1,103 @@
+#include <string>
+#include <string_view>
+
+#include "Benchmark.h"
+#include "StringBuilder.h"
+#include "StringClass.h"
+
+// Building a 100 MB string out of short pieces (2 to 13 characters)
+// std::string +=: grows 2x at a time, copying everything it has so far each time. With reserve: the best std::string can do when you know the size up front
+// StringBuilder: appending only, then appending plus the single copy into a std::string or a StringClass at the end
+
+static const size_t s_TargetSize = 100 * 1000 * 1000;
+
+static const std::string_view s_Pieces[] = { "Cherno", " hello", ", ", "world", "!\n", "StringBuilder", " " };
+static const size_t s_PieceCount = sizeof(s_Pieces) / sizeof(s_Pieces[0]);
+
+// How many pieces it takes to get to the target size, and how big the string ends up
+static size_t CountPieces(size_t& size)
+{
+	size = 0;
+	size_t count = 0;
+	while (size < s_TargetSize)
+		size += s_Pieces[count++ % s_PieceCount].size();
+	return count;
+}
+
+void RunStringBuilderBenchmarks()
+{
+	BenchmarkReport::Get().BeginSuite("String builder: 100 MB from small pieces");
+
+	size_t size;
+	size_t pieces = CountPieces(size);
+	size_t check = 0;
+
+	RunCountingBenchmark("std::string +=", pieces, [&]()
+	{
+		std::string string;
+		for (size_t i = 0; i < pieces; i++)
+			string += s_Pieces[i % s_PieceCount];
+		check = string.size();
+		DoNotOptimize(string[0]);
+	}, size, 3);
+
+	RunCountingBenchmark("std::string += with reserve", pieces, [&]()
+	{
+		std::string string;
+		string.reserve(size);
+		for (size_t i = 0; i < pieces; i++)
+			string += s_Pieces[i % s_PieceCount];
+		DoNotOptimize(string[0]);
+	}, size, 3);
+
+	RunCountingBenchmark("StringBuilder append", pieces, [&]()
+	{
+		StringBuilder builder;
+		for (size_t i = 0; i < pieces; i++)
+			builder += s_Pieces[i % s_PieceCount];
+		DoNotOptimize(builder);
+	}, size, 3);
+
+	RunCountingBenchmark("StringBuilder append + ToStdString", pieces, [&]()
+	{
+		StringBuilder builder;
+		for (size_t i = 0; i < pieces; i++)
+			builder += s_Pieces[i % s_PieceCount];
+		std::string string = builder.ToStdString();
+		DoNotOptimize(string[0]);
+	}, size, 3);
+
+	StringBuilder builder;
+	RunCountingBenchmark("StringBuilder append + ToStringClass", pieces, [&]()
+	{
+		builder.Clear();
+		for (size_t i = 0; i < pieces; i++)
+			builder += s_Pieces[i % s_PieceCount];
+		StringClass string = builder.ToStringClass();
+		DoNotOptimize(string[0]);
+	}, size, 3);
+
+	// Slicing doesn't copy, so it costs the same for any length. Materialising a slice copies just that part
+	const size_t sliceCount = 1 << 20;
+	size_t total = 0;
+	RunBenchmark("Slice of 64 characters", sliceCount, [&]()
+	{
+		for (size_t i = 0; i < sliceCount; i++)
+		{
+			StringSlice slice = builder.Slice((i * 95287) % (size - 64), 64);
+			total += slice.Size();
+			DoNotOptimize(slice);
+		}
+	});
+	RunCountingBenchmark("Slice of 64 characters + ToStringClass", sliceCount, [&]()
+	{
+		for (size_t i = 0; i < sliceCount; i++)
+		{
+			StringClass string = builder.Slice((i * 95287) % (size - 64), 64).ToStringClass();
+			DoNotOptimize(string[0]);
+		}
+	}, sliceCount * 64);
+
+	std::cout << "  " << builder.ChunkCount() << " chunks, " << (check == builder.Size() && check == size ? "same size" : "DIFFERENT SIZE!") << std::endl;
+	DoNotOptimize(total);
+}
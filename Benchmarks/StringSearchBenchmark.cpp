@@ -0,0 +1,146 @@
+#include <cstring>
+#include <string>
+#include <vector>
+
+#include "Benchmark.h"
+#include "StringClass.h"
+#include "StringSearch.h"
+
+// Searching 8 MB of text made of common words, with the pattern only at the very end, so every search reads all of it
+// std::string::find, strstr, and StringClass::Find, plus each version of the search so they can be compared. GB/s is text scanned per second
+// Length: strlen against the length scans, on the whole 8 MB and on "Cherno"
+
+static const size_t s_TextSize = 8 << 20;
+
+static const char* s_Words[] = { "the", "quick", "brown", "fox", "jumps", "over", "lazy", "dog", "and", "a", "string", "class", "with", "some", "text", "in", "it" };
+
+static std::string MakeText(const char* pattern)
+{
+	std::string text;
+	text.reserve(s_TextSize + 64);
+	uint32_t random = 12345;
+	while (text.size() < s_TextSize)
+	{
+		random = random * 1664525 + 1013904223;
+		text += s_Words[(random >> 16) % (sizeof(s_Words) / sizeof(s_Words[0]))];
+		text += ' ';
+	}
+	text += pattern;
+	return text;
+}
+
+static void RunSearches(const char* pattern)
+{
+	std::string text = MakeText(pattern);
+	StringClass stringClass(text);
+	size_t expected = text.size() - strlen(pattern);
+	size_t position = 0;
+	bool allFound = true;
+
+	BenchmarkReport::Get().BeginSuite("String search: \"" + std::string(pattern) + "\" at the end of 8 MB");
+	RunBenchmark("std::string::find", 1, [&]()
+	{
+		position = text.find(pattern);
+		DoNotOptimize(position);
+	}, text.size());
+	allFound &= position == expected;
+
+	RunBenchmark("strstr", 1, [&]()
+	{
+		position = (size_t)(strstr(text.c_str(), pattern) - text.c_str());
+		DoNotOptimize(position);
+	}, text.size());
+	allFound &= position == expected;
+
+	for (int level = (int)SimdLevel::Scalar; level <= (int)SimdLevel::Avx512; level++)
+	{
+		const StringSearchTable* table = GetStringSearch((SimdLevel)level);
+		if (!table)
+			continue;
+		RunBenchmark(std::string("Find, ") + SimdLevelName(table->Level), 1, [&]()
+		{
+			position = table->Find(text.data(), text.size(), pattern, strlen(pattern));
+			DoNotOptimize(position);
+		}, text.size());
+		allFound &= position == expected;
+	}
+
+	RunBenchmark("StringClass::Find", 1, [&]()
+	{
+		position = stringClass.Find(pattern);
+		DoNotOptimize(position);
+	}, text.size());
+	allFound &= position == expected;
+
+	std::cout << "  " << (allFound ? "All found it in the same place" : "SOME DIDN'T FIND IT!") << std::endl;
+}
+
+void RunStringSearchBenchmarks()
+{
+	RunSearches("no");
+	RunSearches("Cherno");
+	RunSearches("Cherno is searching");
+
+	std::string text = MakeText("");
+	StringClass stringClass(text);
+	BenchmarkReport::Get().BeginSuite("String search: count and split 8 MB");
+	size_t count = 0, found = 0;
+	RunBenchmark("StringClass::Count(\"the\")", 1, [&]()
+	{
+		count = stringClass.Count("the");
+		DoNotOptimize(count);
+	}, text.size());
+	RunBenchmark("std::string::find loop for \"the\"", 1, [&]()
+	{
+		found = 0;
+		for (size_t position = text.find("the"); position != std::string::npos; position = text.find("the", position + 3))
+			found++;
+		DoNotOptimize(found);
+	}, text.size());
+	std::cout << "  " << (count == found ? "Same count" : "DIFFERENT COUNT!") << std::endl;
+
+	RunBenchmark("StringClass::Split(\" \")", 1, [&]()
+	{
+		std::vector<std::string_view> words = stringClass.Split(" ");
+		DoNotOptimize(words.back());
+	}, text.size());
+
+	BenchmarkReport::Get().BeginSuite("String length");
+	size_t length = 0;
+	RunBenchmark("strlen, 8 MB", 1, [&]()
+	{
+		length = strlen(text.c_str());
+		DoNotOptimize(length);
+	}, text.size());
+	for (int level = (int)SimdLevel::Scalar; level <= (int)SimdLevel::Avx512; level++)
+	{
+		if (const StringSearchTable* table = GetStringSearch((SimdLevel)level))
+		{
+			RunBenchmark(std::string("Length, 8 MB, ") + SimdLevelName(table->Level), 1, [&]()
+			{
+				length = table->Length(text.c_str());
+				DoNotOptimize(length);
+			}, text.size());
+		}
+	}
+
+	// Through a volatile pointer, so the compiler can't work the length of the literal out at compile time
+	const char* volatile shortString = "Cherno";
+	const size_t shortCount = 1 << 20;
+	RunBenchmark("strlen, \"Cherno\"", shortCount, [&]()
+	{
+		for (size_t i = 0; i < shortCount; i++)
+		{
+			length = strlen(shortString);
+			DoNotOptimize(length);
+		}
+	});
+	RunBenchmark("StringLength, \"Cherno\"", shortCount, [&]()
+	{
+		for (size_t i = 0; i < shortCount; i++)
+		{
+			length = StringLength(shortString);
+			DoNotOptimize(length);
+		}
+	});
+}
@@ -0,0 +1,78 @@
+#include <vector>
+
+#include "Benchmark.h"
+#include "JobSystem.h"
+#include "Transform.h"
+
+// One matrix applied to 4 million vertices
+// Scalar loop: TransformPoint on one vertex at a time, like a simple for loop would
+// Vertex array: TransformVertices on a std::vector<Vertex> (x y z x y z ...)
+// Separate arrays: TransformVertices on separate x, y and z arrays, 4 vertices per instruction
+// Mops/s is millions of vertices per second
+
+static const size_t s_Count = 4 << 20;
+
+void RunTransformBenchmarks()
+{
+	size_t threads = JobSystem::Get().ThreadCount();
+	BenchmarkReport::Get().BeginSuite("Transforming 4M vertices (" + std::to_string(threads) + " threads)");
+
+	Transform transform;
+	transform.Position = Vector3(1.0f, -2.0f, 3.0f);
+	transform.Rotation = Quaternion::FromAxisAngle(Normalize(Vector3(1.0f, 2.0f, 3.0f)), 0.7f);
+	transform.Scale = Vector3(2.0f, 2.0f, 0.5f);
+	Matrix4 matrix = transform.ToMatrix();
+
+	std::vector<Vertex> vertices(s_Count), transformed(s_Count);
+	std::vector<float> x(s_Count), y(s_Count), z(s_Count), outX(s_Count), outY(s_Count), outZ(s_Count);
+	for (size_t i = 0; i < s_Count; i++)
+	{
+		vertices[i] = Vertex((float)(i % 1000) * 0.1f, (float)(i % 777) * -0.2f, (float)(i % 333) * 0.3f);
+		x[i] = vertices[i].x;
+		y[i] = vertices[i].y;
+		z[i] = vertices[i].z;
+	}
+
+	uint64_t bytes = s_Count * sizeof(Vertex) * 2;	// Read and written
+
+	RunBenchmark("scalar loop", s_Count, [&]()
+	{
+		for (size_t i = 0; i < s_Count; i++)
+		{
+			Vector3 result = TransformPoint(matrix, Vector3(vertices[i].x, vertices[i].y, vertices[i].z));
+			transformed[i] = Vertex(result.x, result.y, result.z);
+		}
+	}, bytes, 3);
+
+	RunBenchmark("vertex array, 1 thread", s_Count, [&]()
+	{
+		TransformVertices(matrix, vertices, transformed, 1);
+	}, bytes, 3);
+
+	RunBenchmark("vertex array, all threads", s_Count, [&]()
+	{
+		TransformVertices(matrix, vertices, transformed);
+	}, bytes, 3);
+
+	RunBenchmark("separate arrays, 1 thread", s_Count, [&]()
+	{
+		TransformVertices(matrix, ConstVertexSoASpan(x, y, z), VertexSoASpan(outX, outY, outZ), 1);
+	}, bytes, 3);
+
+	RunBenchmark("separate arrays, all threads", s_Count, [&]()
+	{
+		TransformVertices(matrix, ConstVertexSoASpan(x, y, z), VertexSoASpan(outX, outY, outZ));
+	}, bytes, 3);
+
+	// All of them have to give exactly the same floats
+	for (size_t i = 0; i < s_Count; i++)
+	{
+		Vector3 expected = TransformPoint(matrix, Vector3(x[i], y[i], z[i]));
+		Vertex& v = transformed[i];
+		if (v.x != expected.x || v.y != expected.y || v.z != expected.z || outX[i] != expected.x || outY[i] != expected.y || outZ[i] != expected.z)
+		{
+			std::cout << "  Results don't match at " << i << "!" << std::endl;
+			break;
+		}
+	}
+}
@@ -0,0 +1,84 @@
+#include <memory>
+#include <string>
+#include <vector>
+
+#include "Benchmark.h"
+#include "Printable.h"
+
+// How many GetClassName() calls per second we get now that it returns a std::string_view, compared to the old version that returned a std::string
+// "InheritingClass" is exactly 15 characters, which still fits in the small string buffer of MSVC and libstdc++, so the old version only paid for a copy
+// The long name doesn't fit, so the old version had to allocate on the heap for every single call
+
+class LegacyPrintable
+{
+public:
+	virtual ~LegacyPrintable() = default;
+	virtual std::string GetClassName() = 0;
+};
+
+class LegacyInheritingClass : public LegacyPrintable
+{
+public:
+	std::string GetClassName() override { return "InheritingClass"; }
+};
+
+class LegacyLongNameClass : public LegacyPrintable
+{
+public:
+	std::string GetClassName() override { return "InheritingClassWithAVeryLongName"; }
+};
+
+class LongNameClass : public BaseClass
+{
+public:
+	std::string PureVirtualMethodExample() override { return "LongNameClass"; }
+	std::string_view GetClassName() override { return "InheritingClassWithAVeryLongName"; }
+};
+
+static const size_t s_ObjectCount = 10000;
+static const int s_Passes = 100;
+
+template<typename Base>
+static void Run(const std::string& name, const std::vector<std::unique_ptr<Base>>& objects)
+{
+	RunBenchmark(name, s_ObjectCount * s_Passes, [&]()
+	{
+		size_t total = 0;
+		for (int pass = 0; pass < s_Passes; pass++)
+		{
+			for (const std::unique_ptr<Base>& obj : objects)
+				total += obj->GetClassName().size();
+		}
+		DoNotOptimize(total);
+	});
+}
+
+template<typename Base, typename T>
+static std::vector<std::unique_ptr<Base>> MakeObjects()
+{
+	std::vector<std::unique_ptr<Base>> objects;
+	for (size_t i = 0; i < s_ObjectCount; i++)
+		objects.push_back(std::make_unique<T>());
+	return objects;
+}
+
+void RunTypeNameBenchmarks()
+{
+	BenchmarkReport::Get().BeginSuite("Type names: GetClassName() calls per second");
+
+	Run("std::string (short name, old)", MakeObjects<LegacyPrintable, LegacyInheritingClass>());
+	Run("std::string_view (short name)", MakeObjects<Printable, PlainClass>());
+	Run("std::string (long name, old)", MakeObjects<LegacyPrintable, LegacyLongNameClass>());
+	Run("std::string_view (long name)", MakeObjects<Printable, LongNameClass>());
+
+	// Reading the name and hash without any call at all
+	RunBenchmark("TypeName<T>() + TypeHash<T>()", s_ObjectCount * s_Passes, [&]()
+	{
+		uint64_t total = 0;
+		for (size_t i = 0; i < s_ObjectCount * s_Passes; i++)
+		{
+			total += TypeName<InheritingClass>().size() + TypeHash<InheritingClass>();
+			DoNotOptimize(total);
+		}
+	});
+}
@@ -0,0 +1,102 @@
+#include <string>
+#include <vector>
+
+#include "Benchmark.h"
+#include "Utf.h"
+
+// Validating and converting 8 MB of UTF-8 with each version, and converting it back from UTF-16 and UTF-32. GB/s is always UTF-8 bytes per second
+// Mostly ASCII: English words with an accented letter now and then, like most source code, JSON and logs
+// Mostly CJK: Chinese characters (3 bytes each in UTF-8, 1 unit in UTF-16) with some ASCII punctuation and spaces, where the ASCII paths rarely help
+
+static const size_t s_TextSize = 8 << 20;
+
+static const char* s_AsciiWords[] = { "the", "quick", "brown", "fox", "jumps", "over", "lazy", "dog", "caf\xC3\xA9", "and", "a", "string", "with", "some", "text", "na\xC3\xAFve" };
+static const char* s_CjkWords[] = { "\xE4\xBD\xA0\xE5\xA5\xBD", "\xE4\xB8\x96\xE7\x95\x8C", "\xE5\xAD\x97\xE7\xAC\xA6\xE4\xB8\xB2", "\xE7\xBC\x96\xE7\xA0\x81", "\xE6\x96\x87\xE6\x9C\xAC", "\xE6\xB5\x8B\xE8\xAF\x95", "\xE3\x80\x82", "\xEF\xBC\x8C", "C++", "\xF0\x9F\x98\x80" };
+
+template<size_t N>
+static std::string MakeText(const char* (&words)[N])
+{
+	std::string text;
+	text.reserve(s_TextSize + 64);
+	uint32_t random = 12345;
+	while (text.size() < s_TextSize)
+	{
+		random = random * 1664525 + 1013904223;
+		text += words[(random >> 16) % N];
+		text += ' ';
+	}
+	return text;
+}
+
+static void RunConversions(const char* name, const std::string& text)
+{
+	std::vector<char16_t> utf16(text.size());
+	std::vector<char32_t> utf32(text.size());
+	size_t utf16Size = Utf8ToUtf16(Span<const char>(text.data(), text.size()), Span<char16_t>(utf16.data(), utf16.size()));
+	size_t utf32Size = Utf8ToUtf32(Span<const char>(text.data(), text.size()), Span<char32_t>(utf32.data(), utf32.size()));
+	std::vector<char> utf8(4 * utf32Size);
+	bool allSame = utf16Size != UtfInvalid && utf32Size != UtfInvalid;
+
+	BenchmarkReport::Get().BeginSuite(std::string("UTF: 8 MB, ") + name);
+	for (int level = (int)SimdLevel::Scalar; level <= (int)SimdLevel::Avx512; level++)
+	{
+		const UtfTable* table = GetUtf((SimdLevel)level);
+		if (!table)
+			continue;
+		std::string levelName = SimdLevelName(table->Level);
+
+		bool valid = false;
+		RunBenchmark("Validate UTF-8, " + levelName, 1, [&]()
+		{
+			valid = table->ValidateUtf8(text.data(), text.size());
+			DoNotOptimize(valid);
+		}, text.size());
+		allSame &= valid;
+
+		size_t written = 0;
+		RunBenchmark("UTF-8 to UTF-16, " + levelName, 1, [&]()
+		{
+			written = table->Utf8ToUtf16(text.data(), text.size(), utf16.data());
+			DoNotOptimize(written);
+		}, text.size());
+		allSame &= written == utf16Size;
+
+		RunBenchmark("UTF-8 to UTF-32, " + levelName, 1, [&]()
+		{
+			written = table->Utf8ToUtf32(text.data(), text.size(), utf32.data());
+			DoNotOptimize(written);
+		}, text.size());
+		allSame &= written == utf32Size;
+
+		RunBenchmark("UTF-16 to UTF-8, " + levelName, 1, [&]()
+		{
+			written = table->Utf16ToUtf8(utf16.data(), utf16Size, utf8.data());
+			DoNotOptimize(written);
+		}, text.size());
+		allSame &= written == text.size() && text.compare(0, text.size(), utf8.data(), written) == 0;
+
+		RunBenchmark("UTF-32 to UTF-8, " + levelName, 1, [&]()
+		{
+			written = table->Utf32ToUtf8(utf32.data(), utf32Size, utf8.data());
+			DoNotOptimize(written);
+		}, text.size());
+		allSame &= written == text.size() && text.compare(0, text.size(), utf8.data(), written) == 0;
+	}
+
+	// The whole string versions, which count the exact size first and allocate once
+	StringClass string;
+	RunBenchmark("UTF-16 to StringClass", 1, [&]()
+	{
+		allSame &= Utf16ToUtf8(std::u16string_view(utf16.data(), utf16Size), string);
+		DoNotOptimize(string);
+	}, text.size());
+	allSame &= string.View() == text;
+
+	std::cout << "  " << (allSame ? "Every version gave the same result" : "SOME VERSIONS DIFFER!") << std::endl;
+}
+
+void RunUtfBenchmarks()
+{
+	RunConversions("mostly ASCII", MakeText(s_AsciiWords));
+	RunConversions("mostly CJK", MakeText(s_CjkWords));
+}
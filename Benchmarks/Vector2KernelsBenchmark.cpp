@@ -0,0 +1,134 @@
+#include <cstring>
+#include <vector>
+
+#include "Benchmark.h"
+#include "Vector2Kernels.h"
+
+// Every Vector2 kernel at every SIMD level this CPU has, on a small array that fits in the cache and a big one that doesn't
+// The small one shows how fast the kernels can calculate. The big one shows that simple kernels like Add can't go faster than memory,
+// so compare their GB/s with the memcpy line at the top: once that is reached, a wider instruction set doesn't help any more
+
+static const size_t s_SmallCount = 2048;		// 16 KB per array
+static const size_t s_LargeCount = 8 << 20;		// 64 MB per array
+static const size_t s_SmallRepeats = 2000;
+
+// Everything the kernels read and write. a, b, c and out are x y x y arrays, the others are the same data split into x and y
+struct KernelData
+{
+	std::vector<float> A, B, C, Out;
+	std::vector<float> AX, AY, BX, BY, OutX, OutY;
+	std::vector<float> OutScalar;
+
+	explicit KernelData(size_t count)
+		: A(count * 2), B(count * 2), C(count * 2), Out(count * 2),
+		AX(count), AY(count), BX(count), BY(count), OutX(count), OutY(count), OutScalar(count)
+	{
+		for (size_t i = 0; i < count; i++)
+		{
+			// Every 100th vector is 0, to check that all versions leave those alone in Normalize
+			float x = i % 100 == 0 ? 0.0f : 1.0f + (float)(i % 13) * 0.37f;
+			float y = i % 100 == 0 ? 0.0f : -2.0f + (float)(i % 7) * 0.91f;
+			A[i * 2] = AX[i] = x;
+			A[i * 2 + 1] = AY[i] = y;
+			B[i * 2] = BX[i] = 0.5f + (float)(i % 5);
+			B[i * 2 + 1] = BY[i] = 1.25f - (float)(i % 3);
+			C[i * 2] = 3.0f;
+			C[i * 2 + 1] = -1.0f;
+		}
+	}
+};
+
+struct Kernel
+{
+	const char* Name;
+	uint64_t BytesPerVector;	// Read and written
+	void (*Run)(const Vector2KernelTable& kernels, KernelData& data, size_t count);
+};
+
+static const Kernel s_Kernels[] =
+{
+	{ "add", 24, [](const Vector2KernelTable& k, KernelData& d, size_t n) { k.Add(d.A.data(), d.B.data(), d.Out.data(), n * 2); } },
+	{ "multiply-add", 32, [](const Vector2KernelTable& k, KernelData& d, size_t n) { k.MultiplyAdd(d.A.data(), d.B.data(), d.C.data(), d.Out.data(), n * 2); } },
+	{ "scale", 16, [](const Vector2KernelTable& k, KernelData& d, size_t n) { k.Scale(d.A.data(), 1.5f, d.Out.data(), n * 2); } },
+	{ "dot (x y x y)", 20, [](const Vector2KernelTable& k, KernelData& d, size_t n) { k.DotInterleaved(d.A.data(), d.B.data(), d.OutScalar.data(), n); } },
+	{ "dot (split x, y)", 20, [](const Vector2KernelTable& k, KernelData& d, size_t n) { k.DotSplit(d.AX.data(), d.AY.data(), d.BX.data(), d.BY.data(), d.OutScalar.data(), n); } },
+	{ "length (x y x y)", 12, [](const Vector2KernelTable& k, KernelData& d, size_t n) { k.LengthInterleaved(d.A.data(), d.OutScalar.data(), n); } },
+	{ "length (split x, y)", 12, [](const Vector2KernelTable& k, KernelData& d, size_t n) { k.LengthSplit(d.AX.data(), d.AY.data(), d.OutScalar.data(), n); } },
+	{ "normalize (x y x y)", 16, [](const Vector2KernelTable& k, KernelData& d, size_t n) { k.NormalizeInterleaved(d.A.data(), d.Out.data(), n); } },
+	{ "normalize (split x, y)", 16, [](const Vector2KernelTable& k, KernelData& d, size_t n) { k.NormalizeSplit(d.AX.data(), d.AY.data(), d.OutX.data(), d.OutY.data(), n); } },
+};
+
+static std::vector<const Vector2KernelTable*> GetAvailableKernels()
+{
+	std::vector<const Vector2KernelTable*> tables;
+	for (int level = (int)SimdLevel::Scalar; level <= (int)SimdLevel::Avx512; level++)
+	{
+		if (const Vector2KernelTable* table = GetVector2Kernels((SimdLevel)level))
+			tables.push_back(table);
+	}
+	return tables;
+}
+
+// Every level has to give exactly the same floats as the scalar one
+static void CheckResults(const std::vector<const Vector2KernelTable*>& tables)
+{
+	KernelData expected(s_SmallCount + 5);	// Not a multiple of any register width, so the leftover loops run too
+	for (const Kernel& kernel : s_Kernels)
+	{
+		kernel.Run(*tables[0], expected, expected.AX.size());
+		for (size_t t = 1; t < tables.size(); t++)
+		{
+			KernelData actual = expected;	// So the outputs this kernel doesn't write are the same too
+			kernel.Run(*tables[t], actual, actual.AX.size());
+			bool same = memcmp(expected.Out.data(), actual.Out.data(), expected.Out.size() * sizeof(float)) == 0
+				&& memcmp(expected.OutX.data(), actual.OutX.data(), expected.OutX.size() * sizeof(float)) == 0
+				&& memcmp(expected.OutY.data(), actual.OutY.data(), expected.OutY.size() * sizeof(float)) == 0
+				&& memcmp(expected.OutScalar.data(), actual.OutScalar.data(), expected.OutScalar.size() * sizeof(float)) == 0;
+			if (!same)
+				std::cout << "  " << SimdLevelName(tables[t]->Level) << " " << kernel.Name << " doesn't match the scalar version!" << std::endl;
+		}
+	}
+}
+
+void RunVector2KernelsBenchmarks()
+{
+	BenchmarkReport::Get().BeginSuite(std::string("Vector2 kernels (this CPU: ") + SimdLevelName(GetCpuFeatures().BestLevel()) + ")");
+
+	std::vector<const Vector2KernelTable*> tables = GetAvailableKernels();
+	CheckResults(tables);
+
+	{
+		KernelData data(s_LargeCount);
+		RunBenchmark("memcpy 64 MB (memory bandwidth)", s_LargeCount, [&]()
+		{
+			memcpy(data.Out.data(), data.A.data(), data.A.size() * sizeof(float));
+		}, s_LargeCount * 16);
+
+		for (const Kernel& kernel : s_Kernels)
+		{
+			for (const Vector2KernelTable* table : tables)
+			{
+				RunBenchmark(std::string(SimdLevelName(table->Level)) + " " + kernel.Name + ", 8M", s_LargeCount, [&]()
+				{
+					kernel.Run(*table, data, s_LargeCount);
+				}, s_LargeCount * kernel.BytesPerVector);
+			}
+		}
+	}
+
+	KernelData data(s_SmallCount);
+	for (const Kernel& kernel : s_Kernels)
+	{
+		for (const Vector2KernelTable* table : tables)
+		{
+			RunBenchmark(std::string(SimdLevelName(table->Level)) + " " + kernel.Name + ", 2K in cache", s_SmallCount * s_SmallRepeats, [&]()
+			{
+				for (size_t i = 0; i < s_SmallRepeats; i++)
+				{
+					kernel.Run(*table, data, s_SmallCount);
+					ClobberMemory();
+				}
+			}, s_SmallCount * s_SmallRepeats * kernel.BytesPerVector);
+		}
+	}
+}
@@ -0,0 +1,96 @@
+#include <cstring>
+#include <random>
+#include <string>
+#include <vector>
+
+#include "Benchmark.h"
+#include "TypeName.h"
+#include "Vector.h"
+
+// Cost of each vector operation, one call at a time over a small array that stays in cache
+// Every result is hashed into a checksum. Build once normally and once with PR_SIMD_SCALAR defined: the checksums must be the same
+// If they are not, the SIMD version of that operation doesn't match the scalar reference
+
+static const size_t s_Count = 4096;
+static const int s_Passes = 1000;
+
+struct Checksum
+{
+	std::string Name;
+	uint64_t Value;
+};
+static std::vector<Checksum> s_Checksums;
+
+template<typename T>
+static uint64_t HashResults(const std::vector<T>& results)
+{
+	uint64_t hash = 14695981039346656037ull;
+	for (const T& result : results)
+	{
+		unsigned char bytes[sizeof(T)];
+		memcpy(bytes, &result, sizeof(T));
+		for (unsigned char byte : bytes)
+		{
+			hash ^= byte;
+			hash *= 1099511628211ull;
+		}
+	}
+	return hash;
+}
+
+template<typename V, typename F>
+static void BenchmarkOperation(const char* operation, const std::vector<V>& a, const std::vector<V>& b, F&& func)
+{
+	using Result = decltype(func(a[0], b[0]));
+	std::vector<Result> results(a.size());
+
+	std::string name = std::string(TypeName<V>()) + " " + operation;
+	RunBenchmark(name, s_Count * s_Passes, [&]()
+	{
+		for (int pass = 0; pass < s_Passes; pass++)
+		{
+			for (size_t i = 0; i < s_Count; i++)
+				results[i] = func(a[i], b[i]);
+			ClobberMemory();
+		}
+	});
+	s_Checksums.push_back({ name, HashResults(results) });
+}
+
+template<typename V, typename Make>
+static void BenchmarkVectorType(Make&& make)
+{
+	std::mt19937 random(7);
+	std::uniform_real_distribution<float> distribution(-100.0f, 100.0f);
+	std::vector<V> a, b;
+	for (size_t i = 0; i < s_Count; i++)
+	{
+		a.push_back(make(random, distribution));
+		b.push_back(make(random, distribution));
+	}
+
+	BenchmarkOperation("+", a, b, [](const V& x, const V& y) { return x + y; });
+	BenchmarkOperation("*", a, b, [](const V& x, const V& y) { return x * y; });
+	BenchmarkOperation("Dot", a, b, [](const V& x, const V& y) { return Dot(x, y); });
+	BenchmarkOperation("Length", a, b, [](const V& x, const V&) { return Length(x); });
+	BenchmarkOperation("Normalize", a, b, [](const V& x, const V&) { return Normalize(x); });
+	BenchmarkOperation("Lerp", a, b, [](const V& x, const V& y) { return Lerp(x, y, 0.25f); });
+	BenchmarkOperation("Min", a, b, [](const V& x, const V& y) { return Min(x, y); });
+	BenchmarkOperation("Max", a, b, [](const V& x, const V& y) { return Max(x, y); });
+	if constexpr (std::is_same_v<V, Vector3>)
+		BenchmarkOperation("Cross", a, b, [](const V& x, const V& y) { return Cross(x, y); });
+}
+
+void RunVectorBenchmarks()
+{
+	BenchmarkReport::Get().BeginSuite(std::string("Vector maths per operation (") + SimdBackendName() + ")");
+	s_Checksums.clear();
+
+	BenchmarkVectorType<Vector2>([](std::mt19937& r, std::uniform_real_distribution<float>& d) { return Vector2(d(r), d(r)); });
+	BenchmarkVectorType<Vector3>([](std::mt19937& r, std::uniform_real_distribution<float>& d) { return Vector3(d(r), d(r), d(r)); });
+	BenchmarkVectorType<Vector4>([](std::mt19937& r, std::uniform_real_distribution<float>& d) { return Vector4(d(r), d(r), d(r), d(r)); });
+
+	std::cout << std::endl << "  Checksums (must match a PR_SIMD_SCALAR build):" << std::endl;
+	for (const Checksum& checksum : s_Checksums)
+		std::cout << "  " << std::left << std::setw(48) << checksum.Name << std::right << std::hex << checksum.Value << std::dec << std::endl;
+}
@@ -0,0 +1,75 @@
+#include <vector>
+
+#include "Benchmark.h"
+#include "VectorExpression.h"
+
+// result = pos + speed * powerup over 10 million Vector2s
+// Temporaries: every operator makes a whole new array, like std::vector maths would without expression templates
+// Expression templates: the same code, evaluated in one loop with no temporary arrays
+// Hand-written loop: what the expression templates should turn into
+
+static const size_t s_Count = 10000000;
+
+static std::vector<Vector2> Add(const std::vector<Vector2>& a, const std::vector<Vector2>& b)
+{
+	std::vector<Vector2> result(a.size());
+	for (size_t i = 0; i < a.size(); i++)
+		result[i] = a[i] + b[i];
+	return result;
+}
+
+static std::vector<Vector2> Multiply(const std::vector<Vector2>& a, const std::vector<Vector2>& b)
+{
+	std::vector<Vector2> result(a.size());
+	for (size_t i = 0; i < a.size(); i++)
+		result[i] = a[i] * b[i];
+	return result;
+}
+
+void RunVectorExpressionBenchmarks()
+{
+	BenchmarkReport::Get().BeginSuite("Expression templates: pos + speed * powerup over 10M Vector2s");
+
+	Vector2Array pos(s_Count), speed(s_Count), powerup(s_Count), result(s_Count);
+	std::vector<Vector2> posVector(s_Count), speedVector(s_Count), powerupVector(s_Count), resultVector;
+	for (size_t i = 0; i < s_Count; i++)
+	{
+		pos[i] = posVector[i] = Vector2(4.0f + i % 7, 4.0f - i % 5);
+		speed[i] = speedVector[i] = Vector2(0.5f, 1.5f + i % 3);
+		powerup[i] = powerupVector[i] = Vector2(1.5f, 2.5f);
+	}
+
+	// Three arrays read and one written, 8 bytes each
+	uint64_t bytes = s_Count * sizeof(Vector2) * 4;
+
+	RunBenchmark("temporary arrays", s_Count, [&]()
+	{
+		resultVector = Add(posVector, Multiply(speedVector, powerupVector));
+	}, bytes, 3);
+
+	RunBenchmark("expression templates", s_Count, [&]()
+	{
+		result = pos + speed * powerup;
+	}, bytes, 3);
+
+	RunBenchmark("hand-written loop", s_Count, [&]()
+	{
+		for (size_t i = 0; i < s_Count; i++)
+			resultVector[i] = posVector[i] + speedVector[i] * powerupVector[i];
+	}, bytes, 3);
+
+	RunBenchmark("expression templates (Vector2 powerup)", s_Count, [&]()
+	{
+		result = pos + speed * Vector2(1.5f, 2.5f);
+	}, s_Count * sizeof(Vector2) * 3, 3);
+
+	// The results have to be exactly the same as the version with temporaries
+	for (size_t i = 0; i < s_Count; i++)
+	{
+		if (result[i] != resultVector[i])
+		{
+			std::cout << "  Results don't match at " << i << "!" << std::endl;
+			break;
+		}
+	}
+}
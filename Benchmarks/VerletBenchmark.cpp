@@ -0,0 +1,82 @@
+#include <string>
+#include <string_view>
+#include <vector>
+
+#include "Benchmark.h"
+#include "JobSystem.h"
+#include "TypeName.h"
+#include "VerletPhysics.h"
+
+// A 64 x 64 cloth hanging from its top row, and 8000 loose circles falling onto it, in a box
+// Determinism: the same 200 steps on 1 thread and on all threads have to end with exactly the same positions (compared as a hash of their bits)
+// Scaling: 10 steps with 1, 2, 4 ... threads. Mops/s is millions of bodies stepped per second
+
+static const float s_DeltaTime = 1.0f / 60.0f;
+
+static VerletWorld MakeScene()
+{
+	VerletWorld world(Vector2(-60.0f, -60.0f), Vector2(60.0f, 60.0f));
+
+	const int clothSize = 64;
+	const float spacing = 0.5f;
+	for (int y = 0; y < clothSize; y++)
+	{
+		for (int x = 0; x < clothSize; x++)
+		{
+			bool pinned = y == 0 && x % 8 == 0;
+			uint32_t body = world.AddBody(Vector2(-16.0f + x * spacing, 40.0f - y * spacing), 0.2f, pinned ? 0.0f : 1.0f);
+			if (x > 0)
+				world.AddConstraint(body - 1, body);
+			if (y > 0)
+				world.AddConstraint(body - clothSize, body);
+		}
+	}
+
+	for (int i = 0; i < 8000; i++)
+		world.AddBody(Vector2(-50.0f + (i % 100) * 1.0f, 45.0f + (i / 100) * 0.2f + (i % 7) * 0.01f), 0.25f + (i % 3) * 0.1f);
+	return world;
+}
+
+static uint64_t HashPositions(const VerletWorld& world)
+{
+	Span<const Vector2> positions = world.GetPositions();
+	return HashString(std::string_view(reinterpret_cast<const char*>(positions.Data()), positions.Size() * sizeof(Vector2)));
+}
+
+void RunVerletBenchmarks()
+{
+	size_t threads = JobSystem::Get().ThreadCount();
+	BenchmarkReport::Get().BeginSuite("Verlet physics: cloth and 8000 circles (" + std::to_string(threads) + " threads)");
+
+	VerletWorld world = MakeScene();
+	std::cout << "  " << world.BodyCount() << " bodies, " << world.ConstraintCount() << " constraints in " << world.ColourCount() << " colours" << std::endl;
+
+	// Determinism
+	VerletWorld single = MakeScene(), parallel = MakeScene();
+	for (int step = 0; step < 200; step++)
+	{
+		single.Step(s_DeltaTime, 1);
+		parallel.Step(s_DeltaTime);
+	}
+	uint64_t singleHash = HashPositions(single), parallelHash = HashPositions(parallel);
+	std::cout << "  After 200 steps: 1 thread " << std::hex << singleHash << ", " << threads << " threads " << parallelHash << std::dec
+		<< (singleHash == parallelHash ? " (identical)" : " (DIFFERENT!)") << std::endl;
+
+	// Scaling, starting from the settled scene
+	// Powers of 2, and then every thread, even when that isn't a power of 2
+	std::vector<size_t> counts;
+	for (size_t count = 1; count < threads; count *= 2)
+		counts.push_back(count);
+	counts.push_back(threads);
+
+	for (size_t count : counts)
+	{
+		RunBenchmark("10 steps, " + std::to_string(count) + (count == 1 ? " thread" : " threads"), world.BodyCount() * 10, [&]()
+		{
+			VerletWorld copy = single;
+			for (int step = 0; step < 10; step++)
+				copy.Step(s_DeltaTime, count);
+			DoNotOptimize(copy);
+		}, 0, 3);
+	}
+}
@@ -6,6 +6,15 @@
 // #include finds a file and pastes it into this file
 #include <iostream>     // Angular brackets tell the compiler to search include path folders    Quotes could be used for all of them
 #include "Log.h"        // Find files relative to the current file
+#include "Printable.h"
+#include "TypeRegistry.h"  // Runtime reflection
+#include "Vector.h"        // Vector maths
+#include "Vertex.h"
+#include "StringClass.h"
+#include "ScopedPtr.h"     // Owning pointers with custom deleters
+#include "RefCounted.h"    // Reference counting inside the object
+#include "LookupTables.h"  // Tables worked out at compile time
+#include "DynamicArray.h"  // A growable array that relocates with memcpy
 #include <array>        // So we can use C++ arrays
 #include <string>       // So we can use C++ strings
 #include <stdlib.h>     // Standard C library
@@ -139,53 +148,28 @@ public:
     }
 };
 
-// Virtual functions and polymorphism
-// BaseClass* baseClassObject = new BaseClass(); 
-// InheritingClass* inheritingObject = new InheritingClass("Cherno");
-// cout << baseClassObject->GetName() << endl;    // Prints "BaseClass"
-// cout << inheritingObject->GetName() << endl;    // Prints "Cherno"
-
-// However, if we create the InheritingClass object to a BaseClass pointer like this:
-// BaseClass* newBase = inheritingObject;
-// cout << newBase->GetName(); // Prints "BaseClass" eventough I am refering to an inheritingClass object. 
-
-// This is an interface
-class Printable // BaseClass and thus also InheritingClass inherit from Printable
-{
-public:
-    virtual std::string GetClassName() = 0; // This is a pure virtual function
-};
-
-class BaseClass : public Printable
-{
-public:
-    virtual std::string GetName()   // The above problem can be fixed by making this a virtual method
-    { 
-        return "BaseClass"; 
-    }
-    // Pure virtual function (Interface or abstract Method)
-    // Allows us to define a method in a base class withoug an implementation and force derived classes to create the definition
-    virtual std::string PureVirtualMethodExample() = 0;   // The '= 0;' makes it a pure virtual function
-
-    std::string GetClassName() override { return "BaseClass"; }
-};
-class InheritingClass : public BaseClass    // you can add a comma and any other classes it shoud inherit from
+// Registers our classes with the reflection system in TypeRegistry.h, so they can be created and looked at while the programme runs
+void RegisterTypes()
 {
-private:
-    std::string m_Name;
-public:
-    InheritingClass(const std::string& name)
-    {
-        m_Name = name;
-    }
-
-    std::string GetName() override  // Because this is a virtual method being overridden, we need to make it an override
-    {
-        return m_Name; 
-    }
+    TypeRegistry& registry = TypeRegistry::Get();
+    registry.Register<Car>()
+        .REFLECT_FIELD(Car, carName)
+        .REFLECT_FIELD(Car, name)
+        .REFLECT_FIELD(Car, price)
+        .REFLECT_FIELD(Car, x)
+        .REFLECT_FIELD(Car, y)
+        .REFLECT_FIELD(Car, speed);
+    registry.Register<Mercedes>()
+        .Inherits<Car>()    // Mercedes gets all the fields of Car
+        .REFLECT_FIELD(Mercedes, type);
+    registry.Register<BaseClass>();
+    registry.Register<InheritingClass>()
+        .Inherits<BaseClass>();
+    registry.Build();   // Nothing can be found until the lookup table is built
+}
 
-    std::string GetClassName() override { return "InheritingClass"; }
-};
+// Virtual functions and polymorphism -> see Printable.h
+// Dispatch.h has a few ways to avoid the virtual call when we need it to be fast
 
 void PrintThing(Printable* obj)
 {
@@ -221,52 +205,7 @@ void PrintImplicitConversion(const ImplicitConversion& e)
     // Some stuff
 }
 
-struct Vector2
-{
-    float x, y;
-
-    Vector2(float x, float y)
-        : x(x), y(y) {}
-
-    // Add function to avoid operator overloading
-    Vector2 Add(const Vector2& other) const
-    {
-        return Vector2(x + other.x, y + other.y);
-    }
-    // Add function with operator overloads
-    Vector2 operator+(const Vector2& other) const
-    {
-        //return Vector2(x + other.x, y + other.y);
-        return Add(other);
-    }
-
-
-    Vector2 Multiply(const Vector2& other) const
-    {
-        return Vector2(x * other.x, y * other.y);
-    }
-    Vector2 operator*(const Vector2& other) const
-    {
-        //return Vector2(x * other.x, y * other.y);
-        return Multiply(other);
-    }
-
-    bool operator==(const Vector2& other) const
-    {
-        return other.x == x && other.y == y;
-    }
-
-    bool operator!=(const Vector2& other) const
-    {
-        return other.x != x || other.y != y;
-    }
-};
-// Overloading the bitwise shift left operator
-std::ostream& operator<<(std::ostream& stream, const Vector2& other)
-{
-    stream << "(" << other.x << " | " << other.y << ")";
-    return stream;
-}
+// Vector2 (and Vector3 and Vector4) are in Vector.h
 
 class ThisKeywordExample
 {
@@ -283,77 +222,13 @@ public:
 };
 
 // This is a basic scoped pointer class
-class ScopedPtr
-{
-private:
-    Car* m_Ptr;
-public:
-    ScopedPtr(Car* ptr)
-        : m_Ptr(ptr)
-    {
-
-    }
-
-    ~ScopedPtr()
-    {
-        delete m_Ptr;
-    }
-};
+// ScopedPtr is in ScopedPtr.h. It works for any type, and a deleter picks how the object is got rid of (delete, delete[], free, a pool or an arena)
 
 // Copying and Copy constructors
-class StringClass
-{
-    // This is an "old-school" way of doing it
-private:
-    char* m_Buffer;
-    unsigned int m_Size;
-public:
-    StringClass(const char* string)
-    {
-        m_Size = strlen(string);
-        m_Buffer = new char[m_Size + 1];
-        memcpy(m_Buffer, string, m_Size);   // This copies our memory from string in to m_Buffer
-        m_Buffer[m_Size] = 0;   // Adding our own NULL termination character
-    }
-
-    // Our copy constructor. A copy constructor takes a reference to a variable with the same type
-    // A copy cnstructor that only initialises member variables is the default one C++ supplies us with.
-    // If we don't want to allow copying, we can make the copy constructor equal to delete;
-    StringClass(const StringClass& other)
-        :m_Size(other.m_Size)   // Because this is just an int, we can shallow copy it
-    {
-        m_Buffer = new char[m_Size + 1];    // Creating a deep copy of m_Buffer, so copying the memory contents instead of the memory address
-        memcpy(m_Buffer, other.m_Buffer, m_Size + 1);
-    }
-
-    ~StringClass()
-    {
-        delete[] m_Buffer;  // To prevent memory leaks
-    }
-
-    // Friends can access private members
-    friend std::ostream& operator<<(std::ostream& stream, const StringClass& string);
-};
-// Overloading an operator to allow us to print our string to the console
-std::ostream& operator<<(std::ostream& stream, const StringClass& string)
-{
-    stream << string.m_Buffer;  // We can access m_Buffer because this function is a friend of our String class
-    return stream;
-}
+// StringClass is in StringClass.h
 
 // Example classes and operators for std::vector
-struct Vertex
-{
-    float x, y, z;
-
-    Vertex(int x, int y, int z)
-        :x(x), y(y), z(z) {}
-};
-std::ostream& operator<<(std::ostream& stream, const Vertex& vertex)
-{
-    stream << "(" << vertex.x << " | " << vertex.y << " | " << vertex.z << ")";
-    return stream;
-}
+// Vertex is in Vertex.h
 
 template<typename T>    // typename is a template parameter. (typename and class are synonyms)
 void TemplatePrint(T input) { cout << input << endl; }  // This function is not one that "exists". Once the programme is being compiled and this function called, it gets created with the type it needs.
@@ -423,6 +298,16 @@ int main() // Application starts here. It is the entry point. Things can be retu
     Mercedes myMercedes;
     myMercedes.move(1, 2);  // There is no move() in Mercedes, but there is one in Car
 
+    // Reflection
+    // C++ can't list the fields of a class or create one from a name by itself, so TypeRegistry.h keeps that information for the types we register
+    RegisterTypes();
+    const TypeDescriptor* mercedesType = TypeRegistry::Get().Find<Mercedes>();  // Found by TypeHash<Mercedes>(), not by comparing strings
+    Car* reflectedCar = (Car*)mercedesType->Create();
+    *(unsigned int*)mercedesType->FindField("price")->Get(reflectedCar) = 80000;    // Same as reflectedCar->price = 80000;
+    for (const FieldDescriptor& field : mercedesType->Fields)
+        cout << mercedesType->Name << "::" << field.Name << " is a " << field.TypeName << endl;
+    mercedesType->Destroy(reflectedCar);
+
 
 
 
@@ -499,8 +384,10 @@ int main() // Application starts here. It is the entry point. Things can be retu
     // std::string;
     std::string cppString = "Cherno";
     cppString += " hello";  // Concatnates the two strings
+    // Doing this in a loop copies the whole string every time it runs out of room. StringBuilder (in StringBuilder.h) appends without ever copying what it already has
     cout << cppString  << " is " << cppString.size() << " characters long." << endl;
     bool contains = cppString.find("no") != std::string::npos;  // If sppString contains no. std::string::npos represents an illegal position. string.find("X") returns the posiiton of X
+    // StringClass has Find, Contains, Count and Split too. They use SIMD to check 16 or 32 characters at once, which matters for big buffers
     // If writing a function that takes in a string, make sure not to do this:
     // void PrintString(std::string name) { cout << name << endl; }
     // The above function would make a copy of the string and pass it in (So if you changed the string inside the function, the original would not be changed)
@@ -605,8 +492,9 @@ int main() // Application starts here. It is the entry point. Things can be retu
     // The "new" operator calls the C function malloc(sizeInBytes) which stands for "memory allocate"
     // In general, malloc() is not something you should use in C++
     Car* carHeapMalloc = (Car*)malloc(sizeof(Car));   // This is like: Car* carHeapMalloc = new Car(); The only difference is that "new" also calls the class' constructor, malloc() does not
+    ScopedPtr<Car, FreeDelete> carHeapMallocOwner(carHeapMalloc);   // Memory from malloc() has to be given back with free(), never delete. This calls free() at the end of the scope
     // Of course, if you use new, you need to delete it again later
-    delete heapB, carHeapMalloc;   // "delete" also calls the destructor of the function
+    delete heapB;   // "delete" also calls the destructor of the function. (delete heapB, carHeapMalloc; would only delete heapB, the comma just throws carHeapMalloc away)
     delete[] carHeap;
 
 
@@ -625,23 +513,41 @@ int main() // Application starts here. It is the entry point. Things can be retu
     // Operators are symbols we use instead of functions including, but not limited to: mathematical operators like "+", pointer operators like "&" and "->", "new" and "delete" keywords
     // Overloading means to change the behaviour of, so operator overloading is when you change how an operator works in your programme
     
-    Vector2 pos(4.0f, 4.0f);
-    Vector2 speed(0.5f, 1.5f);
-    Vector2 powerup(1.5f, 2.5f);
+    constexpr Vector2 pos(4.0f, 4.0f);        // constexpr means the compiler works the value out, nothing is calculated when the programme runs
+    constexpr Vector2 speed(0.5f, 1.5f);
+    constexpr Vector2 powerup(1.5f, 2.5f);
 
-    Vector2 result0 = pos.Add(speed.Multiply(powerup));     // This does not use operator overloading
-    Vector2 result1 = pos + speed * powerup;                // This uses operator overloading
+    constexpr Vector2 result0 = pos.Add(speed.Multiply(powerup));     // This does not use operator overloading
+    constexpr Vector2 result1 = pos + speed * powerup;                // This uses operator overloading
+    // With whole arrays of Vector2s the same line would build a temporary array for every operator. VectorExpression.h avoids that with expression templates
 
     if (result0 == result1)
         cout << result1 << endl;    // The bitwise left operator also needs to be overloaded to allow for this
     if (result0 != result1)
         cout << "Results don't match!" << endl;
 
+    // static_assert is checked by the compiler, so if this builds, all of this maths really happened at compile time
+    // (a static_assert on something that can only be worked out at runtime is a compile error)
+    static_assert(result0 == result1, "Operators and functions should give the same result");
+    static_assert(result1 == Vector2(4.75f, 7.75f), "4 + 0.5 * 1.5 and 4 + 1.5 * 2.5");
+    static_assert(Length(Vector2(3.0f, 4.0f)) == 5.0f, "Square roots work at compile time too");
+    static_assert(Normalize(Vector2(0.0f, 2.0f)) == Vector2(0.0f, 1.0f), "");
+    static_assert(Cross(Vector3(1.0f, 0.0f, 0.0f), Vector3(0.0f, 1.0f, 0.0f)) == Vector3(0.0f, 0.0f, 1.0f), "Vector3 and Vector4 skip the SIMD registers while compiling");
+    static_assert(Dot(Vector4(1.0f, 2.0f, 3.0f, 4.0f), Vector4(1.0f, 1.0f, 1.0f, 1.0f)) == 10.0f, "");
+
+    // A whole table of 256 directions, worked out by the compiler (LookupTables.h)
+    static_assert(Direction(0) == Vector2(1.0f, 0.0f), "Angle 0 points right");
+    static_assert(Direction(64) == Vector2(0.0f, 1.0f), "A quarter turn points up");
+    static_assert(Direction(AngleFromRadians(Pi)) == Vector2(-1.0f, 0.0f), "Half a turn points left");
+    static_assert(Direction((uint8_t)(uint8_t(255) + uint8_t(1))) == Direction(0), "A byte angle wraps around by itself");
+    constexpr Vector2 diagonal = Direction(32);
+    cout << "45 degrees: " << diagonal << " with a length of " << Length(diagonal) << endl;
+
 
 
 
     // Scoped pointers
-    ScopedPtr e = new Car();
+    ScopedPtr<Car> e(new Car());    // The constructor is explicit, so a raw pointer can't turn into an owner by accident
     // Once ScopedPtr goes out of scope, it will delete the pointer to the heap allocated Car object. This will also detroy the Car object.
 
     // Smart pointers (require #include <memory>)
@@ -664,6 +570,19 @@ int main() // Application starts here. It is the entry point. Things can be retu
     // This means a weak pointer can store an address to an object without keeping it alive like a shared pointer does
     // This is useful for when you have a list of object you don't care about keeping alive, but want a way ask if they are. You simply make a weak pointer and ask if it is NULL at some point
 
+    // An intrusive reference counted pointer (RefCounted.h) keeps the count inside the object, so there is no control block and a Ref is a single pointer
+    // LocalRefCounted uses a plain int instead of an atomic one, for objects that only one thread ever touches. make_shared always pays for the atomic
+    {
+        struct Garage : LocalRefCounted { int spaces = 2; };
+        Ref<Garage> garage0 = MakeRef<Garage>();
+        WeakRef<Garage> weakGarage = garage0;   // Doesn't keep it alive
+        {
+            Ref<Garage> garage1 = garage0;      // Adds 1 to the count inside the garage
+        }
+        garage0.Reset();    // The last reference, so the garage is deleted here
+        cout << "Garage still there: " << (weakGarage.Lock() ? "yes" : "no") << endl;
+    }
+
 
     // Copying
     StringClass stringClass0 = "Cherno";
@@ -675,6 +594,10 @@ int main() // Application starts here. It is the entry point. Things can be retu
     // To prevent this, we need to make a deep copy. A deep copy copies the entire object instead of only the member variables
     // This is done with a copy constructor
 
+    // Moving
+    StringClass stringClass2 = std::move(stringClass1); // std::move lets the move constructor take stringClass1's buffer instead of copying it. stringClass1 is left empty
+    // "Cherno" is short enough to be stored inside the StringClass object itself, so none of these three strings allocated any memory on the heap
+
 
 
     // std::vector
@@ -697,9 +620,27 @@ int main() // Application starts here. It is the entry point. Things can be retu
         cout << v << endl;
     }
 
-    vertices.erase(vertices.begin() + 1);   // Erases the second element
+    vertices.erase(vertices.begin() + 1);   // Erases the second element. Every element after it moves down one place, so this gets slower the longer the vector is
+    // When the order doesn't matter, UnorderedErase(vertices, 1) (in DynamicArray.h) moves the last element into the gap instead, which is the same speed for any length
+    // For elements that are added and removed all the time and need to be found again later, SlotMap (SlotMap.h) gives each one a key that keeps working
     vertices.clear();                       // Clears the entire array
 
+    // DynamicArray (DynamicArray.h) is a vector for types like Vertex that can be moved around with a memcpy. Growing is a realloc, not a copy of every element
+    // The 3 means room for 3 vertices lives inside the array itself, so there is nothing to reserve and no heap allocation until a 4th is pushed
+    DynamicArray<Vertex, 3> inlineVertices;
+    inlineVertices.PushBack(Vertex(1, 2, 3));
+    inlineVertices.EmplaceBack(4, 5, 6);
+    inlineVertices.EmplaceBack(7, 8, 9);
+    for (Vertex& v : inlineVertices)
+    {
+        cout << v << endl;
+    }
+    // Real meshes have millions of vertices and come from files. LoadObj and LoadPly (MeshLoader.h) read them straight into a DynamicArray<Vertex>:
+    // DynamicArray<Vertex> meshVertices;
+    // if (!LoadObj("bunny.obj", meshVertices)) cout << "Couldn't load bunny.obj" << endl;
+    // A mesh stored as 3 vertices per triangle has most vertices 6 times over. WeldVertices (MeshIndexing.h) keeps one of each plus an index buffer,
+    // and OptimizeVertexCache orders the triangles so the GPU can reuse vertices it has just shaded
+
 
 
     // Libraries with static linking
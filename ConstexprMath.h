@@ -0,0 +1,104 @@
+#pragma once
+
+#include <cmath>
+#include <limits>
+
+// Maths functions that also work at compile time
+// std::sqrt, std::sin and std::cos aren't constexpr (not until C++26), so a constexpr function can't call them
+// These do the same thing with plain arithmetic, which the compiler is allowed to evaluate while it compiles
+
+constexpr double Pi = 3.14159265358979323846;
+
+// True while the compiler is evaluating a constant expression (std::is_constant_evaluated() from C++20, which all our compilers already have as a builtin)
+// Lets a function use the slow constexpr version while compiling and the fast std:: or SIMD version at runtime
+constexpr bool IsConstantEvaluated()
+{
+	return __builtin_is_constant_evaluated();
+}
+
+// Correctly rounded square root, so it gives exactly the same float as std::sqrt
+// The value is first scaled into [1, 4) by powers of 4, which doesn't change any bits of the mantissa. Newton's method then only needs a few steps in double,
+// and rounding that to float is exact: a double has more than twice the bits of a float, so no float square root can land close enough to halfway between two floats to be rounded the wrong way
+constexpr float ConstexprSqrt(float value)
+{
+	if (value != value || value == 0.0f || value == std::numeric_limits<float>::infinity())
+		return value;	// NaN, +-0 and infinity are their own square root
+	if (value < 0.0f)
+		return std::numeric_limits<float>::quiet_NaN();
+
+	double scaled = value;
+	double scale = 1.0;
+	while (scaled >= 4.0)
+	{
+		scaled *= 0.25;
+		scale *= 2.0;
+	}
+	while (scaled < 1.0)
+	{
+		scaled *= 4.0;
+		scale *= 0.5;
+	}
+
+	// Starting above the answer, each step gets closer from above until it stops moving
+	double guess = 2.0;
+	for (int i = 0; i < 16; i++)
+	{
+		double next = 0.5 * (guess + scaled / guess);
+		if (next >= guess)
+			break;
+		guess = next;
+	}
+	return (float)(guess * scale);
+}
+
+// std::sqrt at runtime, ConstexprSqrt while compiling. Both give the same float
+constexpr float Sqrt(float value)
+{
+	if (IsConstantEvaluated())
+		return ConstexprSqrt(value);
+	return std::sqrt(value);
+}
+
+// Sine and cosine as Taylor series, after moving the angle into [-Pi/4, Pi/4] where the series converges fastest
+// Accurate to about 1e-15 for the angles lookup tables use, which is far more than a float keeps
+constexpr double ConstexprSinReduced(double x)
+{
+	double term = x, sum = x, squared = x * x;
+	for (int n = 1; n < 12; n++)
+	{
+		term *= -squared / ((2 * n) * (2 * n + 1));
+		sum += term;
+	}
+	return sum;
+}
+
+constexpr double ConstexprCosReduced(double x)
+{
+	double term = 1.0, sum = 1.0, squared = x * x;
+	for (int n = 1; n < 12; n++)
+	{
+		term *= -squared / ((2 * n - 1) * (2 * n));
+		sum += term;
+	}
+	return sum;
+}
+
+// offset is in quarter turns: cos(x) is sin(x + Pi/2), so ConstexprCos uses an offset of 1 instead of adding Pi/2 and losing precision
+constexpr double ConstexprSinQuarters(double radians, long long offset)
+{
+	// Which quarter turn we are closest to, and how far away from it
+	double quarters = radians / (Pi / 2);
+	long long quarter = (long long)(quarters < 0.0 ? quarters - 0.5 : quarters + 0.5);
+	double x = radians - (double)quarter * (Pi / 2);
+
+	switch ((((quarter + offset) % 4) + 4) % 4)
+	{
+	case 0: return ConstexprSinReduced(x);
+	case 1: return ConstexprCosReduced(x);
+	case 2: return -ConstexprSinReduced(x);
+	default: return -ConstexprCosReduced(x);
+	}
+}
+
+constexpr double ConstexprSin(double radians) { return ConstexprSinQuarters(radians, 0); }
+constexpr double ConstexprCos(double radians) { return ConstexprSinQuarters(radians, 1); }
@@ -0,0 +1,112 @@
+#pragma once
+
+// Asks the CPU which instruction set extensions it has, so we can pick the fastest version of a function while the programme runs
+// The same .exe can then use AVX-512 on a new CPU and still work on an old one that only has SSE2
+
+#if defined(_M_X64) || defined(_M_IX86) || defined(__x86_64__) || defined(__i386__)
+	#define PR_X86
+	#if defined(_MSC_VER)
+		#include <intrin.h>
+	#else
+		#include <cpuid.h>
+	#endif
+#endif
+
+#include <cstdint>
+
+// Ordered from slowest to fastest, so they can be compared with < and >
+enum class SimdLevel
+{
+	Scalar = 0, Sse2, Sse42, Avx2, Avx512
+};
+
+inline const char* SimdLevelName(SimdLevel level)
+{
+	switch (level)
+	{
+	case SimdLevel::Sse2: return "SSE2";
+	case SimdLevel::Sse42: return "SSE4.2";
+	case SimdLevel::Avx2: return "AVX2";
+	case SimdLevel::Avx512: return "AVX-512";
+	default: return "Scalar";
+	}
+}
+
+struct CpuFeatures
+{
+	bool Sse2 = false;
+	bool Sse42 = false;
+	bool Avx2 = false;		// Also means FMA is there
+	bool Avx512 = false;	// AVX-512 F and BW
+
+	SimdLevel BestLevel() const
+	{
+		if (Avx512) return SimdLevel::Avx512;
+		if (Avx2) return SimdLevel::Avx2;
+		if (Sse42) return SimdLevel::Sse42;
+		if (Sse2) return SimdLevel::Sse2;
+		return SimdLevel::Scalar;
+	}
+
+	bool Supports(SimdLevel level) const { return level <= BestLevel(); }
+};
+
+#if defined(PR_X86)
+// cpuid fills in 4 registers with information about the CPU. leaf and subleaf pick which information we want
+inline void Cpuid(uint32_t leaf, uint32_t subleaf, uint32_t registers[4])
+{
+#if defined(_MSC_VER)
+	int values[4];
+	__cpuidex(values, (int)leaf, (int)subleaf);
+	for (int i = 0; i < 4; i++)
+		registers[i] = (uint32_t)values[i];
+#else
+	__cpuid_count(leaf, subleaf, registers[0], registers[1], registers[2], registers[3]);
+#endif
+}
+
+// Which registers the operating system saves when switching threads. A CPU can have AVX while the OS doesn't support it
+inline uint64_t ReadXcr0()
+{
+#if defined(_MSC_VER)
+	return _xgetbv(0);
+#else
+	uint32_t low, high;
+	__asm__("xgetbv" : "=a"(low), "=d"(high) : "c"(0));
+	return ((uint64_t)high << 32) | low;
+#endif
+}
+#endif
+
+// Only asks the CPU once, the first time it is called
+inline const CpuFeatures& GetCpuFeatures()
+{
+	static const CpuFeatures s_Features = []()
+	{
+		CpuFeatures features;
+#if defined(PR_X86)
+		uint32_t registers[4];	// eax, ebx, ecx, edx
+		Cpuid(0, 0, registers);
+		uint32_t maxLeaf = registers[0];
+
+		Cpuid(1, 0, registers);
+		features.Sse2 = (registers[3] & (1u << 26)) != 0;
+		features.Sse42 = (registers[2] & (1u << 20)) != 0;
+		bool osSavesRegisters = (registers[2] & (1u << 27)) != 0;	// OSXSAVE
+		bool fma = (registers[2] & (1u << 12)) != 0;
+
+		if (osSavesRegisters && maxLeaf >= 7)
+		{
+			uint64_t xcr0 = ReadXcr0();
+			bool osAvx = (xcr0 & 0x6) == 0x6;		// SSE and AVX registers
+			bool osAvx512 = (xcr0 & 0xe6) == 0xe6;	// And the AVX-512 mask and upper registers
+
+			Cpuid(7, 0, registers);
+			features.Avx2 = osAvx && fma && (registers[1] & (1u << 5)) != 0;
+			features.Avx512 = osAvx512 && features.Avx2 && (registers[1] & (1u << 16)) != 0 && (registers[1] & (1u << 30)) != 0;
+		}
+#endif
+		return features;
+	}();
+	return s_Features;
+}
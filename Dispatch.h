@@ -0,0 +1,104 @@
+#pragma once
+
+#include <string>
+#include <string_view>
+#include <type_traits>
+#include <variant>
+
+#include "Printable.h"
+
+// Every call through a Printable* is an indirect call: load the vtable pointer from the object, load the function pointer from the vtable, then jump to it
+// The compiler cannot inline it because it does not know which function it will end up in. Below are three ways to get rid of some or all of that work
+
+// 1: std::variant (requires C++17)
+// If we know every type up front (a closed set), we can store the objects by value and let std::visit pick the right function with a switch on the index
+// Qualifying the call with the class name (o.T::GetClassName()) skips the vtable entirely, so the call can be inlined
+using PrintableVariant = std::variant<PlainClass, InheritingClass>;
+
+inline std::string_view GetClassName(PrintableVariant& object)
+{
+	return std::visit([](auto& o)
+	{
+		using T = std::decay_t<decltype(o)>;
+		return o.T::GetClassName();
+	}, object);
+}
+
+inline std::string_view GetName(PrintableVariant& object)
+{
+	return std::visit([](auto& o)
+	{
+		using T = std::decay_t<decltype(o)>;
+		return o.T::GetName();
+	}, object);
+}
+
+// 2: CRTP (Curiously Recurring Template Pattern)
+// The base class is a template that gets the derived class as its parameter, so it can static_cast itself to the derived type and call its methods directly
+// Everything is decided at compile time. The downside is that StaticPrintable<A> and StaticPrintable<B> are unrelated types, so they cannot go in the same container
+template<typename Derived>
+class StaticPrintable
+{
+public:
+	std::string_view GetClassName() { return static_cast<Derived*>(this)->GetClassNameImpl(); }
+	std::string_view GetName() { return static_cast<Derived*>(this)->GetNameImpl(); }
+
+	// Defaults a derived class can hide with its own version, like a virtual method that was not overridden
+	std::string_view GetClassNameImpl() { return TypeName<BaseClass>(); }
+	std::string_view GetNameImpl() { return TypeName<BaseClass>(); }
+};
+
+class StaticPlainClass : public StaticPrintable<StaticPlainClass>
+{
+};
+
+class StaticInheritingClass : public StaticPrintable<StaticInheritingClass>
+{
+private:
+	std::string m_Name;
+public:
+	StaticInheritingClass(const std::string& name)
+		: m_Name(name) {}
+
+	std::string_view GetClassNameImpl() { return TypeName<InheritingClass>(); }
+	std::string_view GetNameImpl() { return m_Name; }
+};
+
+template<typename T>
+std::string_view PrintThingStatic(StaticPrintable<T>& obj)
+{
+	return obj.GetClassName();
+}
+
+// 3: A manual function pointer table
+// This is what the compiler does for us with virtual functions, but the table pointer is kept next to the object pointer instead of inside the object
+// That saves one dependent load per call, and the objects themselves don't need a vtable at all
+struct PrintableTable
+{
+	std::string_view (*GetClassName)(void* object);
+	std::string_view (*GetName)(void* object);
+};
+
+template<typename T>
+std::string_view CallGetClassName(void* object) { return static_cast<T*>(object)->T::GetClassName(); }
+template<typename T>
+std::string_view CallGetName(void* object) { return static_cast<T*>(object)->T::GetName(); }
+
+// One table per type, created at compile time
+template<typename T>
+inline constexpr PrintableTable s_PrintableTable = { &CallGetClassName<T>, &CallGetName<T> };
+
+// A "fat pointer": the object and the table that knows how to use it. It does not own the object
+class PrintableRef
+{
+private:
+	void* m_Object;
+	const PrintableTable* m_Table;
+public:
+	template<typename T, typename = std::enable_if_t<!std::is_same_v<T, PrintableRef>>>	// Without this, copying a non-const PrintableRef would pick this constructor
+	PrintableRef(T& object)
+		: m_Object(&object), m_Table(&s_PrintableTable<T>) {}
+
+	std::string_view GetClassName() const { return m_Table->GetClassName(m_Object); }
+	std::string_view GetName() const { return m_Table->GetName(m_Object); }
+};
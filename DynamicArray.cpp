@@ -0,0 +1,106 @@
+#include "DynamicArray.h"
+
+#include <cstdlib>
+
+#if defined(__linux__)
+#include <sys/mman.h>
+#include <unistd.h>
+#endif
+
+namespace ArrayMemory
+{
+#if defined(__linux__)
+	// Arrays this big get whole pages from the OS, so growing them can move the pages with mremap (the kernel just changes where they are mapped)
+	// instead of copying every byte. Smaller ones come from malloc, which is faster for them
+	// Whether a block is mapped only depends on its size, so Reallocate and Free know what they were given without having to store it
+	static const size_t s_MapThreshold = 1 << 20;
+
+	static bool IsMapped(size_t bytes)
+	{
+		return bytes >= s_MapThreshold;
+	}
+
+	static size_t PageRound(size_t bytes)
+	{
+		static const size_t pageSize = (size_t)sysconf(_SC_PAGESIZE);
+		return (bytes + pageSize - 1) & ~(pageSize - 1);
+	}
+
+	static void* Map(size_t bytes)
+	{
+		void* memory = mmap(nullptr, PageRound(bytes), PROT_READ | PROT_WRITE, MAP_PRIVATE | MAP_ANONYMOUS, -1, 0);
+		if (memory == MAP_FAILED)
+			throw std::bad_alloc();
+		return memory;
+	}
+
+	static void* Heap(size_t bytes)
+	{
+		void* memory = malloc(bytes);
+		if (!memory)
+			throw std::bad_alloc();
+		return memory;
+	}
+
+	void* Allocate(size_t bytes)
+	{
+		return IsMapped(bytes) ? Map(bytes) : Heap(bytes);
+	}
+
+	void* Reallocate(void* memory, size_t oldBytes, size_t newBytes)
+	{
+		bool wasMapped = IsMapped(oldBytes);
+		bool mapped = IsMapped(newBytes);
+		if (wasMapped && mapped)
+		{
+			void* moved = mremap(memory, PageRound(oldBytes), PageRound(newBytes), MREMAP_MAYMOVE);
+			if (moved == MAP_FAILED)
+				throw std::bad_alloc();
+			return moved;
+		}
+		if (!wasMapped && !mapped)
+		{
+			void* moved = realloc(memory, newBytes);
+			if (!moved)
+				throw std::bad_alloc();
+			return moved;
+		}
+
+		// Crossing the threshold, one way or the other
+		void* moved = Allocate(newBytes);
+		memcpy(moved, memory, oldBytes < newBytes ? oldBytes : newBytes);
+		Free(memory, oldBytes);
+		return moved;
+	}
+
+	void Free(void* memory, size_t bytes)
+	{
+		if (IsMapped(bytes))
+			munmap(memory, PageRound(bytes));
+		else
+			free(memory);
+	}
+#else
+	// Everywhere else it is all malloc. realloc still grows a block where it is when there is room after it
+	void* Allocate(size_t bytes)
+	{
+		void* memory = malloc(bytes);
+		if (!memory)
+			throw std::bad_alloc();
+		return memory;
+	}
+
+	void* Reallocate(void* memory, size_t oldBytes, size_t newBytes)
+	{
+		void* moved = realloc(memory, newBytes);
+		if (!moved)
+			throw std::bad_alloc();
+		return moved;
+	}
+
+	void Free(void* memory, size_t bytes)
+	{
+		free(memory);
+	}
+#endif
+}
@@ -0,0 +1,371 @@
+#pragma once
+
+#include <algorithm>
+#include <cstddef>
+#include <cstring>
+#include <initializer_list>
+#include <new>
+#include <ratio>
+#include <type_traits>
+#include <utility>
+
+#include "Span.h"
+
+// A growable array like std::vector, for types that can be moved around in memory with a plain memcpy (Vertex, and most simple structs)
+// When std::vector grows it allocates a new buffer, constructs every element again in it and destroys the old ones, even when all of that amounts to copying bytes
+// Here growing a trivially relocatable array is a realloc, which can often grow the buffer where it is, and for big arrays (1 MB and more) on Linux
+// the pages are moved with mremap instead of copying them at all
+//
+// InlineCapacity elements live inside the array itself, so small arrays (like the 3 vertices in main) never allocate, and don't need a reserve() either
+// Growth is how much bigger the buffer gets each time it is full, as a std::ratio. 3/2 wastes less memory than 2, 2 reallocates less often
+// ResizeUninitialized() makes room without constructing anything, for filling the elements in bulk afterwards (from a file, or a memcpy)
+//
+// Other types still work, they are moved one by one like std::vector does
+
+// True when an object can be moved to another address by copying its bytes, and the old bytes simply forgotten about
+// That is every trivially copyable type. Types that own memory but never point into themselves (StringClass, ScopedPtr, Ref) are too, and can say so with:
+//   template<> struct IsTriviallyRelocatable<MyType> : std::true_type {};
+template<typename T>
+struct IsTriviallyRelocatable : std::bool_constant<std::is_trivially_copyable_v<T>> {};
+
+// Where the elements live when they don't fit inline. Raw bytes, sizes in bytes. In DynamicArray.cpp
+namespace ArrayMemory
+{
+	void* Allocate(size_t bytes);
+	// Only for memory that holds trivially relocatable elements (or none). Keeps the first min(oldBytes, newBytes) bytes
+	void* Reallocate(void* memory, size_t oldBytes, size_t newBytes);
+	void Free(void* memory, size_t bytes);
+}
+
+namespace Detail
+{
+	template<typename T, size_t Capacity>
+	class InlineBuffer
+	{
+	private:
+		alignas(T) unsigned char m_Storage[Capacity * sizeof(T)];
+	protected:
+		T* InlineData() { return reinterpret_cast<T*>(m_Storage); }
+		const T* InlineData() const { return reinterpret_cast<const T*>(m_Storage); }
+	};
+
+	// No inline elements: takes up no space at all, because it is an empty base class
+	template<typename T>
+	class InlineBuffer<T, 0>
+	{
+	protected:
+		T* InlineData() { return nullptr; }
+		const T* InlineData() const { return nullptr; }
+	};
+}
+
+template<typename T, size_t InlineCapacity = 0, typename Growth = std::ratio<3, 2>>
+class DynamicArray : private Detail::InlineBuffer<T, InlineCapacity>
+{
+private:
+	static_assert(Growth::num > Growth::den, "The array has to get bigger when it grows");
+	static_assert(alignof(T) <= alignof(std::max_align_t), "The heap memory is only aligned for normal types");
+
+	static constexpr bool s_Relocatable = IsTriviallyRelocatable<T>::value;
+
+	T* m_Data = this->InlineData();
+	size_t m_Size = 0;
+	size_t m_Capacity = InlineCapacity;
+
+	bool OnHeap() const { return m_Data != this->InlineData(); }
+
+	// Moves the elements into a buffer with room for capacity of them (which may be the inline one)
+	void Reallocate(size_t capacity)
+	{
+		bool toInline = capacity <= InlineCapacity;
+		if (toInline)
+			capacity = InlineCapacity;
+
+		if constexpr (s_Relocatable)
+		{
+			if (OnHeap() && !toInline)
+			{
+				m_Data = static_cast<T*>(ArrayMemory::Reallocate(m_Data, m_Capacity * sizeof(T), capacity * sizeof(T)));
+				m_Capacity = capacity;
+				return;
+			}
+		}
+
+		T* data = toInline ? this->InlineData() : static_cast<T*>(ArrayMemory::Allocate(capacity * sizeof(T)));
+		if (data == m_Data)
+			return;
+		Relocate(m_Data, m_Size, data);
+		if (OnHeap())
+			ArrayMemory::Free(m_Data, m_Capacity * sizeof(T));
+		m_Data = data;
+		m_Capacity = capacity;
+	}
+
+	// Moves count elements from source to the uninitialised memory at destination. The source elements are gone afterwards
+	static void Relocate(T* source, size_t count, T* destination)
+	{
+		if constexpr (s_Relocatable)
+		{
+			if (count > 0)
+				memcpy(static_cast<void*>(destination), source, count * sizeof(T));
+		}
+		else
+		{
+			for (size_t i = 0; i < count; i++)
+			{
+				new (destination + i) T(std::move_if_noexcept(source[i]));
+				source[i].~T();
+			}
+		}
+	}
+
+	void Grow(size_t needed)
+	{
+		size_t grown = m_Capacity * Growth::num / Growth::den;
+		Reallocate(std::max<size_t>({ needed, grown, 4 }));
+	}
+
+	void DestroyRange(size_t begin, size_t end)
+	{
+		if constexpr (!std::is_trivially_destructible_v<T>)
+		{
+			for (size_t i = begin; i < end; i++)
+				m_Data[i].~T();
+		}
+	}
+
+	// Constructs the element before growing, since the arguments may refer to an element that growing is about to move
+	template<typename... Args>
+	T& EmplaceBackSlow(Args&&... arguments)
+	{
+		T value(std::forward<Args>(arguments)...);
+		Grow(m_Size + 1);
+		return *new (m_Data + m_Size++) T(std::move(value));
+	}
+
+	void TakeFrom(DynamicArray& other)
+	{
+		if (other.OnHeap())
+		{
+			m_Data = other.m_Data;
+			m_Capacity = other.m_Capacity;
+			m_Size = other.m_Size;
+			other.m_Data = other.InlineData();
+			other.m_Capacity = InlineCapacity;
+		}
+		else if constexpr (InlineCapacity > 0)
+		{
+			Relocate(other.m_Data, other.m_Size, m_Data);
+			m_Size = other.m_Size;
+		}
+		other.m_Size = 0;
+	}
+public:
+	DynamicArray() = default;
+
+	explicit DynamicArray(size_t size) { Resize(size); }
+	DynamicArray(size_t size, const T& value) { Resize(size, value); }
+
+	DynamicArray(std::initializer_list<T> values)
+	{
+		Reserve(values.size());
+		for (const T& value : values)
+			new (m_Data + m_Size++) T(value);
+	}
+
+	DynamicArray(const DynamicArray& other)
+	{
+		Reserve(other.m_Size);
+		if constexpr (std::is_trivially_copyable_v<T>)
+		{
+			if (other.m_Size > 0)
+				memcpy(static_cast<void*>(m_Data), other.m_Data, other.m_Size * sizeof(T));
+			m_Size = other.m_Size;
+		}
+		else
+		{
+			for (const T& value : other)
+				new (m_Data + m_Size++) T(value);
+		}
+	}
+
+	DynamicArray(DynamicArray&& other) noexcept(s_Relocatable || std::is_nothrow_move_constructible_v<T>)
+	{
+		TakeFrom(other);
+	}
+
+	DynamicArray& operator=(const DynamicArray& other)
+	{
+		if (this != &other)
+		{
+			DynamicArray copy(other);
+			*this = std::move(copy);
+		}
+		return *this;
+	}
+
+	DynamicArray& operator=(DynamicArray&& other) noexcept(s_Relocatable || std::is_nothrow_move_constructible_v<T>)
+	{
+		if (this != &other)
+		{
+			// If other's elements are inline they fit in our inline buffer too, so our heap memory is never needed
+			Clear();
+			if (OnHeap())
+			{
+				ArrayMemory::Free(m_Data, m_Capacity * sizeof(T));
+				m_Data = this->InlineData();
+				m_Capacity = InlineCapacity;
+			}
+			TakeFrom(other);
+		}
+		return *this;
+	}
+
+	~DynamicArray()
+	{
+		DestroyRange(0, m_Size);
+		if (OnHeap())
+			ArrayMemory::Free(m_Data, m_Capacity * sizeof(T));
+	}
+
+	T* Data() { return m_Data; }
+	const T* Data() const { return m_Data; }
+	size_t Size() const { return m_Size; }
+	size_t Capacity() const { return m_Capacity; }
+	bool Empty() const { return m_Size == 0; }
+	bool IsInline() const { return !OnHeap(); }
+
+	T& operator[](size_t index) { return m_Data[index]; }
+	const T& operator[](size_t index) const { return m_Data[index]; }
+	T& Front() { return m_Data[0]; }
+	const T& Front() const { return m_Data[0]; }
+	T& Back() { return m_Data[m_Size - 1]; }
+	const T& Back() const { return m_Data[m_Size - 1]; }
+
+	T* begin() { return m_Data; }
+	T* end() { return m_Data + m_Size; }
+	const T* begin() const { return m_Data; }
+	const T* end() const { return m_Data + m_Size; }
+
+	operator Span<T>() { return Span<T>(m_Data, m_Size); }
+	operator Span<const T>() const { return Span<const T>(m_Data, m_Size); }
+
+	// The fast path is small enough to be inlined everywhere it is used. Growing is not
+	template<typename... Args>
+	T& EmplaceBack(Args&&... arguments)
+	{
+		if (m_Size < m_Capacity)
+			return *new (m_Data + m_Size++) T(std::forward<Args>(arguments)...);
+		return EmplaceBackSlow(std::forward<Args>(arguments)...);
+	}
+
+	void PushBack(const T& value) { EmplaceBack(value); }
+	void PushBack(T&& value) { EmplaceBack(std::move(value)); }
+
+	void PopBack()
+	{
+		m_Size--;
+		m_Data[m_Size].~T();
+	}
+
+	// Erases the element at index and moves every later one down, keeping their order. O(n), like std::vector::erase
+	void Erase(size_t index)
+	{
+		m_Data[index].~T();
+		if constexpr (s_Relocatable)
+			memmove(static_cast<void*>(m_Data + index), m_Data + index + 1, (m_Size - index - 1) * sizeof(T));
+		else
+		{
+			for (size_t i = index; i + 1 < m_Size; i++)
+			{
+				new (m_Data + i) T(std::move(m_Data[i + 1]));
+				m_Data[i + 1].~T();
+			}
+		}
+		m_Size--;
+	}
+
+	// Erases the element at index by moving the last one into its place. O(1), but the order of the elements changes
+	void UnorderedErase(size_t index)
+	{
+		m_Size--;
+		if (index != m_Size)
+		{
+			if constexpr (s_Relocatable)
+			{
+				m_Data[index].~T();
+				memcpy(static_cast<void*>(m_Data + index), m_Data + m_Size, sizeof(T));
+				return;
+			}
+			else
+				m_Data[index] = std::move(m_Data[m_Size]);
+		}
+		m_Data[m_Size].~T();
+	}
+
+	void Reserve(size_t capacity)
+	{
+		if (capacity > m_Capacity)
+			Reallocate(capacity);
+	}
+
+	// New elements are value initialised (Vertex() for Vertex, 0 for numbers)
+	void Resize(size_t size)
+	{
+		Reserve(size);
+		for (size_t i = m_Size; i < size; i++)
+			new (m_Data + i) T();
+		DestroyRange(size, m_Size);
+		m_Size = size;
+	}
+
+	void Resize(size_t size, const T& value)
+	{
+		if (size > m_Capacity)
+		{
+			T copy(value);	// value may be one of our own elements
+			Reserve(size);
+			for (size_t i = m_Size; i < size; i++)
+				new (m_Data + i) T(copy);
+		}
+		else
+		{
+			for (size_t i = m_Size; i < size; i++)
+				new (m_Data + i) T(value);
+		}
+		DestroyRange(size, m_Size);
+		m_Size = size;
+	}
+
+	// New elements are left as whatever bytes were in memory, and must be written before they are read
+	// Only for types that are just bytes, so nothing goes wrong when their constructor is skipped
+	void ResizeUninitialized(size_t size)
+	{
+		static_assert(std::is_trivially_copyable_v<T> && std::is_trivially_destructible_v<T>, "Only types that are just bytes can be left uninitialised");
+		Reserve(size);
+		m_Size = size;
+	}
+
+	// Destroys the elements but keeps the memory
+	void Clear()
+	{
+		DestroyRange(0, m_Size);
+		m_Size = 0;
+	}
+
+	// Gives back the memory that isn't used, moving the elements inline if they fit
+	void ShrinkToFit()
+	{
+		if (OnHeap() && m_Size < m_Capacity)
+			Reallocate(m_Size);
+	}
+};
+
+// The same swap and pop for std::vector (or anything with back() and pop_back()): moves the last element into index instead of shifting every later one down
+template<typename Vector>
+void UnorderedErase(Vector& vector, size_t index)
+{
+	if (index + 1 != vector.size())
+		vector[index] = std::move(vector.back());
+	vector.pop_back();
+}
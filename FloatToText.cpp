@@ -0,0 +1,424 @@
+#include "FloatToText.h"
+
+#include <cstdint>
+#include <cstring>
+
+// Ryu, following the reference implementation (https://github.com/ulfjack/ryu, f2s.c)
+// A float is m * 2^e. The floats just above and below it are a tiny bit away, and every decimal number closer to m * 2^e than to them reads back as the same float
+// Ryu works out that range of decimals with 64-bit multiplications by precomputed powers of 5, then removes digits while both ends of the range still agree
+// What is left is the shortest decimal in the range, rounded to the one closest to the real value
+
+static const int s_FloatMantissaBits = 23;
+static const int s_FloatBias = 127;
+static const int s_Pow5InverseBitCount = 59;
+static const int s_Pow5BitCount = 61;
+
+// 2^(59 + ceil(log2(5^i)) - 1) / 5^i, rounded up
+static const uint64_t s_Pow5InverseSplit[31] =
+{
+	576460752303423489ull, 461168601842738791ull, 368934881474191033ull, 295147905179352826ull,
+	472236648286964522ull, 377789318629571618ull, 302231454903657294ull, 483570327845851670ull,
+	386856262276681336ull, 309485009821345069ull, 495176015714152110ull, 396140812571321688ull,
+	316912650057057351ull, 507060240091291761ull, 405648192073033409ull, 324518553658426727ull,
+	519229685853482763ull, 415383748682786211ull, 332306998946228969ull, 531691198313966350ull,
+	425352958651173080ull, 340282366920938464ull, 544451787073501542ull, 435561429658801234ull,
+	348449143727040987ull, 557518629963265579ull, 446014903970612463ull, 356811923176489971ull,
+	570899077082383953ull, 456719261665907162ull, 365375409332725730ull,
+};
+
+// The top 61 bits of 5^i
+static const uint64_t s_Pow5Split[47] =
+{
+	1152921504606846976ull, 1441151880758558720ull, 1801439850948198400ull, 2251799813685248000ull,
+	1407374883553280000ull, 1759218604441600000ull, 2199023255552000000ull, 1374389534720000000ull,
+	1717986918400000000ull, 2147483648000000000ull, 1342177280000000000ull, 1677721600000000000ull,
+	2097152000000000000ull, 1310720000000000000ull, 1638400000000000000ull, 2048000000000000000ull,
+	1280000000000000000ull, 1600000000000000000ull, 2000000000000000000ull, 1250000000000000000ull,
+	1562500000000000000ull, 1953125000000000000ull, 1220703125000000000ull, 1525878906250000000ull,
+	1907348632812500000ull, 1192092895507812500ull, 1490116119384765625ull, 1862645149230957031ull,
+	1164153218269348144ull, 1455191522836685180ull, 1818989403545856475ull, 2273736754432320594ull,
+	1421085471520200371ull, 1776356839400250464ull, 2220446049250313080ull, 1387778780781445675ull,
+	1734723475976807094ull, 2168404344971008868ull, 1355252715606880542ull, 1694065894508600678ull,
+	2117582368135750847ull, 1323488980084844279ull, 1654361225106055349ull, 2067951531382569187ull,
+	1292469707114105741ull, 1615587133892632177ull, 2019483917365790221ull,
+};
+
+// "00" to "99", so two digits can be written at once
+static const char s_DigitPairs[201] =
+	"00010203040506070809101112131415161718192021222324252627282930313233343536373839"
+	"40414243444546474849505152535455565758596061626364656667686970717273747576777879"
+	"8081828384858687888990919293949596979899";
+
+// ceil(log2(5^e)), log10(2^e) and log10(5^e), rounded down, without floating point maths
+static int Pow5Bits(int e) { return (int)(((uint32_t)e * 1217359) >> 19) + 1; }
+static uint32_t Log10Pow2(int e) { return ((uint32_t)e * 78913) >> 18; }
+static uint32_t Log10Pow5(int e) { return ((uint32_t)e * 732923) >> 20; }
+
+static uint32_t Pow5Factor(uint32_t value)
+{
+	uint32_t count = 0;
+	while (value % 5 == 0)
+	{
+		value /= 5;
+		count++;
+	}
+	return count;
+}
+
+static bool MultipleOfPowerOf5(uint32_t value, uint32_t power) { return Pow5Factor(value) >= power; }
+static bool MultipleOfPowerOf2(uint32_t value, uint32_t power) { return (value & ((1u << power) - 1)) == 0; }
+
+// (m * factor) >> shift, where the full product needs 96 bits
+static uint32_t MultiplyShift(uint32_t m, uint64_t factor, int shift)
+{
+	uint64_t low = (uint64_t)m * (uint32_t)factor;
+	uint64_t high = (uint64_t)m * (uint32_t)(factor >> 32);
+	uint64_t sum = (low >> 32) + high;
+	return (uint32_t)(sum >> (shift - 32));
+}
+
+static uint32_t MultiplyPow5InverseDivPow2(uint32_t m, uint32_t q, int j) { return MultiplyShift(m, s_Pow5InverseSplit[q], j); }
+static uint32_t MultiplyPow5DivPow2(uint32_t m, uint32_t i, int j) { return MultiplyShift(m, s_Pow5Split[i], j); }
+
+struct FloatDecimal
+{
+	uint32_t Digits;	// The value is Digits * 10^Exponent
+	int Exponent;
+};
+
+static FloatDecimal ShortestDecimal(uint32_t ieeeMantissa, uint32_t ieeeExponent)
+{
+	// Step 1: the float as m2 * 2^e2. The 2 extra bits make room for the halfway points to the neighbouring floats
+	int e2;
+	uint32_t m2;
+	if (ieeeExponent == 0)
+	{
+		e2 = 1 - s_FloatBias - s_FloatMantissaBits - 2;
+		m2 = ieeeMantissa;
+	}
+	else
+	{
+		e2 = (int)ieeeExponent - s_FloatBias - s_FloatMantissaBits - 2;
+		m2 = (1u << s_FloatMantissaBits) | ieeeMantissa;
+	}
+	bool acceptBounds = (m2 & 1) == 0;	// Halfway points round to even, so they belong to this float if its mantissa is even
+
+	// Step 2: the range of decimals that read back as this float. mv is the float, mp and mm the halfway points above and below
+	// Below a power of 2 the floats are twice as close together, so mm is closer
+	uint32_t mv = 4 * m2;
+	uint32_t mp = 4 * m2 + 2;
+	uint32_t mmShift = ieeeMantissa != 0 || ieeeExponent <= 1;
+	uint32_t mm = 4 * m2 - 1 - mmShift;
+
+	// Step 3: all three as decimal numbers with the same power of 10
+	uint32_t vr, vp, vm;
+	int e10;
+	bool vmIsTrailingZeros = false;
+	bool vrIsTrailingZeros = false;
+	uint8_t lastRemovedDigit = 0;
+	if (e2 >= 0)
+	{
+		uint32_t q = Log10Pow2(e2);
+		e10 = (int)q;
+		int k = s_Pow5InverseBitCount + Pow5Bits((int)q) - 1;
+		int i = -e2 + (int)q + k;
+		vr = MultiplyPow5InverseDivPow2(mv, q, i);
+		vp = MultiplyPow5InverseDivPow2(mp, q, i);
+		vm = MultiplyPow5InverseDivPow2(mm, q, i);
+		if (q != 0 && (vp - 1) / 10 <= vm / 10)
+		{
+			// We won't remove any digits below, but still need the one that was removed by dividing, for rounding
+			int l = s_Pow5InverseBitCount + Pow5Bits((int)(q - 1)) - 1;
+			lastRemovedDigit = (uint8_t)(MultiplyPow5InverseDivPow2(mv, q - 1, -e2 + (int)q - 1 + l) % 10);
+		}
+		if (q <= 9)
+		{
+			// Only one of mp, mv and mm can be a multiple of 5
+			if (mv % 5 == 0)
+				vrIsTrailingZeros = MultipleOfPowerOf5(mv, q);
+			else if (acceptBounds)
+				vmIsTrailingZeros = MultipleOfPowerOf5(mm, q);
+			else
+				vp -= MultipleOfPowerOf5(mp, q);
+		}
+	}
+	else
+	{
+		uint32_t q = Log10Pow5(-e2);
+		e10 = (int)q + e2;
+		int i = -e2 - (int)q;
+		int k = Pow5Bits(i) - s_Pow5BitCount;
+		int j = (int)q - k;
+		vr = MultiplyPow5DivPow2(mv, (uint32_t)i, j);
+		vp = MultiplyPow5DivPow2(mp, (uint32_t)i, j);
+		vm = MultiplyPow5DivPow2(mm, (uint32_t)i, j);
+		if (q != 0 && (vp - 1) / 10 <= vm / 10)
+		{
+			j = (int)q - 1 - (Pow5Bits(i + 1) - s_Pow5BitCount);
+			lastRemovedDigit = (uint8_t)(MultiplyPow5DivPow2(mv, (uint32_t)(i + 1), j) % 10);
+		}
+		if (q <= 1)
+		{
+			// mv = 4 * m2 always has at least two trailing 0 bits, mp = mv + 2 at least one, and mm has one only if mmShift is 1
+			vrIsTrailingZeros = true;
+			if (acceptBounds)
+				vmIsTrailingZeros = mmShift == 1;
+			else
+				vp--;
+		}
+		else if (q < 31)
+		{
+			vrIsTrailingZeros = MultipleOfPowerOf2(mv, q - 1);
+		}
+	}
+
+	// Step 4: remove digits while the top and bottom of the range are still different numbers
+	int removed = 0;
+	uint32_t output;
+	if (vmIsTrailingZeros || vrIsTrailingZeros)
+	{
+		// The rare case (about 4%) where exact ties matter
+		while (vp / 10 > vm / 10)
+		{
+			vmIsTrailingZeros &= vm % 10 == 0;
+			vrIsTrailingZeros &= lastRemovedDigit == 0;
+			lastRemovedDigit = (uint8_t)(vr % 10);
+			vr /= 10;
+			vp /= 10;
+			vm /= 10;
+			removed++;
+		}
+		if (vmIsTrailingZeros)
+		{
+			while (vm % 10 == 0)
+			{
+				vrIsTrailingZeros &= lastRemovedDigit == 0;
+				lastRemovedDigit = (uint8_t)(vr % 10);
+				vr /= 10;
+				vp /= 10;
+				vm /= 10;
+				removed++;
+			}
+		}
+		if (vrIsTrailingZeros && lastRemovedDigit == 5 && vr % 2 == 0)
+			lastRemovedDigit = 4;	// Exactly halfway, round to even
+		output = vr + ((vr == vm && (!acceptBounds || !vmIsTrailingZeros)) || lastRemovedDigit >= 5);
+	}
+	else
+	{
+		while (vp / 10 > vm / 10)
+		{
+			lastRemovedDigit = (uint8_t)(vr % 10);
+			vr /= 10;
+			vp /= 10;
+			vm /= 10;
+			removed++;
+		}
+		output = vr + (vr == vm || lastRemovedDigit >= 5);
+	}
+	return { output, e10 + removed };
+}
+
+static int DecimalLength(uint64_t value)
+{
+	int length = 1;
+	while (value >= 10)
+	{
+		value /= 10;
+		length++;
+	}
+	return length;
+}
+
+// Writes exactly length digits, right to left, two at a time
+static void WriteDigits(char* buffer, uint64_t value, int length)
+{
+	char* end = buffer + length;
+	while (value >= 100)
+	{
+		uint64_t pair = (value % 100) * 2;
+		value /= 100;
+		end -= 2;
+		end[0] = s_DigitPairs[pair];
+		end[1] = s_DigitPairs[pair + 1];
+	}
+	if (value >= 10)
+	{
+		end -= 2;
+		end[0] = s_DigitPairs[value * 2];
+		end[1] = s_DigitPairs[value * 2 + 1];
+	}
+	else
+	{
+		end--;
+		end[0] = (char)('0' + value);
+	}
+	while (end > buffer)
+		*--end = '0';
+}
+
+static char* WriteShortest(char* buffer, uint32_t ieeeMantissa, uint32_t ieeeExponent)
+{
+	FloatDecimal decimal = ShortestDecimal(ieeeMantissa, ieeeExponent);
+	int length = DecimalLength(decimal.Digits);
+	int point = length + decimal.Exponent;	// Where the decimal point goes, counted from the first digit
+
+	// Exponents only for the numbers that would otherwise need lots of zeros, like iostream
+	if (point > 9 || point < -3)
+	{
+		char digits[9];
+		WriteDigits(digits, decimal.Digits, length);
+		*buffer++ = digits[0];
+		if (length > 1)
+		{
+			*buffer++ = '.';
+			memcpy(buffer, digits + 1, length - 1);
+			buffer += length - 1;
+		}
+
+		int exponent = point - 1;
+		*buffer++ = 'e';
+		*buffer++ = exponent < 0 ? '-' : '+';
+		if (exponent < 0)
+			exponent = -exponent;
+		int exponentLength = exponent >= 10 ? 2 : 1;
+		if (exponentLength == 1)
+			*buffer++ = '0';	// At least two digits, "1e+05"
+		WriteDigits(buffer, (uint64_t)exponent, exponentLength);
+		return buffer + exponentLength;
+	}
+
+	if (point <= 0)
+	{
+		// 0.000123
+		*buffer++ = '0';
+		*buffer++ = '.';
+		for (int i = 0; i < -point; i++)
+			*buffer++ = '0';
+		WriteDigits(buffer, decimal.Digits, length);
+		return buffer + length;
+	}
+
+	if (point >= length)
+	{
+		// 1200
+		WriteDigits(buffer, decimal.Digits, length);
+		buffer += length;
+		for (int i = length; i < point; i++)
+			*buffer++ = '0';
+		return buffer;
+	}
+
+	// 12.34
+	WriteDigits(buffer, decimal.Digits, length);
+	memmove(buffer + point + 1, buffer + point, length - point);
+	buffer[point] = '.';
+	return buffer + length + 1;
+}
+
+static const uint64_t s_PowersOf10[10] = { 1, 10, 100, 1000, 10000, 100000, 1000000, 10000000, 100000000, 1000000000 };
+
+// The float times 10^decimals is exact in a double: a float has 24 bits and 5^9 needs 21, which fits in a double's 53
+// So the only rounding is the one we do ourselves, to the nearest integer with ties to even like printf
+static char* WriteFixed(char* buffer, float value, bool negative, uint32_t ieeeMantissa, uint32_t ieeeExponent, int decimals)
+{
+	double scaled = (double)(negative ? -value : value) * (double)s_PowersOf10[decimals];
+	if (scaled >= 9.0e18)
+		return WriteShortest(buffer, ieeeMantissa, ieeeExponent);
+
+	uint64_t whole = (uint64_t)scaled;
+	double fraction = scaled - (double)whole;
+	if (fraction > 0.5 || (fraction == 0.5 && (whole & 1)))
+		whole++;
+
+	uint64_t integer = whole / s_PowersOf10[decimals];
+	int length = DecimalLength(integer);
+	WriteDigits(buffer, integer, length);
+	buffer += length;
+	if (decimals > 0)
+	{
+		*buffer++ = '.';
+		WriteDigits(buffer, whole % s_PowersOf10[decimals], decimals);
+		buffer += decimals;
+	}
+	return buffer;
+}
+
+char* WriteFloat(char* buffer, float value, int decimals)
+{
+	uint32_t bits;
+	memcpy(&bits, &value, sizeof(bits));
+	uint32_t ieeeMantissa = bits & ((1u << s_FloatMantissaBits) - 1);
+	uint32_t ieeeExponent = (bits >> s_FloatMantissaBits) & 0xff;
+	bool negative = (bits >> 31) != 0;
+
+	if (ieeeExponent == 0xff)
+	{
+		if (ieeeMantissa != 0)
+		{
+			memcpy(buffer, "nan", 3);
+			return buffer + 3;
+		}
+		if (negative)
+			*buffer++ = '-';
+		memcpy(buffer, "inf", 3);
+		return buffer + 3;
+	}
+
+	if (negative)
+		*buffer++ = '-';
+
+	if (decimals >= 0)
+		return WriteFixed(buffer, value, negative, ieeeMantissa, ieeeExponent, decimals > 9 ? 9 : decimals);
+
+	if (ieeeExponent == 0 && ieeeMantissa == 0)
+	{
+		*buffer++ = '0';
+		return buffer;
+	}
+	return WriteShortest(buffer, ieeeMantissa, ieeeExponent);
+}
+
+char* WriteVector2(char* buffer, const Vector2& vector, int decimals)
+{
+	*buffer++ = '(';
+	buffer = WriteFloat(buffer, vector.x, decimals);
+	memcpy(buffer, " | ", 3);
+	buffer = WriteFloat(buffer + 3, vector.y, decimals);
+	*buffer++ = ')';
+	return buffer;
+}
+
+char* WriteVertex(char* buffer, const Vertex& vertex, int decimals)
+{
+	*buffer++ = '(';
+	buffer = WriteFloat(buffer, vertex.x, decimals);
+	memcpy(buffer, " | ", 3);
+	buffer = WriteFloat(buffer + 3, vertex.y, decimals);
+	memcpy(buffer, " | ", 3);
+	buffer = WriteFloat(buffer + 3, vertex.z, decimals);
+	*buffer++ = ')';
+	return buffer;
+}
+
+size_t WriteVector2s(Span<const Vector2> vectors, char* buffer, int decimals)
+{
+	char* position = buffer;
+	for (const Vector2& vector : vectors)
+	{
+		position = WriteVector2(position, vector, decimals);
+		*position++ = '\n';
+	}
+	return position - buffer;
+}
+
+size_t WriteVertices(Span<const Vertex> vertices, char* buffer, int decimals)
+{
+	char* position = buffer;
+	for (const Vertex& vertex : vertices)
+	{
+		position = WriteVertex(position, vertex, decimals);
+		*position++ = '\n';
+	}
+	return position - buffer;
+}
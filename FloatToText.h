@@ -0,0 +1,35 @@
+#pragma once
+
+#include <cstddef>
+
+#include "Span.h"
+#include "Vector.h"
+#include "Vertex.h"
+
+// Fast float to text, for writing out millions of positions
+// iostream formatting goes through locales, stream state and virtual calls for every single float. These functions just write chars into a buffer
+// Nothing is allocated and nothing checks the size of the buffer: make it big enough with the Max...TextSize constants
+
+// The shortest text that reads back as exactly the same float (the Ryu algorithm by Ulf Adams)
+// 0.1f is written as "0.1" instead of "0.100000001". Very big and very small numbers use an exponent: "1.5e+20", like iostream does
+constexpr int ShortestFloat = -1;
+
+// Longest text any of these can write for one float (fixed precision with 9 decimals is the longest)
+constexpr size_t MaxFloatTextSize = 32;
+
+// Each returns a pointer to just after the last char it wrote. No 0 terminator is written
+// decimals: ShortestFloat, or 0 to 9 digits after the decimal point, rounded like printf("%.3f") does
+// Numbers too big for fixed precision (their digits wouldn't fit in 64 bits) are written in the shortest form instead
+char* WriteFloat(char* buffer, float value, int decimals = ShortestFloat);
+
+// The same "(x | y)" and "(x | y | z)" that operator<< writes
+constexpr size_t MaxVector2TextSize = 2 * MaxFloatTextSize + 5;
+constexpr size_t MaxVertexTextSize = 3 * MaxFloatTextSize + 8;
+
+char* WriteVector2(char* buffer, const Vector2& vector, int decimals = ShortestFloat);
+char* WriteVertex(char* buffer, const Vertex& vertex, int decimals = ShortestFloat);
+
+// One per line. The buffer needs room for Max...TextSize + 1 chars per element
+// Returns how many chars were written
+size_t WriteVector2s(Span<const Vector2> vectors, char* buffer, int decimals = ShortestFloat);
+size_t WriteVertices(Span<const Vertex> vertices, char* buffer, int decimals = ShortestFloat);
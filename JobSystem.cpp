@@ -0,0 +1,93 @@
+#include "JobSystem.h"
+
+JobSystem::JobSystem(size_t threadCount)
+{
+	for (size_t i = 1; i < threadCount; i++)
+		m_Threads.emplace_back(&JobSystem::WorkerLoop, this, i);
+}
+
+JobSystem::~JobSystem()
+{
+	{
+		std::lock_guard<std::mutex> lock(m_Mutex);
+		m_Quit = true;
+	}
+	m_WorkReady.notify_all();
+	for (std::thread& thread : m_Threads)
+		thread.join();
+}
+
+JobSystem& JobSystem::Get()
+{
+	// hardware_concurrency can return 0 when it doesn't know
+	static JobSystem s_Instance(std::thread::hardware_concurrency() > 0 ? std::thread::hardware_concurrency() : 1);
+	return s_Instance;
+}
+
+bool& JobSystem::IsWorkerThread()
+{
+	static thread_local bool s_IsWorker = false;
+	return s_IsWorker;
+}
+
+void JobSystem::RunChunks()
+{
+	size_t finished = 0;
+	for (;;)
+	{
+		size_t chunk = m_Job.NextChunk.fetch_add(1, std::memory_order_relaxed);
+		if (chunk >= m_Job.ChunkCount)
+			break;
+		size_t begin = chunk * m_Job.ChunkSize;
+		size_t end = begin + m_Job.ChunkSize < m_Job.Count ? begin + m_Job.ChunkSize : m_Job.Count;
+		m_Job.Invoke(m_Job.Function, begin, end);
+		finished++;
+	}
+	// Release, so everything this thread wrote is visible to the thread that sees the last chunk finish
+	m_Job.FinishedChunks.fetch_add(finished, std::memory_order_acq_rel);
+}
+
+void JobSystem::Run(size_t maxThreads)
+{
+	{
+		std::lock_guard<std::mutex> lock(m_Mutex);
+		m_Job.NextChunk.store(0, std::memory_order_relaxed);
+		m_Job.FinishedChunks.store(0, std::memory_order_relaxed);
+		m_Job.Workers = maxThreads - 1;
+		m_ActiveWorkers = m_Job.Workers;
+		m_Generation++;
+	}
+	m_WorkReady.notify_all();
+
+	IsWorkerThread() = true;
+	RunChunks();
+	IsWorkerThread() = false;
+
+	// The job (and the lambda it points to) must stay alive until every worker has stopped looking at it, not just until the chunks are done
+	std::unique_lock<std::mutex> lock(m_Mutex);
+	m_WorkDone.wait(lock, [this]() { return m_ActiveWorkers == 0; });
+}
+
+void JobSystem::WorkerLoop(size_t index)
+{
+	IsWorkerThread() = true;
+	size_t seenGeneration = 0;
+	for (;;)
+	{
+		{
+			std::unique_lock<std::mutex> lock(m_Mutex);
+			m_WorkReady.wait(lock, [&]() { return m_Quit || m_Generation != seenGeneration; });
+			if (m_Quit)
+				return;
+			seenGeneration = m_Generation;
+			if (index > m_Job.Workers)
+				continue;	// Not needed for this one
+		}
+
+		RunChunks();
+
+		std::lock_guard<std::mutex> lock(m_Mutex);
+		if (--m_ActiveWorkers == 0)
+			m_WorkDone.notify_one();
+	}
+}
@@ -0,0 +1,84 @@
+#pragma once
+
+#include <atomic>
+#include <condition_variable>
+#include <cstddef>
+#include <mutex>
+#include <thread>
+#include <type_traits>
+#include <vector>
+
+// A small pool of worker threads for splitting loops over lots of elements
+// Starting a std::thread costs tens of microseconds, so the threads are started once and then wait until there is work
+// ParallelFor cuts the loop into chunks, and every thread (including the one that called it) keeps taking the next chunk until none are left
+class JobSystem
+{
+private:
+	// One loop at a time. Invoke calls the lambda through a plain function pointer, so no std::function has to be allocated
+	struct Job
+	{
+		void (*Invoke)(void* function, size_t begin, size_t end) = nullptr;
+		void* Function = nullptr;
+		size_t Count = 0;
+		size_t ChunkSize = 0;
+		size_t ChunkCount = 0;
+		size_t Workers = 0;						// How many of the worker threads help with this job
+		std::atomic<size_t> NextChunk{ 0 };
+		std::atomic<size_t> FinishedChunks{ 0 };
+	};
+
+	std::vector<std::thread> m_Threads;
+	std::mutex m_Mutex;
+	std::condition_variable m_WorkReady;
+	std::condition_variable m_WorkDone;
+	std::mutex m_RunMutex;						// Only one ParallelFor at a time
+	Job m_Job;
+	size_t m_Generation = 0;					// Goes up for every job, so the workers know there is a new one
+	size_t m_ActiveWorkers = 0;
+	bool m_Quit = false;
+
+	JobSystem(size_t threadCount);
+	~JobSystem();
+
+	void WorkerLoop(size_t index);
+	void RunChunks();
+	void Run(size_t maxThreads);
+	static bool& IsWorkerThread();
+public:
+	JobSystem(const JobSystem&) = delete;
+	JobSystem& operator=(const JobSystem&) = delete;
+
+	// One thread per CPU core, started the first time it is used
+	static JobSystem& Get();
+
+	// The worker threads plus the thread calling ParallelFor
+	size_t ThreadCount() const { return m_Threads.size() + 1; }
+
+	// Calls function(begin, end) for chunks of [0, count) and returns once all of them are done
+	// maxThreads limits how many threads take part (0 means all of them, 1 runs everything on the calling thread)
+	// Calling ParallelFor from inside a job just runs the loop on that thread, so it can't wait for itself
+	template<typename F>
+	void ParallelFor(size_t count, size_t chunkSize, F&& function, size_t maxThreads = 0)
+	{
+		if (count == 0)
+			return;
+		if (chunkSize == 0)
+			chunkSize = 1;
+		if (maxThreads == 0 || maxThreads > ThreadCount())
+			maxThreads = ThreadCount();
+
+		if (maxThreads == 1 || count <= chunkSize || IsWorkerThread())
+		{
+			function((size_t)0, count);
+			return;
+		}
+
+		std::lock_guard<std::mutex> lock(m_RunMutex);
+		m_Job.Invoke = [](void* f, size_t begin, size_t end) { (*static_cast<std::remove_reference_t<F>*>(f))(begin, end); };
+		m_Job.Function = (void*)&function;
+		m_Job.Count = count;
+		m_Job.ChunkSize = chunkSize;
+		m_Job.ChunkCount = (count + chunkSize - 1) / chunkSize;
+		Run(maxThreads);
+	}
+};
@@ -0,0 +1,51 @@
+#pragma once
+
+#include <array>
+#include <cstddef>
+#include <cstdint>
+
+#include "ConstexprMath.h"
+#include "Vector.h"
+
+// Tables worked out by the compiler
+// The values end up in the .exe like any other constant data, so nothing is calculated when the programme starts and nothing has to be initialised
+
+// Calls generate(0) ... generate(Count - 1) while compiling and keeps the results
+// generate must be usable in a constant expression (a constexpr lambda works)
+template<typename T, size_t Count, typename F>
+constexpr std::array<T, Count> MakeLookupTable(F generate)
+{
+	std::array<T, Count> table{};
+	for (size_t i = 0; i < Count; i++)
+		table[i] = generate(i);
+	return table;
+}
+
+// Unit vectors for Count evenly spaced angles, starting at (1, 0) and going anticlockwise
+template<size_t Count>
+constexpr std::array<Vector2, Count> MakeDirectionTable()
+{
+	return MakeLookupTable<Vector2, Count>([](size_t i)
+	{
+		double angle = 2.0 * Pi * (double)i / (double)Count;
+		return Vector2((float)ConstexprCos(angle), (float)ConstexprSin(angle));
+	});
+}
+
+// 256 directions, so a single byte can store an angle and wraps around by itself (255 + 1 is 0 again, a full turn)
+inline constexpr std::array<Vector2, 256> s_DirectionTable = MakeDirectionTable<256>();
+
+constexpr Vector2 Direction(uint8_t angle)
+{
+	return s_DirectionTable[angle];
+}
+
+// The closest of the 256 angles to an angle in radians
+constexpr uint8_t AngleFromRadians(double radians)
+{
+	double turns = radians / (2.0 * Pi);
+	turns -= (double)(long long)turns;	// Only the part of the last turn is left, between -1 and 1
+	if (turns < 0.0)
+		turns += 1.0;
+	return (uint8_t)(unsigned)(turns * 256.0 + 0.5);	// 256 wraps around to 0
+}
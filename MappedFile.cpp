@@ -0,0 +1,108 @@
+#include "MappedFile.h"
+
+#if defined(_WIN32)
+#define WIN32_LEAN_AND_MEAN
+#define NOMINMAX
+#include <windows.h>
+#else
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+#endif
+
+// Nothing can be mapped for an empty file, so it points here instead
+static const char s_Empty[1] = {};
+
+#if defined(_WIN32)
+bool MappedFile::Open(const char* path)
+{
+	Close();
+	HANDLE file = CreateFileA(path, GENERIC_READ, FILE_SHARE_READ, nullptr, OPEN_EXISTING, FILE_FLAG_SEQUENTIAL_SCAN, nullptr);
+	if (file == INVALID_HANDLE_VALUE)
+		return false;
+
+	LARGE_INTEGER size;
+	if (!GetFileSizeEx(file, &size))
+	{
+		CloseHandle(file);
+		return false;
+	}
+	if (size.QuadPart == 0)
+	{
+		CloseHandle(file);
+		m_Data = s_Empty;
+		return true;
+	}
+
+	HANDLE mapping = CreateFileMappingA(file, nullptr, PAGE_READONLY, 0, 0, nullptr);
+	void* data = mapping ? MapViewOfFile(mapping, FILE_MAP_READ, 0, 0, 0) : nullptr;
+	if (!data)
+	{
+		if (mapping)
+			CloseHandle(mapping);
+		CloseHandle(file);
+		return false;
+	}
+
+	m_File = file;
+	m_Mapping = mapping;
+	m_Data = static_cast<const char*>(data);
+	m_Size = (size_t)size.QuadPart;
+	return true;
+}
+
+void MappedFile::Close()
+{
+	if (m_Data && m_Data != s_Empty)
+	{
+		UnmapViewOfFile(m_Data);
+		CloseHandle(m_Mapping);
+		CloseHandle(m_File);
+	}
+	m_File = nullptr;
+	m_Mapping = nullptr;
+	m_Data = nullptr;
+	m_Size = 0;
+}
+#else
+bool MappedFile::Open(const char* path)
+{
+	Close();
+	int file = open(path, O_RDONLY);
+	if (file < 0)
+		return false;
+
+	struct stat status;
+	if (fstat(file, &status) != 0)
+	{
+		close(file);
+		return false;
+	}
+	if (status.st_size == 0)
+	{
+		close(file);
+		m_Data = s_Empty;
+		return true;
+	}
+
+	// The mapping keeps the file open by itself
+	void* data = mmap(nullptr, (size_t)status.st_size, PROT_READ, MAP_PRIVATE, file, 0);
+	close(file);
+	if (data == MAP_FAILED)
+		return false;
+	madvise(data, (size_t)status.st_size, MADV_SEQUENTIAL);	// Read ahead further, and drop pages behind sooner
+
+	m_Data = static_cast<const char*>(data);
+	m_Size = (size_t)status.st_size;
+	return true;
+}
+
+void MappedFile::Close()
+{
+	if (m_Data && m_Data != s_Empty)
+		munmap(const_cast<char*>(m_Data), m_Size);
+	m_Data = nullptr;
+	m_Size = 0;
+}
+#endif
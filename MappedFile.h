@@ -0,0 +1,36 @@
+#pragma once
+
+#include <cstddef>
+
+// A file opened read only and mapped into memory, so its bytes can be read straight through a pointer
+// Reading with ifstream copies everything from the OS into the stream's buffer and then again into ours. With a mapping the OS loads the pages
+// of the file right where the pointer points, the first time each one is touched, and no copy is made at all. The whole file doesn't have to fit in RAM either,
+// pages that haven't been used for a while can simply be dropped again
+class MappedFile
+{
+private:
+	const char* m_Data = nullptr;
+	size_t m_Size = 0;
+#if defined(_WIN32)
+	void* m_File = nullptr;
+	void* m_Mapping = nullptr;
+#endif
+public:
+	MappedFile() = default;
+	// Check IsOpen() afterwards
+	explicit MappedFile(const char* path) { Open(path); }
+	~MappedFile() { Close(); }
+
+	MappedFile(const MappedFile&) = delete;
+	MappedFile& operator=(const MappedFile&) = delete;
+
+	// False if the file doesn't exist or can't be read. An empty file opens, with Size() 0
+	bool Open(const char* path);
+	void Close();
+
+	bool IsOpen() const { return m_Data != nullptr; }
+	const char* Data() const { return m_Data; }
+	size_t Size() const { return m_Size; }
+	const char* begin() const { return m_Data; }
+	const char* end() const { return m_Data + m_Size; }
+};
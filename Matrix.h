@@ -0,0 +1,201 @@
+#pragma once
+
+#include <cmath>
+#include <iostream>
+
+#include "Vector.h"
+
+// 3x3 and 4x4 matrices
+// Matrix3 is for 2D: a Vector2 point is treated as (x, y, 1), so the last column can move it. Matrix4 does the same for 3D with (x, y, z, 1)
+// Matrices are stored as columns, and a matrix times a vector is columns[0] * x + columns[1] * y + ...
+// That is 4 SIMD multiplies and adds on Vector4, with no shuffling. It also means a * b applies b first, then a
+// Everything is built from the Vector3 and Vector4 operators, so it is constexpr too and uses SIMD at runtime
+
+struct Matrix3
+{
+	Vector3 Columns[3];
+
+	// The identity matrix, which changes nothing
+	constexpr Matrix3()
+		: Columns{ Vector3(1.0f, 0.0f, 0.0f), Vector3(0.0f, 1.0f, 0.0f), Vector3(0.0f, 0.0f, 1.0f) } {}
+	constexpr Matrix3(const Vector3& column0, const Vector3& column1, const Vector3& column2)
+		: Columns{ column0, column1, column2 } {}
+
+	constexpr float Get(int row, int column) const
+	{
+		const Vector3& c = Columns[column];
+		return row == 0 ? c.x : row == 1 ? c.y : c.z;
+	}
+
+	constexpr Vector3 operator*(const Vector3& vector) const
+	{
+		return Columns[0] * vector.x + Columns[1] * vector.y + Columns[2] * vector.z;
+	}
+
+	constexpr Matrix3 operator*(const Matrix3& other) const
+	{
+		return Matrix3(*this * other.Columns[0], *this * other.Columns[1], *this * other.Columns[2]);
+	}
+
+	constexpr bool operator==(const Matrix3& other) const { return Columns[0] == other.Columns[0] && Columns[1] == other.Columns[1] && Columns[2] == other.Columns[2]; }
+	constexpr bool operator!=(const Matrix3& other) const { return !(*this == other); }
+
+	// 2D transforms
+	static constexpr Matrix3 Translation(const Vector2& offset)
+	{
+		return Matrix3(Vector3(1.0f, 0.0f, 0.0f), Vector3(0.0f, 1.0f, 0.0f), Vector3(offset.x, offset.y, 1.0f));
+	}
+	static constexpr Matrix3 Scaling(const Vector2& scale)
+	{
+		return Matrix3(Vector3(scale.x, 0.0f, 0.0f), Vector3(0.0f, scale.y, 0.0f), Vector3(0.0f, 0.0f, 1.0f));
+	}
+	// Anticlockwise, in radians
+	static Matrix3 Rotation(float radians)
+	{
+		float c = std::cos(radians), s = std::sin(radians);
+		return Matrix3(Vector3(c, s, 0.0f), Vector3(-s, c, 0.0f), Vector3(0.0f, 0.0f, 1.0f));
+	}
+};
+
+// A point is moved by the translation, a direction isn't (its 3rd component is 0 instead of 1)
+constexpr Vector2 TransformPoint(const Matrix3& matrix, const Vector2& point)
+{
+	Vector3 result = matrix * Vector3(point.x, point.y, 1.0f);
+	return Vector2(result.x, result.y);
+}
+
+constexpr Vector2 TransformDirection(const Matrix3& matrix, const Vector2& direction)
+{
+	Vector3 result = matrix * Vector3(direction.x, direction.y, 0.0f);
+	return Vector2(result.x, result.y);
+}
+
+constexpr Matrix3 Transpose(const Matrix3& m)
+{
+	return Matrix3(Vector3(m.Columns[0].x, m.Columns[1].x, m.Columns[2].x),
+		Vector3(m.Columns[0].y, m.Columns[1].y, m.Columns[2].y),
+		Vector3(m.Columns[0].z, m.Columns[1].z, m.Columns[2].z));
+}
+
+constexpr float Determinant(const Matrix3& m)
+{
+	return Dot(m.Columns[0], Cross(m.Columns[1], m.Columns[2]));
+}
+
+// The rows of the inverse are the cross products of the columns, divided by the determinant
+// A matrix that squashes everything flat (determinant 0) has no inverse. Then the identity is returned
+constexpr Matrix3 Inverse(const Matrix3& m)
+{
+	float determinant = Determinant(m);
+	if (determinant == 0.0f)
+		return Matrix3();
+	float inverse = 1.0f / determinant;
+	return Transpose(Matrix3(Cross(m.Columns[1], m.Columns[2]) * inverse, Cross(m.Columns[2], m.Columns[0]) * inverse, Cross(m.Columns[0], m.Columns[1]) * inverse));
+}
+
+struct Matrix4
+{
+	Vector4 Columns[4];
+
+	// The identity matrix, which changes nothing
+	constexpr Matrix4()
+		: Columns{ Vector4(1.0f, 0.0f, 0.0f, 0.0f), Vector4(0.0f, 1.0f, 0.0f, 0.0f), Vector4(0.0f, 0.0f, 1.0f, 0.0f), Vector4(0.0f, 0.0f, 0.0f, 1.0f) } {}
+	constexpr Matrix4(const Vector4& column0, const Vector4& column1, const Vector4& column2, const Vector4& column3)
+		: Columns{ column0, column1, column2, column3 } {}
+	// The 3x3 part does rotation and scale, translation goes in the last column
+	constexpr Matrix4(const Matrix3& linear, const Vector3& translation)
+		: Columns{ Vector4(linear.Columns[0].x, linear.Columns[0].y, linear.Columns[0].z, 0.0f),
+			Vector4(linear.Columns[1].x, linear.Columns[1].y, linear.Columns[1].z, 0.0f),
+			Vector4(linear.Columns[2].x, linear.Columns[2].y, linear.Columns[2].z, 0.0f),
+			Vector4(translation.x, translation.y, translation.z, 1.0f) } {}
+
+	constexpr float Get(int row, int column) const
+	{
+		const Vector4& c = Columns[column];
+		return row == 0 ? c.x : row == 1 ? c.y : row == 2 ? c.z : c.w;
+	}
+
+	constexpr Matrix3 GetLinear() const
+	{
+		return Matrix3(Vector3(Columns[0].x, Columns[0].y, Columns[0].z), Vector3(Columns[1].x, Columns[1].y, Columns[1].z), Vector3(Columns[2].x, Columns[2].y, Columns[2].z));
+	}
+	constexpr Vector3 GetTranslation() const { return Vector3(Columns[3].x, Columns[3].y, Columns[3].z); }
+
+	constexpr Vector4 operator*(const Vector4& vector) const
+	{
+		return Columns[0] * vector.x + Columns[1] * vector.y + Columns[2] * vector.z + Columns[3] * vector.w;
+	}
+
+	constexpr Matrix4 operator*(const Matrix4& other) const
+	{
+		return Matrix4(*this * other.Columns[0], *this * other.Columns[1], *this * other.Columns[2], *this * other.Columns[3]);
+	}
+
+	constexpr bool operator==(const Matrix4& other) const { return Columns[0] == other.Columns[0] && Columns[1] == other.Columns[1] && Columns[2] == other.Columns[2] && Columns[3] == other.Columns[3]; }
+	constexpr bool operator!=(const Matrix4& other) const { return !(*this == other); }
+
+	// 3D transforms
+	static constexpr Matrix4 Translation(const Vector3& offset) { return Matrix4(Matrix3(), offset); }
+	static constexpr Matrix4 Scaling(const Vector3& scale)
+	{
+		return Matrix4(Matrix3(Vector3(scale.x, 0.0f, 0.0f), Vector3(0.0f, scale.y, 0.0f), Vector3(0.0f, 0.0f, scale.z)), Vector3());
+	}
+	// Anticlockwise when looking down the axis towards the origin, in radians
+	static Matrix4 RotationX(float radians)
+	{
+		float c = std::cos(radians), s = std::sin(radians);
+		return Matrix4(Matrix3(Vector3(1.0f, 0.0f, 0.0f), Vector3(0.0f, c, s), Vector3(0.0f, -s, c)), Vector3());
+	}
+	static Matrix4 RotationY(float radians)
+	{
+		float c = std::cos(radians), s = std::sin(radians);
+		return Matrix4(Matrix3(Vector3(c, 0.0f, -s), Vector3(0.0f, 1.0f, 0.0f), Vector3(s, 0.0f, c)), Vector3());
+	}
+	static Matrix4 RotationZ(float radians)
+	{
+		float c = std::cos(radians), s = std::sin(radians);
+		return Matrix4(Matrix3(Vector3(c, s, 0.0f), Vector3(-s, c, 0.0f), Vector3(0.0f, 0.0f, 1.0f)), Vector3());
+	}
+};
+
+constexpr Vector3 TransformPoint(const Matrix4& matrix, const Vector3& point)
+{
+	Vector4 result = matrix * Vector4(point.x, point.y, point.z, 1.0f);
+	return Vector3(result.x, result.y, result.z);
+}
+
+constexpr Vector3 TransformDirection(const Matrix4& matrix, const Vector3& direction)
+{
+	Vector4 result = matrix * Vector4(direction.x, direction.y, direction.z, 0.0f);
+	return Vector3(result.x, result.y, result.z);
+}
+
+constexpr Matrix4 Transpose(const Matrix4& m)
+{
+	return Matrix4(Vector4(m.Columns[0].x, m.Columns[1].x, m.Columns[2].x, m.Columns[3].x),
+		Vector4(m.Columns[0].y, m.Columns[1].y, m.Columns[2].y, m.Columns[3].y),
+		Vector4(m.Columns[0].z, m.Columns[1].z, m.Columns[2].z, m.Columns[3].z),
+		Vector4(m.Columns[0].w, m.Columns[1].w, m.Columns[2].w, m.Columns[3].w));
+}
+
+// Only for affine matrices (the bottom row is 0 0 0 1), which is every combination of translation, rotation and scale
+// Undoing them means undoing the 3x3 part, then moving back by the translation run through that inverse
+constexpr Matrix4 AffineInverse(const Matrix4& m)
+{
+	Matrix3 linear = Inverse(m.GetLinear());
+	return Matrix4(linear, (linear * m.GetTranslation()) * -1.0f);
+}
+
+inline std::ostream& operator<<(std::ostream& stream, const Matrix3& matrix)
+{
+	for (int row = 0; row < 3; row++)
+		stream << "[" << matrix.Get(row, 0) << " " << matrix.Get(row, 1) << " " << matrix.Get(row, 2) << "]" << (row < 2 ? "\n" : "");
+	return stream;
+}
+
+inline std::ostream& operator<<(std::ostream& stream, const Matrix4& matrix)
+{
+	for (int row = 0; row < 4; row++)
+		stream << "[" << matrix.Get(row, 0) << " " << matrix.Get(row, 1) << " " << matrix.Get(row, 2) << " " << matrix.Get(row, 3) << "]" << (row < 3 ? "\n" : "");
+	return stream;
+}
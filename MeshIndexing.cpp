@@ -0,0 +1,282 @@
+#include "MeshIndexing.h"
+
+#include <cmath>
+#include <cstring>
+
+static const uint32_t s_Empty = UINT32_MAX;
+
+// The bits of x, y and z. Adding 0 turns -0 into 0, so the two weld together like == says they should
+static void VertexBits(const Vertex& vertex, uint32_t bits[3])
+{
+	float coordinates[3] = { vertex.x + 0.0f, vertex.y + 0.0f, vertex.z + 0.0f };
+	memcpy(bits, coordinates, sizeof(coordinates));
+}
+
+// Neighbouring vertices differ in only a few bits, so the three are mixed until every bit of the hash depends on all of them
+static uint32_t HashVertex(const uint32_t bits[3])
+{
+	uint32_t hash = bits[0] * 0x8da6b343u ^ bits[1] * 0xd8163841u ^ bits[2] * 0xcb1ab31fu;
+	hash ^= hash >> 16;
+	hash *= 0x7feb352du;
+	hash ^= hash >> 15;
+	return hash;
+}
+
+void WeldVertices(Span<const Vertex> vertices, DynamicArray<Vertex>& unique, DynamicArray<uint32_t>& indices)
+{
+	unique.Clear();
+	unique.Reserve(vertices.Size());
+	indices.ResizeUninitialized(vertices.Size());
+
+	// At most half full, even when every vertex is different, so a search rarely has to step past more than an entry or two
+	// Each entry is the index in unique of the vertex that went there, or s_Empty
+	size_t capacity = 16;
+	while (capacity < vertices.Size() * 2)
+		capacity *= 2;
+	DynamicArray<uint32_t> table(capacity, s_Empty);
+	size_t mask = capacity - 1;
+
+	for (size_t i = 0; i < vertices.Size(); i++)
+	{
+		uint32_t bits[3];
+		VertexBits(vertices[i], bits);
+		for (size_t slot = HashVertex(bits) & mask;; slot = (slot + 1) & mask)
+		{
+			uint32_t entry = table[slot];
+			if (entry == s_Empty)
+			{
+				entry = (uint32_t)unique.Size();
+				table[slot] = entry;
+				unique.PushBack(vertices[i]);
+				indices[i] = entry;
+				break;
+			}
+			uint32_t existing[3];
+			VertexBits(unique[entry], existing);
+			if (memcmp(bits, existing, sizeof(bits)) == 0)
+			{
+				indices[i] = entry;
+				break;
+			}
+		}
+	}
+	unique.ShrinkToFit();
+}
+
+// Forsyth's scoring. A vertex scores more the more recently it was used (so its triangles get drawn while it is still in the cache),
+// and the fewer triangles it has left (so vertices get finished off, instead of leaving lone triangles behind that need them again much later)
+// The cache here is a model of the real one, bigger than it on purpose: it only has to say which vertices were used recently
+static const int s_CacheSize = 32;
+static const float s_CacheDecayPower = 1.5f;
+static const float s_LastTriangleScore = 0.75f;	// A bit less than the next ones, because the last triangle's vertices are used by its neighbours anyway
+static const float s_ValenceBoostScale = 2.0f;
+static const float s_ValenceBoostPower = 0.5f;
+static const uint32_t s_MaxValenceScore = 64;
+
+struct ForsythScores
+{
+	float Cache[s_CacheSize];
+	float Valence[s_MaxValenceScore];
+
+	ForsythScores()
+	{
+		for (int i = 0; i < s_CacheSize; i++)
+		{
+			if (i < 3)
+				Cache[i] = s_LastTriangleScore;
+			else
+				Cache[i] = powf(1.0f - (float)(i - 3) / (float)(s_CacheSize - 3), s_CacheDecayPower);
+		}
+		Valence[0] = 0.0f;
+		for (uint32_t i = 1; i < s_MaxValenceScore; i++)
+			Valence[i] = s_ValenceBoostScale * powf((float)i, -s_ValenceBoostPower);
+	}
+};
+
+static float VertexScore(const ForsythScores& scores, int cachePosition, uint32_t remaining)
+{
+	if (remaining == 0)
+		return -1.0f;	// Nothing left to draw with it
+	float score = cachePosition >= 0 ? scores.Cache[cachePosition] : 0.0f;
+	score += remaining < s_MaxValenceScore ? scores.Valence[remaining] : s_ValenceBoostScale * powf((float)remaining, -s_ValenceBoostPower);
+	return score;
+}
+
+void OptimizeVertexCache(Span<uint32_t> indices, size_t vertexCount)
+{
+	static const ForsythScores scores;
+	size_t triangleCount = indices.Size() / 3;
+	if (triangleCount == 0)
+		return;
+
+	// The triangles not drawn yet that use each vertex, all in one array: vertex v's are adjacency[first[v]] to adjacency[first[v] + remaining[v] - 1]
+	DynamicArray<uint32_t> remaining(vertexCount);
+	for (uint32_t index : indices)
+		remaining[index]++;
+	DynamicArray<uint32_t> first;
+	first.ResizeUninitialized(vertexCount);
+	uint32_t offset = 0;
+	for (size_t v = 0; v < vertexCount; v++)
+	{
+		first[v] = offset;
+		offset += remaining[v];
+	}
+	DynamicArray<uint32_t> filled(vertexCount);
+	DynamicArray<uint32_t> adjacency;
+	adjacency.ResizeUninitialized(indices.Size());
+	for (size_t i = 0; i < indices.Size(); i++)
+	{
+		uint32_t v = indices[i];
+		adjacency[first[v] + filled[v]++] = (uint32_t)(i / 3);
+	}
+
+	DynamicArray<int> cachePosition(vertexCount, -1);
+	DynamicArray<float> vertexScore;
+	vertexScore.ResizeUninitialized(vertexCount);
+	for (size_t v = 0; v < vertexCount; v++)
+		vertexScore[v] = VertexScore(scores, -1, remaining[v]);
+
+	auto triangleScore = [&](size_t triangle)
+	{
+		return vertexScore[indices[triangle * 3]] + vertexScore[indices[triangle * 3 + 1]] + vertexScore[indices[triangle * 3 + 2]];
+	};
+
+	// The best triangle to start with is the best one anywhere. After that only the triangles of the vertices in the cache are looked at
+	size_t best = 0;
+	float bestScore = -1e30f;
+	for (size_t t = 0; t < triangleCount; t++)
+	{
+		float score = triangleScore(t);
+		if (score > bestScore)
+		{
+			bestScore = score;
+			best = t;
+		}
+	}
+
+	DynamicArray<uint8_t> drawn(triangleCount);
+	DynamicArray<uint32_t> output;
+	output.ResizeUninitialized(indices.Size());
+	uint32_t cache[s_CacheSize + 3];
+	int cacheCount = 0;
+	size_t nextUndrawn = 0;
+
+	for (size_t emitted = 0; emitted < triangleCount; emitted++)
+	{
+		// None of the cached vertices have triangles left (a separate piece of the mesh is next), so carry on with the first triangle not drawn yet
+		if (best == SIZE_MAX)
+		{
+			while (drawn[nextUndrawn])
+				nextUndrawn++;
+			best = nextUndrawn;
+		}
+
+		drawn[best] = 1;
+		const uint32_t* triangle = &indices[best * 3];
+		for (int k = 0; k < 3; k++)
+		{
+			uint32_t v = triangle[k];
+			output[emitted * 3 + k] = v;
+
+			uint32_t* list = &adjacency[first[v]];
+			uint32_t count = remaining[v];
+			for (uint32_t j = 0; j < count; j++)
+			{
+				if (list[j] == best)
+				{
+					list[j] = list[count - 1];
+					break;
+				}
+			}
+			remaining[v] = count - 1;
+		}
+
+		// The triangle's vertices go to the front of the cache, and everything else moves back
+		uint32_t newCache[s_CacheSize + 3];
+		int newCount = 0;
+		for (int k = 0; k < 3; k++)
+		{
+			uint32_t v = triangle[k];
+			if ((k < 1 || v != triangle[0]) && (k < 2 || v != triangle[1]))
+				newCache[newCount++] = v;
+		}
+		for (int i = 0; i < cacheCount; i++)
+		{
+			uint32_t v = cache[i];
+			if (v != triangle[0] && v != triangle[1] && v != triangle[2])
+				newCache[newCount++] = v;
+		}
+		for (int i = s_CacheSize; i < newCount; i++)
+		{
+			uint32_t v = newCache[i];
+			cachePosition[v] = -1;
+			vertexScore[v] = VertexScore(scores, -1, remaining[v]);
+		}
+		cacheCount = newCount < s_CacheSize ? newCount : s_CacheSize;
+		memcpy(cache, newCache, cacheCount * sizeof(uint32_t));
+
+		for (int i = 0; i < cacheCount; i++)
+		{
+			uint32_t v = cache[i];
+			cachePosition[v] = i;
+			vertexScore[v] = VertexScore(scores, i, remaining[v]);
+		}
+
+		best = SIZE_MAX;
+		bestScore = -1e30f;
+		for (int i = 0; i < cacheCount; i++)
+		{
+			uint32_t v = cache[i];
+			const uint32_t* list = &adjacency[first[v]];
+			for (uint32_t j = 0; j < remaining[v]; j++)
+			{
+				float score = triangleScore(list[j]);
+				if (score > bestScore)
+				{
+					bestScore = score;
+					best = list[j];
+				}
+			}
+		}
+	}
+
+	memcpy(indices.Data(), output.Data(), indices.Size() * sizeof(uint32_t));
+}
+
+float AverageCacheMissRatio(Span<const uint32_t> indices, size_t vertexCount, size_t cacheSize)
+{
+	size_t triangleCount = indices.Size() / 3;
+	if (triangleCount == 0)
+		return 0.0f;
+
+	// A vertex is still in a first-in first-out cache until cacheSize more vertices have been put in after it
+	DynamicArray<size_t> insertedAt(vertexCount, SIZE_MAX);
+	size_t misses = 0;
+	for (size_t i = 0; i < triangleCount * 3; i++)
+	{
+		uint32_t v = indices[i];
+		if (insertedAt[v] == SIZE_MAX || misses - insertedAt[v] >= cacheSize)
+		{
+			insertedAt[v] = misses;
+			misses++;
+		}
+	}
+	return (float)misses / (float)triangleCount;
+}
+
+IndexBuffer::IndexBuffer(Span<const uint32_t> indices, size_t vertexCount)
+	: m_Is16Bit(vertexCount <= 65536)
+{
+	if (m_Is16Bit)
+	{
+		m_Indices16.ResizeUninitialized(indices.Size());
+		for (size_t i = 0; i < indices.Size(); i++)
+			m_Indices16[i] = (uint16_t)indices[i];
+	}
+	else
+	{
+		m_Indices32.ResizeUninitialized(indices.Size());
+		if (!indices.Empty())
+			memcpy(m_Indices32.Data(), indices.Data(), indices.Size() * sizeof(uint32_t));
+	}
+}
@@ -0,0 +1,50 @@
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+
+#include "DynamicArray.h"
+#include "Span.h"
+#include "Vertex.h"
+
+// Turning a list of triangles with their own copies of every vertex into an indexed mesh, and putting the triangles in an order the GPU likes
+//
+// Most vertices in a mesh are shared by about 6 triangles, so a mesh that stores 3 vertices per triangle stores most of them 6 times over
+// WeldVertices keeps one copy of each, and makes an index buffer that says which one every corner of every triangle uses
+//
+// After the vertex shader has run for a vertex, the GPU keeps the result in a small cache for a while. A triangle whose vertices are still in it costs nearly nothing
+// OptimizeVertexCache reorders the triangles so that they use vertices that were just used (Tom Forsyth's "Linear-Speed Vertex Cache Optimisation")
+// AverageCacheMissRatio (ACMR) measures it: how many vertices have to be shaded per triangle. 3 is the worst, around 0.5 to 0.7 is as good as it gets for a big mesh
+
+// Vertices count as the same when x, y and z are exactly the same floats (with -0 the same as 0)
+// unique gets every different vertex once, in the order they first appear. indices gets one index per vertex: where it went in unique
+// It finds the copies with an open addressing hash table (one flat array of indices, searched by stepping to the next entry), not std::unordered_map,
+// which allocates a node for every vertex and follows a pointer for every lookup
+void WeldVertices(Span<const Vertex> vertices, DynamicArray<Vertex>& unique, DynamicArray<uint32_t>& indices);
+
+// Reorders the triangles (every 3 indices) in place. Which vertices each triangle uses doesn't change, only the order they are drawn in
+void OptimizeVertexCache(Span<uint32_t> indices, size_t vertexCount);
+
+// Vertices shaded per triangle, with a first-in first-out cache of cacheSize vertices like the hardware has
+float AverageCacheMissRatio(Span<const uint32_t> indices, size_t vertexCount, size_t cacheSize = 16);
+
+// An index buffer ready for the GPU: 16 bit indices when there are 65536 vertices or fewer (half the memory), 32 bit ones otherwise
+class IndexBuffer
+{
+private:
+	DynamicArray<uint16_t> m_Indices16;
+	DynamicArray<uint32_t> m_Indices32;
+	bool m_Is16Bit = true;
+public:
+	IndexBuffer() = default;
+	IndexBuffer(Span<const uint32_t> indices, size_t vertexCount);
+
+	bool Is16Bit() const { return m_Is16Bit; }
+	size_t Size() const { return m_Is16Bit ? m_Indices16.Size() : m_Indices32.Size(); }
+	size_t IndexSize() const { return m_Is16Bit ? sizeof(uint16_t) : sizeof(uint32_t); }
+	size_t SizeInBytes() const { return Size() * IndexSize(); }
+	// For glBufferData. Draw with GL_UNSIGNED_SHORT or GL_UNSIGNED_INT, depending on Is16Bit()
+	const void* Data() const { return m_Is16Bit ? (const void*)m_Indices16.Data() : (const void*)m_Indices32.Data(); }
+
+	uint32_t operator[](size_t index) const { return m_Is16Bit ? m_Indices16[index] : m_Indices32[index]; }
+};
@@ -0,0 +1,347 @@
+#include "MeshLoader.h"
+
+#include <algorithm>
+#include <atomic>
+#include <charconv>
+#include <cstdint>
+#include <cstring>
+#include <string_view>
+#include <vector>
+
+#include "JobSystem.h"
+#include "MappedFile.h"
+#include "TextToFloat.h"
+
+// Big enough that handing out a chunk costs nothing next to parsing it, small enough that a few GB still make hundreds of chunks to share between the threads
+static const size_t s_ObjChunkSize = 4 << 20;
+static const size_t s_PlyChunkVertices = 1 << 18;
+
+static bool IsSpace(char c)
+{
+	return c == ' ' || c == '\t';
+}
+
+// Where the numbers of a "v x y z" line start, or nullptr for any other line ("vn", "vt", "f", comments...)
+static const char* FindPosition(const char* line, const char* lineEnd)
+{
+	while (line < lineEnd && IsSpace(*line))
+		line++;
+	if (lineEnd - line < 2 || line[0] != 'v' || !IsSpace(line[1]))
+		return nullptr;
+	return line + 2;
+}
+
+static const char* LineEnd(const char* line, const char* end)
+{
+	const char* newline = static_cast<const char*>(memchr(line, '\n', end - line));
+	return newline ? newline : end;
+}
+
+struct ObjChunk
+{
+	const char* Begin;
+	const char* End;
+	size_t FirstVertex = 0;
+	size_t VertexCount = 0;
+};
+
+bool ParseObj(const char* text, size_t size, DynamicArray<Vertex>& vertices)
+{
+	vertices.Clear();
+	const char* end = text + size;
+
+	// Chunks always end just after a '\n', so no line is split between two of them
+	std::vector<ObjChunk> chunks;
+	for (const char* begin = text; begin < end;)
+	{
+		const char* chunkEnd = end;
+		if ((size_t)(end - begin) > s_ObjChunkSize)
+		{
+			chunkEnd = LineEnd(begin + s_ObjChunkSize, end);
+			if (chunkEnd < end)
+				chunkEnd++;
+		}
+		chunks.push_back({ begin, chunkEnd });
+		begin = chunkEnd;
+	}
+
+	JobSystem::Get().ParallelFor(chunks.size(), 1, [&](size_t begin, size_t end)
+	{
+		for (size_t i = begin; i < end; i++)
+		{
+			ObjChunk& chunk = chunks[i];
+			size_t count = 0;
+			for (const char* line = chunk.Begin; line < chunk.End;)
+			{
+				const char* lineEnd = LineEnd(line, chunk.End);
+				count += FindPosition(line, lineEnd) != nullptr;
+				line = lineEnd + 1;
+			}
+			chunk.VertexCount = count;
+		}
+	});
+
+	size_t total = 0;
+	for (ObjChunk& chunk : chunks)
+	{
+		chunk.FirstVertex = total;
+		total += chunk.VertexCount;
+	}
+	vertices.ResizeUninitialized(total);
+
+	std::atomic<bool> failed{ false };
+	JobSystem::Get().ParallelFor(chunks.size(), 1, [&](size_t begin, size_t end)
+	{
+		for (size_t i = begin; i < end; i++)
+		{
+			const ObjChunk& chunk = chunks[i];
+			Vertex* vertex = vertices.Data() + chunk.FirstVertex;
+			for (const char* line = chunk.Begin; line < chunk.End;)
+			{
+				const char* lineEnd = LineEnd(line, chunk.End);
+				if (const char* p = FindPosition(line, lineEnd))
+				{
+					// Every position line the first pass counted gets written, even a broken one, so no vertex is left uninitialised
+					float position[3] = {};
+					for (float& coordinate : position)
+					{
+						while (p < lineEnd && IsSpace(*p))
+							p++;
+						p = ReadFloat(p, lineEnd, coordinate);
+						if (!p)
+						{
+							failed.store(true, std::memory_order_relaxed);
+							break;
+						}
+					}
+					*vertex++ = Vertex(position[0], position[1], position[2]);
+				}
+				line = lineEnd + 1;
+			}
+		}
+	});
+
+	if (failed)
+	{
+		vertices.Clear();
+		return false;
+	}
+	return true;
+}
+
+bool LoadObj(const char* path, DynamicArray<Vertex>& vertices)
+{
+	vertices.Clear();
+	MappedFile file(path);
+	if (!file.IsOpen())
+		return false;
+	return ParseObj(file.Data(), file.Size(), vertices);
+}
+
+enum class PlyType { None, Float, Double, Other };
+
+struct PlyProperty
+{
+	PlyType Type;
+	size_t Size;
+};
+
+struct PlyElement
+{
+	std::string_view Name;
+	size_t Count = 0;
+	size_t Stride = 0;
+	bool HasList = false;	// Then every one can be a different size
+	size_t Offsets[3] = {};	// Of x, y and z
+	PlyType Types[3] = { PlyType::None, PlyType::None, PlyType::None };
+};
+
+static bool ReadPlyType(std::string_view name, PlyProperty& property)
+{
+	static const struct { const char* Name; PlyType Type; size_t Size; } s_Types[] =
+	{
+		{ "char", PlyType::Other, 1 }, { "uchar", PlyType::Other, 1 }, { "int8", PlyType::Other, 1 }, { "uint8", PlyType::Other, 1 },
+		{ "short", PlyType::Other, 2 }, { "ushort", PlyType::Other, 2 }, { "int16", PlyType::Other, 2 }, { "uint16", PlyType::Other, 2 },
+		{ "int", PlyType::Other, 4 }, { "uint", PlyType::Other, 4 }, { "int32", PlyType::Other, 4 }, { "uint32", PlyType::Other, 4 },
+		{ "float", PlyType::Float, 4 }, { "float32", PlyType::Float, 4 }, { "double", PlyType::Double, 8 }, { "float64", PlyType::Double, 8 },
+	};
+	for (const auto& type : s_Types)
+	{
+		if (name == type.Name)
+		{
+			property = { type.Type, type.Size };
+			return true;
+		}
+	}
+	return false;
+}
+
+// The words of a header line
+static size_t SplitWords(std::string_view line, std::string_view* words, size_t maxWords)
+{
+	size_t count = 0;
+	size_t i = 0;
+	while (count < maxWords)
+	{
+		while (i < line.size() && (IsSpace(line[i]) || line[i] == '\r'))
+			i++;
+		if (i == line.size())
+			break;
+		size_t start = i;
+		while (i < line.size() && !IsSpace(line[i]) && line[i] != '\r')
+			i++;
+		words[count++] = line.substr(start, i - start);
+	}
+	return count;
+}
+
+template<typename T>
+static T ReadValue(const char* p, bool swap)
+{
+	unsigned char bytes[sizeof(T)];
+	memcpy(bytes, p, sizeof(T));
+	if (swap)
+		std::reverse(bytes, bytes + sizeof(T));
+	T value;
+	memcpy(&value, bytes, sizeof(T));
+	return value;
+}
+
+bool ParsePly(const char* data, size_t size, DynamicArray<Vertex>& vertices)
+{
+	vertices.Clear();
+	std::string_view text(data, size);
+	if (text.substr(0, 4) != "ply\n" && text.substr(0, 5) != "ply\r\n")
+		return false;
+
+	bool bigEndian = false;
+	bool gotFormat = false;
+	std::vector<PlyElement> elements;
+	size_t position = 0;
+	size_t bodyStart = 0;
+	while (bodyStart == 0)
+	{
+		size_t newline = text.find('\n', position);
+		if (newline == std::string_view::npos)
+			return false;
+		std::string_view line = text.substr(position, newline - position);
+		position = newline + 1;
+
+		std::string_view words[5];
+		size_t wordCount = SplitWords(line, words, 5);
+		if (wordCount == 0 || words[0] == "comment" || words[0] == "obj_info" || words[0] == "ply")
+			continue;
+
+		if (words[0] == "format" && wordCount >= 2)
+		{
+			if (words[1] == "binary_big_endian")
+				bigEndian = true;
+			else if (words[1] != "binary_little_endian")
+				return false;
+			gotFormat = true;
+		}
+		else if (words[0] == "element" && wordCount >= 3)
+		{
+			PlyElement element;
+			element.Name = words[1];
+			if (std::from_chars(words[2].data(), words[2].data() + words[2].size(), element.Count).ec != std::errc())
+				return false;
+			elements.push_back(element);
+		}
+		else if (words[0] == "property" && wordCount >= 3 && !elements.empty())
+		{
+			PlyElement& element = elements.back();
+			if (words[1] == "list")
+			{
+				element.HasList = true;
+				continue;
+			}
+			PlyProperty property;
+			if (!ReadPlyType(words[1], property))
+				return false;
+			const char* names[3] = { "x", "y", "z" };
+			for (int axis = 0; axis < 3; axis++)
+			{
+				if (words[2] == names[axis])
+				{
+					element.Offsets[axis] = element.Stride;
+					element.Types[axis] = property.Type;
+				}
+			}
+			element.Stride += property.Size;
+		}
+		else if (words[0] == "end_header")
+			bodyStart = position;
+		else
+			return false;
+	}
+	if (!gotFormat)
+		return false;
+
+	// The elements are stored one after the other, so everything before the vertices has to be skipped. That only works if none of it has lists
+	const char* body = data + bodyStart;
+	size_t bodySize = size - bodyStart;
+	const PlyElement* vertexElement = nullptr;
+	size_t offset = 0;
+	for (const PlyElement& element : elements)
+	{
+		if (element.Name == "vertex")
+		{
+			vertexElement = &element;
+			break;
+		}
+		if (element.HasList || (element.Stride != 0 && element.Count > (bodySize - offset) / element.Stride))
+			return false;
+		offset += element.Count * element.Stride;
+	}
+	if (!vertexElement || vertexElement->HasList)
+		return false;
+	const PlyElement& element = *vertexElement;
+	for (PlyType type : element.Types)
+	{
+		if (type != PlyType::Float && type != PlyType::Double)
+			return false;
+	}
+	if (offset > bodySize || element.Count > (bodySize - offset) / std::max<size_t>(element.Stride, 1))
+		return false;
+	const char* source = body + offset;
+
+	const uint16_t one = 1;
+	bool swap = bigEndian == (*reinterpret_cast<const unsigned char*>(&one) == 1);
+	bool packed = !swap && element.Stride == sizeof(Vertex) && element.Offsets[0] == 0 && element.Offsets[1] == 4 && element.Offsets[2] == 8 &&
+		element.Types[0] == PlyType::Float && element.Types[1] == PlyType::Float && element.Types[2] == PlyType::Float;
+
+	vertices.ResizeUninitialized(element.Count);
+	size_t chunkCount = (element.Count + s_PlyChunkVertices - 1) / s_PlyChunkVertices;
+	JobSystem::Get().ParallelFor(chunkCount, 1, [&](size_t begin, size_t end)
+	{
+		size_t first = begin * s_PlyChunkVertices;
+		size_t last = std::min(end * s_PlyChunkVertices, element.Count);
+		if (packed)
+		{
+			memcpy(static_cast<void*>(vertices.Data() + first), source + first * sizeof(Vertex), (last - first) * sizeof(Vertex));
+			return;
+		}
+		for (size_t i = first; i < last; i++)
+		{
+			const char* p = source + i * element.Stride;
+			float position[3];
+			for (int axis = 0; axis < 3; axis++)
+			{
+				const char* value = p + element.Offsets[axis];
+				position[axis] = element.Types[axis] == PlyType::Float ? ReadValue<float>(value, swap) : (float)ReadValue<double>(value, swap);
+			}
+			vertices[i] = Vertex(position[0], position[1], position[2]);
+		}
+	});
+	return true;
+}
+
+bool LoadPly(const char* path, DynamicArray<Vertex>& vertices)
+{
+	vertices.Clear();
+	MappedFile file(path);
+	if (!file.IsOpen())
+		return false;
+	return ParsePly(file.Data(), file.Size(), vertices);
+}
@@ -0,0 +1,25 @@
+#pragma once
+
+#include <cstddef>
+
+#include "DynamicArray.h"
+#include "Vertex.h"
+
+// Loading the vertex positions of big meshes (gigabytes of them) from OBJ and binary PLY files
+// The file is memory mapped (MappedFile.h) instead of read through a stream, and cut into chunks that the JobSystem's threads work on at the same time
+// Every vertex is written straight to its final place in the array, which is sized once up front. Nothing is pushed back one at a time, and nothing is copied again
+//
+// OBJ is text, so it takes two passes: the first counts the "v" lines in every chunk, which tells every chunk where its vertices start,
+// and the second reads the numbers with ReadFloat (TextToFloat.h)
+// Binary PLY already says how many vertices there are in its header, so the vertices are just copied out (with a single memcpy when they are exactly x, y, z floats)
+//
+// Only the positions are loaded. Normals, texture coordinates, colours and faces are skipped
+// Each returns false if the file can't be opened or isn't what it should be. vertices is left empty then
+
+bool LoadObj(const char* path, DynamicArray<Vertex>& vertices);
+// The same for an OBJ file that is already in memory
+bool ParseObj(const char* text, size_t size, DynamicArray<Vertex>& vertices);
+
+// binary_little_endian and binary_big_endian, with x, y and z in the vertex element as float or double. ascii PLY is not supported
+bool LoadPly(const char* path, DynamicArray<Vertex>& vertices);
+bool ParsePly(const char* data, size_t size, DynamicArray<Vertex>& vertices);
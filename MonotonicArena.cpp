@@ -0,0 +1,36 @@
+#include "MonotonicArena.h"
+
+MonotonicArena::MonotonicArena(size_t blockSize)
+	: m_BlockSize(blockSize)
+{
+}
+
+void* MonotonicArena::AllocateFromNextBlock(size_t size, size_t alignment)
+{
+	size_t needed = size + alignment - 1;
+	if (needed > m_BlockSize)
+	{
+		m_LargeAllocations.emplace_back(new char[needed]);
+		m_BytesUsed += size;
+		return reinterpret_cast<char*>(((uintptr_t)m_LargeAllocations.back().get() + alignment - 1) & ~(uintptr_t)(alignment - 1));
+	}
+
+	// Blocks kept from before a Reset are used again in order
+	size_t next = m_Position ? m_CurrentBlock + 1 : 0;
+	if (next == m_Blocks.size())
+		m_Blocks.emplace_back(new char[m_BlockSize]);
+
+	m_CurrentBlock = next;
+	m_Position = m_Blocks[next].get();
+	m_End = m_Position + m_BlockSize;
+	return Allocate(size, alignment);
+}
+
+void MonotonicArena::Reset()
+{
+	m_LargeAllocations.clear();
+	m_CurrentBlock = 0;
+	m_Position = m_Blocks.empty() ? nullptr : m_Blocks[0].get();
+	m_End = m_Blocks.empty() ? nullptr : m_Position + m_BlockSize;
+	m_BytesUsed = 0;
+}
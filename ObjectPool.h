@@ -0,0 +1,108 @@
+#pragma once
+
+#include <cstddef>
+#include <memory>
+#include <new>
+#include <utility>
+#include <vector>
+
+#include "ScopedPtr.h"
+
+template<typename T>
+struct PoolDelete;
+
+// Hands out memory for objects of one type from big blocks, and takes it back to use again for the next one
+// Every slot is the same size, so a freed slot goes on the front of a list and the next Create() takes it from there, without asking new for anything
+// Unlike MonotonicArena, objects can be destroyed one at a time and in any order
+// The blocks are only freed when the pool is destroyed, and every object must have been destroyed before then
+template<typename T>
+class ObjectPool
+{
+private:
+	// While a slot is free its memory holds the next free slot, while it is in use it holds the object
+	union Slot
+	{
+		Slot* Next;
+		alignas(T) unsigned char Storage[sizeof(T)];
+	};
+
+	std::vector<std::unique_ptr<Slot[]>> m_Blocks;
+	Slot* m_FreeList = nullptr;
+	size_t m_SlotsPerBlock;
+	size_t m_LiveCount = 0;
+
+	void AddBlock()
+	{
+		Slot* block = new Slot[m_SlotsPerBlock];
+		m_Blocks.emplace_back(block);
+		// Linked front to back, so the slots are handed out in address order
+		for (size_t i = 0; i + 1 < m_SlotsPerBlock; i++)
+			block[i].Next = &block[i + 1];
+		block[m_SlotsPerBlock - 1].Next = m_FreeList;
+		m_FreeList = block;
+	}
+public:
+	explicit ObjectPool(size_t slotsPerBlock = 256)
+		: m_SlotsPerBlock(slotsPerBlock > 0 ? slotsPerBlock : 1)
+	{
+	}
+
+	ObjectPool(const ObjectPool&) = delete;
+	ObjectPool& operator=(const ObjectPool&) = delete;
+
+	template<typename... Args>
+	T* Create(Args&&... arguments)
+	{
+		if (!m_FreeList)
+			AddBlock();
+		Slot* slot = m_FreeList;
+		Slot* next = slot->Next;
+		m_FreeList = next;	// Taken off the list first, because the object is about to be built over Next
+		T* object;
+		try
+		{
+			object = new (slot->Storage) T(std::forward<Args>(arguments)...);
+		}
+		catch (...)
+		{
+			// The constructor may have written over Next before it threw, so the slot goes back on the list with its link written again
+			slot->Next = next;
+			m_FreeList = slot;
+			throw;
+		}
+		m_LiveCount++;
+		return object;
+	}
+
+	// object must have come from this pool's Create()
+	void Destroy(T* object)
+	{
+		object->~T();
+		Slot* slot = reinterpret_cast<Slot*>(object);
+		slot->Next = m_FreeList;
+		m_FreeList = slot;
+		m_LiveCount--;
+	}
+
+	// A ScopedPtr that gives the object back to this pool. It is two pointers big, because it has to remember which pool
+	template<typename... Args>
+	ScopedPtr<T, PoolDelete<T>> MakeScoped(Args&&... arguments);
+
+	size_t LiveCount() const { return m_LiveCount; }
+	size_t Capacity() const { return m_Blocks.size() * m_SlotsPerBlock; }
+};
+
+template<typename T>
+struct PoolDelete
+{
+	ObjectPool<T>* Pool = nullptr;
+
+	void operator()(T* object) const { Pool->Destroy(object); }
+};
+
+template<typename T>
+template<typename... Args>
+ScopedPtr<T, PoolDelete<T>> ObjectPool<T>::MakeScoped(Args&&... arguments)
+{
+	return ScopedPtr<T, PoolDelete<T>>(Create(std::forward<Args>(arguments)...), PoolDelete<T>{ this });
+}
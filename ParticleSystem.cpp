@@ -0,0 +1,176 @@
+#include "ParticleSystem.h"
+
+#include <cassert>
+
+#include "JobSystem.h"
+#include "LookupTables.h"
+#include "Simd.h"
+
+ParticleSystem::ParticleSystem(size_t capacity)
+	: m_PositionX(capacity), m_PositionY(capacity), m_VelocityX(capacity), m_VelocityY(capacity), m_Lifetime(capacity)
+{
+}
+
+bool ParticleSystem::Spawn(const Vector2& position, const Vector2& velocity, float lifetime)
+{
+	if (m_Size == Capacity())
+		return false;
+
+	m_PositionX[m_Size] = position.x;
+	m_PositionY[m_Size] = position.y;
+	m_VelocityX[m_Size] = velocity.x;
+	m_VelocityY[m_Size] = velocity.y;
+	m_Lifetime[m_Size] = lifetime;
+	m_Size++;
+	return true;
+}
+
+void ParticleSystem::Kill(size_t index)
+{
+	assert(index < m_Size);
+	size_t last = --m_Size;
+	m_PositionX[index] = m_PositionX[last];
+	m_PositionY[index] = m_PositionY[last];
+	m_VelocityX[index] = m_VelocityX[last];
+	m_VelocityY[index] = m_VelocityY[last];
+	m_Lifetime[index] = m_Lifetime[last];
+}
+
+// Steps one xorshift generator, which is just a few shifts and xors, and returns a random number below range
+static uint32_t NextRandom(uint32_t& random, uint32_t range)
+{
+	random ^= random << 13;
+	random ^= random >> 17;
+	random ^= random << 5;
+	return (uint32_t)(((uint64_t)random * range) >> 32);	// Scales instead of %, which would be a division
+}
+
+// The same for 4 generators side by side. Each line does all 4, so the compiler can turn them into SIMD integer instructions
+static void NextRandom4(uint32_t random[4], uint32_t range, uint32_t values[4])
+{
+	for (int lane = 0; lane < 4; lane++)
+		random[lane] ^= random[lane] << 13;
+	for (int lane = 0; lane < 4; lane++)
+		random[lane] ^= random[lane] >> 17;
+	for (int lane = 0; lane < 4; lane++)
+		random[lane] ^= random[lane] << 5;
+	for (int lane = 0; lane < 4; lane++)
+		values[lane] = (uint32_t)(((uint64_t)random[lane] * range) >> 32);
+}
+
+size_t ParticleSystem::Emit(size_t count, const Vector2& position, uint8_t direction, uint8_t spread, float speed, float lifetime)
+{
+	if (count > Capacity() - m_Size)
+		count = Capacity() - m_Size;
+
+	// The new particles are one block at the end of every array, so they are written 4 at a time like Integrate() does
+	// Each of the 4 has its own generator: with one, every random number would have to wait for the one before it
+	float* px = m_PositionX.data();
+	float* py = m_PositionY.data();
+	float* vx = m_VelocityX.data();
+	float* vy = m_VelocityY.data();
+	float* life = m_Lifetime.data();
+
+	Float4 x = SimdSplat(position.x);
+	Float4 y = SimdSplat(position.y);
+	Float4 speed4 = SimdSplat(speed);
+	Float4 lifetime4 = SimdSplat(lifetime);
+	uint32_t range = 2u * spread + 1u;
+	uint8_t lowest = (uint8_t)(direction - spread);
+	uint32_t random[4] = { m_Random[0], m_Random[1], m_Random[2], m_Random[3] };
+
+	size_t i = m_Size;
+	size_t end = m_Size + count;
+	for (; i + 4 <= end; i += 4)
+	{
+		uint32_t values[4];
+		NextRandom4(random, range, values);
+		// Not through an array: writing it one Vector2 at a time and reading it back as a whole register would stall
+		Vector2 a = Direction((uint8_t)(lowest + values[0]));
+		Vector2 b = Direction((uint8_t)(lowest + values[1]));
+		Vector2 c = Direction((uint8_t)(lowest + values[2]));
+		Vector2 d = Direction((uint8_t)(lowest + values[3]));
+		SimdStore(px + i, x);
+		SimdStore(py + i, y);
+		SimdStore(vx + i, SimdSet(a.x, b.x, c.x, d.x) * speed4);
+		SimdStore(vy + i, SimdSet(a.y, b.y, c.y, d.y) * speed4);
+		SimdStore(life + i, lifetime4);
+	}
+
+	for (int lane = 0; i < end; i++, lane++)
+	{
+		Vector2 velocity = Direction((uint8_t)(lowest + NextRandom(random[lane], range))) * speed;
+		px[i] = position.x;
+		py[i] = position.y;
+		vx[i] = velocity.x;
+		vy[i] = velocity.y;
+		life[i] = lifetime;
+	}
+	for (int lane = 0; lane < 4; lane++)
+		m_Random[lane] = random[lane];
+	m_Size = end;
+	return count;
+}
+
+// The same maths as the scalar loop at the end, 4 particles at a time
+void ParticleSystem::Integrate(size_t begin, size_t end, float deltaTime, Vector2 gravity)
+{
+	float* px = m_PositionX.data();
+	float* py = m_PositionY.data();
+	float* vx = m_VelocityX.data();
+	float* vy = m_VelocityY.data();
+	float* life = m_Lifetime.data();
+
+	Float4 dt = SimdSplat(deltaTime);
+	Float4 gx = SimdSplat(gravity.x * deltaTime);
+	Float4 gy = SimdSplat(gravity.y * deltaTime);
+	size_t i = begin;
+	for (; i + 4 <= end; i += 4)
+	{
+		Float4 newVx = SimdLoad(vx + i) + gx;
+		Float4 newVy = SimdLoad(vy + i) + gy;
+		SimdStore(vx + i, newVx);
+		SimdStore(vy + i, newVy);
+		SimdStore(px + i, SimdLoad(px + i) + newVx * dt);
+		SimdStore(py + i, SimdLoad(py + i) + newVy * dt);
+		SimdStore(life + i, SimdLoad(life + i) - dt);
+	}
+
+	Vector2 gravityStep = gravity * deltaTime;
+	for (; i < end; i++)
+	{
+		Vector2 velocity = Vector2(vx[i], vy[i]) + gravityStep;
+		Vector2 position = Vector2(px[i], py[i]) + velocity * deltaTime;
+		vx[i] = velocity.x;
+		vy[i] = velocity.y;
+		px[i] = position.x;
+		py[i] = position.y;
+		life[i] -= deltaTime;
+	}
+}
+
+void ParticleSystem::Update(float deltaTime, const Vector2& gravity, size_t maxThreads)
+{
+	// Chunks are multiples of 4, so only the very last one has a scalar leftover
+	JobSystem::Get().ParallelFor(m_Size, 16384, [&](size_t begin, size_t end)
+	{
+		Integrate(begin, end, deltaTime, gravity);
+	}, maxThreads);
+
+	// Killing moves the last particle into index, which hasn't been checked yet, so index stays where it is
+	for (size_t i = 0; i < m_Size;)
+	{
+		if (m_Lifetime[i] <= 0.0f)
+			Kill(i);
+		else
+			i++;
+	}
+}
+
+void ParticleEmitter::Update(ParticleSystem& system, float deltaTime)
+{
+	Accumulated += Rate * deltaTime;
+	size_t count = (size_t)Accumulated;
+	Accumulated -= (float)count;
+	system.Emit(count, Position, Direction, Spread, Speed, Lifetime);
+}
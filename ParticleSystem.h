@@ -0,0 +1,62 @@
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+#include <vector>
+
+#include "Vector.h"
+
+// Lots of short-lived particles (sparks, smoke, ...) moved with the same Vector2 maths as pos + speed * powerup
+// The particles are stored as separate arrays (SoA): all x positions next to each other, then all y positions, and so on
+// Updating reads every array from start to end, and 4 particles fit in one SIMD register, instead of picking single floats out of a struct
+// The live particles are always the first Size() entries, so there are no holes to skip:
+// spawning writes to the end, and killing moves the last particle into the hole (swap-remove), both O(1)
+// Particles don't keep their index, it changes when another one is killed
+class ParticleSystem
+{
+private:
+	std::vector<float> m_PositionX, m_PositionY;
+	std::vector<float> m_VelocityX, m_VelocityY;
+	std::vector<float> m_Lifetime;	// Seconds left. A particle dies once this reaches 0
+	size_t m_Size = 0;
+	uint32_t m_Random[4] = { 0x12345678, 0x9e3779b9, 0x7f4a7c15, 0x2545f491 };	// One xorshift generator for each of the 4 particles Emit() makes at a time
+
+	void Integrate(size_t begin, size_t end, float deltaTime, Vector2 gravity);
+public:
+	// The arrays are allocated once, for the most particles there will ever be at the same time
+	explicit ParticleSystem(size_t capacity);
+
+	size_t Size() const { return m_Size; }
+	size_t Capacity() const { return m_PositionX.size(); }
+
+	// Returns false when the system is full
+	bool Spawn(const Vector2& position, const Vector2& velocity, float lifetime);
+	void Kill(size_t index);
+	void Clear() { m_Size = 0; }
+
+	// count particles at position, flying out in random directions within spread radians either side of direction
+	// Directions come from the compile-time table in LookupTables.h, so no sin or cos is called. Returns how many fit
+	size_t Emit(size_t count, const Vector2& position, uint8_t direction, uint8_t spread, float speed, float lifetime);
+
+	// velocity += gravity * deltaTime, position += velocity * deltaTime, lifetime -= deltaTime, then removes the particles that died
+	// The moving is split over the threads of the JobSystem (maxThreads limits that, 0 means all of them). Removing dead ones runs on this thread
+	void Update(float deltaTime, const Vector2& gravity, size_t maxThreads = 0);
+
+	Vector2 GetPosition(size_t index) const { return Vector2(m_PositionX[index], m_PositionY[index]); }
+	Vector2 GetVelocity(size_t index) const { return Vector2(m_VelocityX[index], m_VelocityY[index]); }
+	float GetLifetime(size_t index) const { return m_Lifetime[index]; }
+};
+
+// Spawns particles at a steady rate, however long each frame is
+struct ParticleEmitter
+{
+	Vector2 Position;
+	uint8_t Direction = 64;		// Straight up, see Direction() in LookupTables.h
+	uint8_t Spread = 16;		// About 22 degrees either side
+	float Speed = 1.0f;
+	float Lifetime = 1.0f;
+	float Rate = 100.0f;		// Particles per second
+	float Accumulated = 0.0f;	// Fractions of a particle left over from earlier frames
+
+	void Update(ParticleSystem& system, float deltaTime);
+};
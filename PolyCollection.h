@@ -0,0 +1,150 @@
+#pragma once
+
+#include <cstdint>
+#include <memory>
+#include <type_traits>
+#include <utility>
+#include <vector>
+
+#include "TypeName.h"
+
+// A container for polymorphic objects that keeps every concrete type in its own contiguous array (a "segment")
+// With a std::vector<Base*> every element is a separate heap allocation somewhere in memory, and the type changes randomly from one element to the next
+// Here we walk one segment at a time, so the memory is read in order and every virtual call in a segment goes to the same function, which the branch predictor loves
+// The order things were inserted in is not kept, only the order within each type
+// Adding to a segment can move its elements, just like std::vector, so don't hold on to references while inserting
+template<typename Base>
+class PolyCollection
+{
+private:
+	class SegmentBase
+	{
+	public:
+		uint64_t Type;
+
+		SegmentBase(uint64_t type)
+			: Type(type) {}
+		virtual ~SegmentBase() = default;
+
+		virtual Base* First() = 0;
+		virtual size_t Size() const = 0;
+		virtual size_t Stride() const = 0;	// The distance in bytes from one element to the next
+		virtual void Clear() = 0;
+	};
+
+	template<typename T>
+	class Segment : public SegmentBase
+	{
+	public:
+		std::vector<T> Elements;
+
+		Segment()
+			: SegmentBase(TypeHash<T>()) {}
+
+		Base* First() override { return Elements.data(); }
+		size_t Size() const override { return Elements.size(); }
+		size_t Stride() const override { return sizeof(T); }
+		void Clear() override { Elements.clear(); }
+	};
+
+	std::vector<std::unique_ptr<SegmentBase>> m_Segments;	// Only a handful of types, so searching this is faster than a map
+public:
+	// T has to be the exact type of the object, passing a derived object as its base class would slice it
+	template<typename T>
+	std::decay_t<T>& Insert(T&& value)
+	{
+		return GetSegment<std::decay_t<T>>().Elements.emplace_back(std::forward<T>(value));
+	}
+
+	// Constructs the object right inside its segment
+	template<typename T, typename... Args>
+	T& Emplace(Args&&... args)
+	{
+		return GetSegment<T>().Elements.emplace_back(std::forward<Args>(args)...);
+	}
+
+	template<typename T>
+	void Reserve(size_t count)
+	{
+		GetSegment<T>().Elements.reserve(count);
+	}
+
+	size_t Size() const
+	{
+		size_t size = 0;
+		for (const std::unique_ptr<SegmentBase>& segment : m_Segments)
+			size += segment->Size();
+		return size;
+	}
+
+	template<typename T>
+	size_t Size() const
+	{
+		for (const std::unique_ptr<SegmentBase>& segment : m_Segments)
+		{
+			if (segment->Type == TypeHash<T>())
+				return segment->Size();
+		}
+		return 0;
+	}
+
+	size_t SegmentCount() const { return m_Segments.size(); }
+
+	void Clear()
+	{
+		for (std::unique_ptr<SegmentBase>& segment : m_Segments)
+			segment->Clear();
+	}
+
+	// Calls func(Base&) for every element, one segment after the other
+	// If types are given, like ForEach<A, B>(func), every segment of one of those types gets func(T&) with the real type instead
+	// Calls through a T& to a method T overrides can be made without the vtable (obj.T::Method()), or are devirtualized for us if T is final
+	template<typename... Ts, typename F>
+	void ForEach(F&& func)
+	{
+		for (std::unique_ptr<SegmentBase>& segment : m_Segments)
+		{
+			if (!(ForEachInSegmentAs<Ts>(*segment, func) || ...))
+				ForEachInSegment(*segment, func);
+		}
+	}
+private:
+	template<typename T>
+	Segment<T>& GetSegment()
+	{
+		static_assert(std::is_base_of_v<Base, T>, "PolyCollection can only hold types derived from its base");
+
+		for (std::unique_ptr<SegmentBase>& segment : m_Segments)
+		{
+			if (segment->Type == TypeHash<T>())
+				return static_cast<Segment<T>&>(*segment);
+		}
+		m_Segments.push_back(std::make_unique<Segment<T>>());
+		return static_cast<Segment<T>&>(*m_Segments.back());
+	}
+
+	// Every element in a segment has the same type, so the Base part of each one is exactly Stride() bytes after the previous one
+	template<typename F>
+	static void ForEachInSegment(SegmentBase& segment, F& func)
+	{
+		size_t size = segment.Size();
+		if (size == 0)
+			return;
+
+		char* element = reinterpret_cast<char*>(segment.First());
+		size_t stride = segment.Stride();
+		for (size_t i = 0; i < size; i++, element += stride)
+			func(*reinterpret_cast<Base*>(element));
+	}
+
+	template<typename T, typename F>
+	static bool ForEachInSegmentAs(SegmentBase& segment, F& func)
+	{
+		if (segment.Type != TypeHash<T>())
+			return false;
+
+		for (T& element : static_cast<Segment<T>&>(segment).Elements)
+			func(element);
+		return true;
+	}
+};
@@ -0,0 +1,67 @@
+#pragma once
+
+#include <string>
+#include <string_view>
+
+#include "TypeName.h"
+
+// Virtual functions and polymorphism
+// BaseClass* baseClassObject = new PlainClass();
+// InheritingClass* inheritingObject = new InheritingClass("Cherno");
+// cout << baseClassObject->GetName() << endl;    // Prints "BaseClass"
+// cout << inheritingObject->GetName() << endl;    // Prints "Cherno"
+
+// However, if GetName() was not virtual and we created the InheritingClass object to a BaseClass pointer like this:
+// BaseClass* newBase = inheritingObject;
+// cout << newBase->GetName(); // Prints "BaseClass" eventough I am refering to an inheritingClass object.
+
+// This is an interface
+class Printable // BaseClass and thus also InheritingClass inherit from Printable
+{
+public:
+	virtual ~Printable() = default;	// Anything deleted through a Printable* needs a virtual destructor, otherwise only ~Printable() would run
+
+	// Returning a std::string_view instead of a std::string means nothing gets allocated or copied just to read a name
+	virtual std::string_view GetClassName() = 0; // This is a pure virtual function
+};
+
+class BaseClass : public Printable
+{
+public:
+	virtual std::string_view GetName()   // The above problem can be fixed by making this a virtual method
+	{
+		return TypeName<BaseClass>();
+	}
+	// Pure virtual function (Interface or abstract Method)
+	// Allows us to define a method in a base class withoug an implementation and force derived classes to create the definition
+	virtual std::string PureVirtualMethodExample() = 0;   // The '= 0;' makes it a pure virtual function
+
+	std::string_view GetClassName() override { return TypeName<BaseClass>(); }
+};
+
+// BaseClass is abstract because of PureVirtualMethodExample(), so this is the smallest class we can actually create that still behaves like a BaseClass
+class PlainClass : public BaseClass
+{
+public:
+	std::string PureVirtualMethodExample() override { return "PlainClass"; }
+};
+
+class InheritingClass : public BaseClass    // you can add a comma and any other classes it shoud inherit from
+{
+private:
+	std::string m_Name;
+public:
+	InheritingClass(const std::string& name)
+	{
+		m_Name = name;
+	}
+
+	std::string_view GetName() override  // Because this is a virtual method being overridden, we need to make it an override
+	{
+		return m_Name;  // Only valid for as long as this object is alive
+	}
+
+	std::string PureVirtualMethodExample() override { return "InheritingClass"; }
+
+	std::string_view GetClassName() override { return TypeName<InheritingClass>(); }
+};
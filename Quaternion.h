@@ -0,0 +1,101 @@
+#pragma once
+
+#include <cmath>
+#include <iostream>
+
+#include "Matrix.h"
+#include "Vector.h"
+
+// Rotations in 3D
+// A quaternion stores a rotation of angle a around an axis as (axis * sin(a / 2), cos(a / 2))
+// Unlike three angles it has no gimbal lock, two rotations can be combined by multiplying, and it can be smoothly blended with Slerp
+struct Quaternion
+{
+	float x, y, z, w;
+
+	// No rotation
+	constexpr Quaternion()
+		: x(0.0f), y(0.0f), z(0.0f), w(1.0f) {}
+	constexpr Quaternion(float x, float y, float z, float w)
+		: x(x), y(y), z(z), w(w) {}
+
+	// axis must have a length of 1. Anticlockwise when looking down the axis towards the origin, in radians
+	static Quaternion FromAxisAngle(const Vector3& axis, float radians)
+	{
+		float s = std::sin(radians * 0.5f);
+		return Quaternion(axis.x * s, axis.y * s, axis.z * s, std::cos(radians * 0.5f));
+	}
+
+	// Rotates by other first, then by this one (like matrices)
+	constexpr Quaternion operator*(const Quaternion& other) const
+	{
+		return Quaternion(
+			w * other.x + x * other.w + y * other.z - z * other.y,
+			w * other.y - x * other.z + y * other.w + z * other.x,
+			w * other.z + x * other.y - y * other.x + z * other.w,
+			w * other.w - x * other.x - y * other.y - z * other.z);
+	}
+
+	constexpr bool operator==(const Quaternion& other) const { return x == other.x && y == other.y && z == other.z && w == other.w; }
+	constexpr bool operator!=(const Quaternion& other) const { return !(*this == other); }
+};
+
+constexpr float Dot(const Quaternion& a, const Quaternion& b) { return a.x * b.x + a.y * b.y + a.z * b.z + a.w * b.w; }
+
+// The opposite rotation (for quaternions with a length of 1)
+constexpr Quaternion Conjugate(const Quaternion& q) { return Quaternion(-q.x, -q.y, -q.z, q.w); }
+
+// Rounding errors add up when many rotations are multiplied together, this brings the length back to 1
+constexpr Quaternion Normalize(const Quaternion& q)
+{
+	float length = Sqrt(Dot(q, q));
+	return length > 0.0f ? Quaternion(q.x / length, q.y / length, q.z / length, q.w / length) : Quaternion();
+}
+
+// q * v * q^-1, written out so it only needs two cross products: v + 2w(q x v) + 2(q x (q x v))
+constexpr Vector3 Rotate(const Quaternion& q, const Vector3& v)
+{
+	Vector3 axis(q.x, q.y, q.z);
+	Vector3 t = Cross(axis, v) * 2.0f;
+	return v + t * q.w + Cross(axis, t);
+}
+
+constexpr Matrix3 ToMatrix3(const Quaternion& q)
+{
+	float xx = q.x * q.x, yy = q.y * q.y, zz = q.z * q.z;
+	float xy = q.x * q.y, xz = q.x * q.z, yz = q.y * q.z;
+	float wx = q.w * q.x, wy = q.w * q.y, wz = q.w * q.z;
+	return Matrix3(
+		Vector3(1.0f - 2.0f * (yy + zz), 2.0f * (xy + wz), 2.0f * (xz - wy)),
+		Vector3(2.0f * (xy - wz), 1.0f - 2.0f * (xx + zz), 2.0f * (yz + wx)),
+		Vector3(2.0f * (xz + wy), 2.0f * (yz - wx), 1.0f - 2.0f * (xx + yy)));
+}
+
+// Blends between two rotations at a constant speed, taking the shorter way round
+inline Quaternion Slerp(const Quaternion& a, const Quaternion& b, float t)
+{
+	Quaternion end = b;
+	float cosAngle = Dot(a, b);
+	if (cosAngle < 0.0f)
+	{
+		// q and -q are the same rotation, but going to -q is the short way
+		end = Quaternion(-b.x, -b.y, -b.z, -b.w);
+		cosAngle = -cosAngle;
+	}
+
+	// Nearly the same rotation: sin(angle) would be close to 0, so blend in a straight line instead
+	if (cosAngle > 0.9995f)
+		return Normalize(Quaternion(a.x + (end.x - a.x) * t, a.y + (end.y - a.y) * t, a.z + (end.z - a.z) * t, a.w + (end.w - a.w) * t));
+
+	float angle = std::acos(cosAngle);
+	float sinAngle = std::sin(angle);
+	float weightA = std::sin((1.0f - t) * angle) / sinAngle;
+	float weightB = std::sin(t * angle) / sinAngle;
+	return Quaternion(a.x * weightA + end.x * weightB, a.y * weightA + end.y * weightB, a.z * weightA + end.z * weightB, a.w * weightA + end.w * weightB);
+}
+
+inline std::ostream& operator<<(std::ostream& stream, const Quaternion& q)
+{
+	stream << "(" << q.x << " | " << q.y << " | " << q.z << " | " << q.w << ")";
+	return stream;
+}
@@ -0,0 +1,379 @@
+#pragma once
+
+#include <atomic>
+#include <cstddef>
+#include <cstdint>
+#include <thread>
+#include <type_traits>
+#include <utility>
+
+// Reference counting where the count lives inside the object itself ("intrusive"), instead of in a separate control block like std::shared_ptr
+// A class opts in by deriving from RefCounted (or LocalRefCounted), and is then owned through Ref<T>
+//
+// Why it is cheaper than shared_ptr:
+//   A Ref is one pointer, not two, and there is no control block to allocate or to jump to when copying
+//   LocalRefCounted uses a plain count, not an atomic one, for objects that never leave one thread. shared_ptr always pays for the atomic
+//   A Ref can be made from a plain T* at any time (even from this inside a member function), because the count is always right there
+//
+// Ref only adds and removes references. The object is deleted as T when the last Ref goes, so a Ref<Base> to a Derived needs Base to have a virtual destructor
+// Objects must be made with new (MakeRef does that), and the count starts at 0 until the first Ref takes it
+//
+// Weak references (WeakRef) don't keep the object alive, and Lock() turns one back into a Ref if the object is still there
+// Most objects never have one, so the weak data is only allocated the first time a WeakRef is made. Objects without weak references pay for one null pointer
+template<bool ThreadSafe>
+class BasicRefCounted
+{
+private:
+	using Count = std::conditional_t<ThreadSafe, std::atomic<uint32_t>, uint32_t>;
+
+	// Shared by the object and its WeakRefs, and freed by whichever lets go of it last
+	// The object holds one reference to it as long as it is alive
+	struct WeakData
+	{
+		Count References{ 2 };	// The object and the WeakRef that made it
+		BasicRefCounted* Object;
+		std::atomic_flag Busy = ATOMIC_FLAG_INIT;	// Only used when ThreadSafe. Held by WeakRef::Lock() and by the object while it detaches
+
+		explicit WeakData(BasicRefCounted* object) : Object(object) {}
+
+		void AddReference()
+		{
+			if constexpr (ThreadSafe)
+				References.fetch_add(1, std::memory_order_relaxed);
+			else
+				References++;
+		}
+
+		void Release()
+		{
+			bool last;
+			if constexpr (ThreadSafe)
+				last = References.fetch_sub(1, std::memory_order_acq_rel) == 1;
+			else
+				last = --References == 0;
+			if (last)
+				delete this;
+		}
+
+		// A spin lock, because it is only ever held for a few instructions
+		void Lock()
+		{
+			if constexpr (ThreadSafe)
+			{
+				while (Busy.test_and_set(std::memory_order_acquire))
+					std::this_thread::yield();
+			}
+		}
+
+		void Unlock()
+		{
+			if constexpr (ThreadSafe)
+				Busy.clear(std::memory_order_release);
+		}
+	};
+
+	mutable Count m_References{ 0 };
+	mutable std::conditional_t<ThreadSafe, std::atomic<WeakData*>, WeakData*> m_Weak{ nullptr };
+
+	template<typename T>
+	friend class Ref;
+	template<typename T>
+	friend class WeakRef;
+
+	void AddReference() const
+	{
+		if constexpr (ThreadSafe)
+			m_References.fetch_add(1, std::memory_order_relaxed);	// We already hold a reference, so nothing can delete it while we add ours
+		else
+			m_References++;
+	}
+
+	// Only for an object no other thread can see yet, so a plain store is enough
+	void SetFirstReference() const
+	{
+		if constexpr (ThreadSafe)
+			m_References.store(1, std::memory_order_relaxed);
+		else
+			m_References = 1;
+	}
+
+	// True when that was the last reference, and the object has to be deleted
+	bool ReleaseReference() const
+	{
+		if constexpr (ThreadSafe)
+			return m_References.fetch_sub(1, std::memory_order_acq_rel) == 1;	// Acquire, so the thread that deletes it sees everything the others did with it
+		else
+			return --m_References == 0;
+	}
+
+	// Adds a reference only if there still is one. Used by WeakRef::Lock(), which must never bring an object back once its count has reached 0
+	bool AddReferenceIfAlive() const
+	{
+		if constexpr (ThreadSafe)
+		{
+			uint32_t count = m_References.load(std::memory_order_relaxed);
+			while (count != 0)
+			{
+				if (m_References.compare_exchange_weak(count, count + 1, std::memory_order_relaxed))
+					return true;
+			}
+			return false;
+		}
+		else
+		{
+			if (m_References == 0)
+				return false;
+			m_References++;
+			return true;
+		}
+	}
+
+	// Makes the weak data if there isn't any yet, and returns it with a reference for the caller
+	WeakData* GetWeakData() const
+	{
+		WeakData* weak = m_Weak;
+		if (weak)
+		{
+			weak->AddReference();
+			return weak;
+		}
+
+		weak = new WeakData(const_cast<BasicRefCounted*>(this));
+		if constexpr (ThreadSafe)
+		{
+			// Another thread may have made one at the same time. Then we use theirs
+			WeakData* existing = nullptr;
+			if (!m_Weak.compare_exchange_strong(existing, weak, std::memory_order_acq_rel))
+			{
+				delete weak;
+				existing->AddReference();
+				return existing;
+			}
+		}
+		else
+			m_Weak = weak;
+		return weak;
+	}
+protected:
+	BasicRefCounted() = default;
+	// A copy is a new object, with no references to it yet
+	BasicRefCounted(const BasicRefCounted&) {}
+	BasicRefCounted& operator=(const BasicRefCounted&) { return *this; }
+
+	// Not virtual, so the objects don't need a vtable. Ref deletes them as the type it points to
+	~BasicRefCounted()
+	{
+		if (WeakData* weak = m_Weak)
+		{
+			// A Lock() that is running right now finished before we get the lock (and couldn't add a reference, because the count is 0). Any later one sees nullptr
+			weak->Lock();
+			weak->Object = nullptr;
+			weak->Unlock();
+			weak->Release();
+		}
+	}
+public:
+	uint32_t UseCount() const
+	{
+		if constexpr (ThreadSafe)
+			return m_References.load(std::memory_order_relaxed);
+		else
+			return m_References;
+	}
+};
+
+using RefCounted = BasicRefCounted<true>;
+using LocalRefCounted = BasicRefCounted<false>;
+
+template<typename T>
+class WeakRef;
+
+// Owns one reference to a T, which derives from RefCounted or LocalRefCounted
+template<typename T>
+class Ref
+{
+private:
+	T* m_Object = nullptr;
+
+	template<typename U>
+	friend class Ref;
+	template<typename U>
+	friend class WeakRef;
+
+	void Release()
+	{
+		if (m_Object && m_Object->ReleaseReference())
+			delete m_Object;
+	}
+
+	struct AlreadyReferenced {};
+	Ref(T* object, AlreadyReferenced) : m_Object(object) {}
+
+	// For MakeRef, whose object no other thread can see yet
+	static Ref Adopt(T* object)
+	{
+		object->SetFirstReference();
+		return Ref(object, AlreadyReferenced{});
+	}
+
+	template<typename U, typename... Args>
+	friend Ref<U> MakeRef(Args&&... arguments);
+public:
+	Ref() = default;
+	Ref(std::nullptr_t) {}
+
+	explicit Ref(T* object)
+		: m_Object(object)
+	{
+		if (m_Object)
+			m_Object->AddReference();
+	}
+
+	Ref(const Ref& other)
+		: m_Object(other.m_Object)
+	{
+		if (m_Object)
+			m_Object->AddReference();
+	}
+
+	Ref(Ref&& other) noexcept
+		: m_Object(other.m_Object)
+	{
+		other.m_Object = nullptr;
+	}
+
+	template<typename U, typename = std::enable_if_t<std::is_convertible_v<U*, T*>>>
+	Ref(const Ref<U>& other)
+		: m_Object(other.m_Object)
+	{
+		if (m_Object)
+			m_Object->AddReference();
+	}
+
+	template<typename U, typename = std::enable_if_t<std::is_convertible_v<U*, T*>>>
+	Ref(Ref<U>&& other) noexcept
+		: m_Object(other.m_Object)
+	{
+		other.m_Object = nullptr;
+	}
+
+	~Ref() { Release(); }
+
+	// The new object gets its reference before the old one loses it, so assigning a Ref to itself (or to another Ref to the same object) is safe
+	Ref& operator=(const Ref& other)
+	{
+		if (other.m_Object)
+			other.m_Object->AddReference();
+		Release();
+		m_Object = other.m_Object;
+		return *this;
+	}
+
+	Ref& operator=(Ref&& other) noexcept
+	{
+		if (this != &other)
+		{
+			Release();
+			m_Object = other.m_Object;
+			other.m_Object = nullptr;
+		}
+		return *this;
+	}
+
+	Ref& operator=(std::nullptr_t)
+	{
+		Reset();
+		return *this;
+	}
+
+	void Reset()
+	{
+		Release();
+		m_Object = nullptr;
+	}
+
+	T* Get() const { return m_Object; }
+	T& operator*() const { return *m_Object; }
+	T* operator->() const { return m_Object; }
+	explicit operator bool() const { return m_Object != nullptr; }
+
+	uint32_t UseCount() const { return m_Object ? m_Object->UseCount() : 0; }
+
+	bool operator==(const Ref& other) const { return m_Object == other.m_Object; }
+	bool operator!=(const Ref& other) const { return m_Object != other.m_Object; }
+	bool operator==(std::nullptr_t) const { return m_Object == nullptr; }
+	bool operator!=(std::nullptr_t) const { return m_Object != nullptr; }
+};
+
+// new T(arguments...), with its first reference
+template<typename T, typename... Args>
+Ref<T> MakeRef(Args&&... arguments)
+{
+	return Ref<T>::Adopt(new T(std::forward<Args>(arguments)...));
+}
+
+// Points at an object without keeping it alive
+template<typename T>
+class WeakRef
+{
+private:
+	using WeakData = typename T::WeakData;
+
+	WeakData* m_Weak = nullptr;
+public:
+	WeakRef() = default;
+	WeakRef(std::nullptr_t) {}
+	WeakRef(const Ref<T>& ref) : m_Weak(ref ? ref->GetWeakData() : nullptr) {}
+
+	WeakRef(const WeakRef& other)
+		: m_Weak(other.m_Weak)
+	{
+		if (m_Weak)
+			m_Weak->AddReference();
+	}
+
+	WeakRef(WeakRef&& other) noexcept
+		: m_Weak(other.m_Weak)
+	{
+		other.m_Weak = nullptr;
+	}
+
+	~WeakRef()
+	{
+		if (m_Weak)
+			m_Weak->Release();
+	}
+
+	WeakRef& operator=(WeakRef other) noexcept
+	{
+		std::swap(m_Weak, other.m_Weak);
+		return *this;
+	}
+
+	// A Ref to the object, or an empty one if it has already been deleted
+	Ref<T> Lock() const
+	{
+		if (!m_Weak)
+			return nullptr;
+
+		m_Weak->Lock();
+		auto* object = m_Weak->Object;
+		bool alive = object && object->AddReferenceIfAlive();
+		m_Weak->Unlock();
+		if (!alive)
+			return nullptr;
+		return Ref<T>(static_cast<T*>(object), typename Ref<T>::AlreadyReferenced{});
+	}
+
+	// Only a hint when other threads hold Refs, since the last one could go right after this returns false
+	bool Expired() const
+	{
+		if (!m_Weak)
+			return true;
+
+		m_Weak->Lock();
+		bool expired = !m_Weak->Object || m_Weak->Object->UseCount() == 0;
+		m_Weak->Unlock();
+		return expired;
+	}
+};
@@ -0,0 +1,205 @@
+#pragma once
+
+#include <cstddef>
+#include <cstdlib>
+#include <new>
+#include <type_traits>
+#include <utility>
+
+#include "MonotonicArena.h"
+
+// A pointer that owns what it points to and gets rid of it when it goes out of scope, like std::unique_ptr
+// How it gets rid of it is up to the Deleter, so it can own arrays, memory from malloc, or objects that live in a pool or an arena
+//
+// A deleter with no members (all of the ones below, except PoolDelete) takes up no space: ScopedPtr inherits from it,
+// and C++ lets an empty base class share its address with the first member (the "empty base optimisation")
+// So ScopedPtr<Car> is exactly as big as a Car*, and calling the deleter compiles down to the same code as calling delete yourself
+// A deleter that does have members (a function pointer, or PoolDelete's pool) is stored next to the pointer
+//
+// ScopedPtr<T[]> owns an array, uses delete[] and has operator[] instead of ->
+
+// delete, or delete[] for arrays
+template<typename T>
+struct DefaultDelete
+{
+	DefaultDelete() = default;
+	// So that a ScopedPtr<Derived> can become a ScopedPtr<Base>
+	template<typename U, typename = std::enable_if_t<std::is_convertible_v<U*, T*>>>
+	DefaultDelete(const DefaultDelete<U>&) {}
+
+	void operator()(T* pointer) const { delete pointer; }
+};
+
+template<typename T>
+struct DefaultDelete<T[]>
+{
+	void operator()(T* pointer) const { delete[] pointer; }
+};
+
+// For memory from malloc. Only frees it: malloc never ran a constructor, so there is no destructor to run either
+struct FreeDelete
+{
+	void operator()(void* pointer) const { free(pointer); }
+};
+
+// For objects made in a MonotonicArena. Only runs the destructor, the memory comes back when the arena is reset
+template<typename T>
+struct ArenaDelete
+{
+	void operator()(T* pointer) const { pointer->~T(); }
+};
+
+namespace Detail
+{
+	// Holds the pointer and the deleter. The deleter is a base class when it is empty, so it takes up no space
+	// (final classes can't be inherited from, so those are stored as a member like any other)
+	template<typename Pointer, typename Deleter, bool Empty = std::is_empty_v<Deleter> && !std::is_final_v<Deleter>>
+	class ScopedPtrStorage : private Deleter
+	{
+	private:
+		Pointer m_Pointer;
+	public:
+		ScopedPtrStorage(Pointer pointer, Deleter deleter) : Deleter(std::move(deleter)), m_Pointer(pointer) {}
+
+		Pointer& GetPointer() { return m_Pointer; }
+		Pointer GetPointer() const { return m_Pointer; }
+		Deleter& GetDeleter() { return *this; }
+		const Deleter& GetDeleter() const { return *this; }
+	};
+
+	template<typename Pointer, typename Deleter>
+	class ScopedPtrStorage<Pointer, Deleter, false>
+	{
+	private:
+		Pointer m_Pointer;
+		Deleter m_Deleter;
+	public:
+		ScopedPtrStorage(Pointer pointer, Deleter deleter) : m_Pointer(pointer), m_Deleter(std::move(deleter)) {}
+
+		Pointer& GetPointer() { return m_Pointer; }
+		Pointer GetPointer() const { return m_Pointer; }
+		Deleter& GetDeleter() { return m_Deleter; }
+		const Deleter& GetDeleter() const { return m_Deleter; }
+	};
+}
+
+template<typename T, typename Deleter = DefaultDelete<T>>
+class ScopedPtr
+{
+public:
+	using Element = std::remove_extent_t<T>;
+private:
+	Detail::ScopedPtrStorage<Element*, Deleter> m_Storage;
+
+	template<typename U, typename E>
+	friend class ScopedPtr;
+public:
+	ScopedPtr() : m_Storage(nullptr, Deleter()) {}
+	ScopedPtr(std::nullptr_t) : m_Storage(nullptr, Deleter()) {}
+	explicit ScopedPtr(Element* pointer, Deleter deleter = Deleter()) : m_Storage(pointer, std::move(deleter)) {}
+
+	ScopedPtr(const ScopedPtr&) = delete;
+	ScopedPtr& operator=(const ScopedPtr&) = delete;
+
+	// noexcept, so std::vector moves them when it grows instead of trying to copy them
+	ScopedPtr(ScopedPtr&& other) noexcept
+		: m_Storage(other.Release(), std::move(other.GetDeleter()))
+	{
+	}
+
+	// A ScopedPtr<Derived> can become a ScopedPtr<Base>. Base needs a virtual destructor for the default deleter to destroy a Derived properly
+	template<typename U, typename E, typename = std::enable_if_t<!std::is_array_v<T> && std::is_convertible_v<U*, Element*> && std::is_convertible_v<E, Deleter>>>
+	ScopedPtr(ScopedPtr<U, E>&& other) noexcept
+		: m_Storage(other.Release(), std::move(other.GetDeleter()))
+	{
+	}
+
+	ScopedPtr& operator=(ScopedPtr&& other) noexcept
+	{
+		if (this != &other)
+		{
+			Reset(other.Release());
+			GetDeleter() = std::move(other.GetDeleter());
+		}
+		return *this;
+	}
+
+	template<typename U, typename E, typename = std::enable_if_t<!std::is_array_v<T> && std::is_convertible_v<U*, Element*> && std::is_convertible_v<E, Deleter>>>
+	ScopedPtr& operator=(ScopedPtr<U, E>&& other) noexcept
+	{
+		Reset(other.Release());
+		GetDeleter() = std::move(other.GetDeleter());
+		return *this;
+	}
+
+	ScopedPtr& operator=(std::nullptr_t)
+	{
+		Reset();
+		return *this;
+	}
+
+	~ScopedPtr()
+	{
+		if (Element* pointer = m_Storage.GetPointer())
+			m_Storage.GetDeleter()(pointer);
+	}
+
+	Element* Get() const { return m_Storage.GetPointer(); }
+	Deleter& GetDeleter() { return m_Storage.GetDeleter(); }
+	const Deleter& GetDeleter() const { return m_Storage.GetDeleter(); }
+
+	Element& operator*() const { return *Get(); }
+	Element* operator->() const { return Get(); }
+	Element& operator[](size_t index) const { return Get()[index]; }
+	explicit operator bool() const { return Get() != nullptr; }
+
+	// Stops owning the object and hands it back. Getting rid of it is now up to the caller
+	Element* Release()
+	{
+		Element* pointer = m_Storage.GetPointer();
+		m_Storage.GetPointer() = nullptr;
+		return pointer;
+	}
+
+	// Gets rid of the current object (if any) and owns pointer instead
+	void Reset(Element* pointer = nullptr)
+	{
+		Element* old = m_Storage.GetPointer();
+		m_Storage.GetPointer() = pointer;
+		if (old)
+			m_Storage.GetDeleter()(old);
+	}
+
+	void Swap(ScopedPtr& other)
+	{
+		std::swap(m_Storage, other.m_Storage);
+	}
+
+	bool operator==(std::nullptr_t) const { return Get() == nullptr; }
+	bool operator!=(std::nullptr_t) const { return Get() != nullptr; }
+};
+
+static_assert(sizeof(ScopedPtr<int>) == sizeof(int*), "An empty deleter must take up no space");
+static_assert(sizeof(ScopedPtr<int[]>) == sizeof(int*), "An empty deleter must take up no space");
+static_assert(sizeof(ScopedPtr<int, FreeDelete>) == sizeof(int*), "An empty deleter must take up no space");
+
+// new T(arguments...), owned straight away
+template<typename T, typename... Args>
+std::enable_if_t<!std::is_array_v<T>, ScopedPtr<T>> MakeScoped(Args&&... arguments)
+{
+	return ScopedPtr<T>(new T(std::forward<Args>(arguments)...));
+}
+
+// An array of count value initialised elements (0 for numbers)
+template<typename T>
+std::enable_if_t<std::is_array_v<T>, ScopedPtr<T>> MakeScoped(size_t count)
+{
+	return ScopedPtr<T>(new std::remove_extent_t<T>[count]());
+}
+
+// Makes a T in the arena. It must be destroyed before the arena is reset
+template<typename T, typename... Args>
+ScopedPtr<T, ArenaDelete<T>> MakeScopedIn(MonotonicArena& arena, Args&&... arguments)
+{
+	return ScopedPtr<T, ArenaDelete<T>>(new (arena.Allocate(sizeof(T), alignof(T))) T(std::forward<Args>(arguments)...));
+}
@@ -0,0 +1,208 @@
+#pragma once
+
+#include <atomic>
+#include <cstddef>
+#include <cstdint>
+#include <cstring>
+#include <iostream>
+#include <new>
+#include <string_view>
+#include <type_traits>
+
+#include "StringClass.h"
+
+// An immutable string whose characters are shared by all its copies
+// Copying StringClass copies every character. When the same name ends up in thousands of objects, that is thousands of identical buffers
+// Here a copy only copies a pointer and adds 1 to a reference count stored in front of the characters. The last copy to be destroyed frees them
+//
+// Copy on write: MutableData() and Append() first make their own copy of the characters if anyone else is still using them, so the other copies never see the change
+// ThreadSafe picks an atomic reference count (SharedString), so copies can be made and destroyed on different threads,
+// or a plain one (LocalSharedString), which is cheaper but only for strings that never leave one thread
+template<bool ThreadSafe>
+class BasicSharedString
+{
+private:
+	using RefCount = std::conditional_t<ThreadSafe, std::atomic<uint32_t>, uint32_t>;
+
+	// Lives at the start of the same allocation as the characters, which follow it
+	struct Header
+	{
+		RefCount References;
+		uint32_t Size;
+		uint32_t Capacity;	// Not counting the NULL termination character
+
+		char* Characters() { return reinterpret_cast<char*>(this + 1); }
+	};
+
+	Header* m_Header = nullptr;	// nullptr for the empty string, so it never allocates
+
+	static Header* Allocate(size_t capacity)
+	{
+		void* memory = ::operator new(sizeof(Header) + capacity + 1);
+		Header* header = new (memory) Header{ { 1 }, 0, (uint32_t)capacity };
+		return header;
+	}
+
+	static Header* Create(const char* string, size_t size, size_t capacity)
+	{
+		Header* header = Allocate(capacity);
+		memcpy(header->Characters(), string, size);
+		header->Characters()[size] = 0;
+		header->Size = (uint32_t)size;
+		return header;
+	}
+
+	void AddReference() const
+	{
+		if (!m_Header)
+			return;
+		if constexpr (ThreadSafe)
+			m_Header->References.fetch_add(1, std::memory_order_relaxed);	// We already hold a reference, so nothing can free it while we add ours
+		else
+			m_Header->References++;
+	}
+
+	void Release()
+	{
+		if (!m_Header)
+			return;
+
+		bool last;
+		if constexpr (ThreadSafe)
+			last = m_Header->References.fetch_sub(1, std::memory_order_acq_rel) == 1;	// Acquire, so the thread that frees it sees everything the others did with it
+		else
+			last = --m_Header->References == 0;
+
+		if (last)
+		{
+			m_Header->~Header();
+			::operator delete(m_Header);
+		}
+		m_Header = nullptr;
+	}
+
+	uint32_t References() const
+	{
+		if constexpr (ThreadSafe)
+			return m_Header->References.load(std::memory_order_acquire);
+		else
+			return m_Header->References;
+	}
+
+	// Makes sure we are the only user of the characters and there is room for capacity of them
+	void MakeUnique(size_t capacity)
+	{
+		if (m_Header && References() == 1 && capacity <= m_Header->Capacity)
+			return;
+
+		size_t size = Size();
+		Header* header = Create(Data(), size, capacity > size ? capacity : size);
+		Release();
+		m_Header = header;
+	}
+public:
+	BasicSharedString() = default;
+	BasicSharedString(const char* string)
+		: BasicSharedString(string, strlen(string)) {}
+	BasicSharedString(const char* string, size_t size)
+	{
+		if (size > 0)
+			m_Header = Create(string, size, size);
+	}
+	BasicSharedString(std::string_view string)
+		: BasicSharedString(string.data(), string.size()) {}
+	explicit BasicSharedString(const StringClass& string)
+		: BasicSharedString(string.Data(), string.Size()) {}
+
+	BasicSharedString(const BasicSharedString& other)
+		: m_Header(other.m_Header)
+	{
+		AddReference();
+	}
+
+	BasicSharedString(BasicSharedString&& other) noexcept
+		: m_Header(other.m_Header)
+	{
+		other.m_Header = nullptr;
+	}
+
+	BasicSharedString& operator=(const BasicSharedString& other)
+	{
+		Header* header = other.m_Header;
+		other.AddReference();	// Before Release, in case both are the same string
+		Release();
+		m_Header = header;
+		return *this;
+	}
+
+	BasicSharedString& operator=(BasicSharedString&& other) noexcept
+	{
+		if (this != &other)
+		{
+			Release();
+			m_Header = other.m_Header;
+			other.m_Header = nullptr;
+		}
+		return *this;
+	}
+
+	~BasicSharedString() { Release(); }
+
+	const char* Data() const { return m_Header ? m_Header->Characters() : ""; }
+	const char* CStr() const { return Data(); }
+	size_t Size() const { return m_Header ? m_Header->Size : 0; }
+	bool Empty() const { return Size() == 0; }
+	// How many strings share these characters (0 for the empty string)
+	size_t UseCount() const { return m_Header ? References() : 0; }
+
+	const char& operator[](size_t index) const { return Data()[index]; }
+
+	std::string_view View() const { return std::string_view(Data(), Size()); }
+	operator std::string_view() const { return View(); }
+	StringClass ToStringClass() const { return StringClass(Data(), Size()); }
+
+	// Copies the characters first if they are shared, so only this string changes
+	char* MutableData()
+	{
+		MakeUnique(m_Header ? m_Header->Capacity : 0);
+		return m_Header->Characters();
+	}
+
+	// Grows the buffer 1.5 times at a time, so appending in a loop doesn't copy everything every time
+	// string may be (part of) this string's own characters, so the old buffer is only released once both have been copied out of it
+	void Append(std::string_view string)
+	{
+		if (string.empty())
+			return;
+		size_t size = Size();
+		size_t needed = size + string.size();
+		if (!m_Header || References() != 1 || needed > m_Header->Capacity)
+		{
+			size_t capacity = m_Header ? m_Header->Capacity : 0;
+			if (needed > capacity)
+				capacity = needed > capacity + capacity / 2 ? needed : capacity + capacity / 2;
+			Header* header = Allocate(capacity);
+			memcpy(header->Characters(), Data(), size);
+			memcpy(header->Characters() + size, string.data(), string.size());
+			Release();
+			m_Header = header;
+		}
+		else
+			memcpy(m_Header->Characters() + size, string.data(), string.size());	// Our own characters end where these are written, so they never overlap
+		m_Header->Characters()[needed] = 0;
+		m_Header->Size = (uint32_t)needed;
+	}
+
+	bool operator==(const BasicSharedString& other) const { return m_Header == other.m_Header || View() == other.View(); }
+	bool operator!=(const BasicSharedString& other) const { return !(*this == other); }
+};
+
+using SharedString = BasicSharedString<true>;
+using LocalSharedString = BasicSharedString<false>;
+
+template<bool ThreadSafe>
+inline std::ostream& operator<<(std::ostream& stream, const BasicSharedString<ThreadSafe>& string)
+{
+	stream.write(string.Data(), string.Size());
+	return stream;
+}
@@ -0,0 +1,227 @@
+#pragma once
+
+// A thin wrapper around 4-wide float SIMD registers, so the maths code doesn't have to care which CPU it is built for
+// SIMD (Single Instruction, Multiple Data) instructions do the same operation on 4 floats at once, in the time one normal instruction takes
+// x86 has SSE, ARM has NEON. If neither is available (or PR_SIMD_SCALAR is defined) we fall back to plain floats
+// Define PR_SIMD_SCALAR in the project settings to get the scalar reference build, which gives exactly the same results and can be used to check the SIMD versions
+
+#if !defined(PR_SIMD_SCALAR)
+	#if defined(__SSE__) || defined(_M_X64) || (defined(_M_IX86_FP) && _M_IX86_FP >= 1)
+		#define PR_SIMD_SSE
+		#include <xmmintrin.h>
+	#elif defined(__aarch64__) || defined(_M_ARM64)
+		#define PR_SIMD_NEON
+		#include <arm_neon.h>
+	#else
+		#define PR_SIMD_SCALAR
+	#endif
+#endif
+
+#include <cmath>
+
+struct Float4
+{
+#if defined(PR_SIMD_SSE)
+	__m128 v;
+#elif defined(PR_SIMD_NEON)
+	float32x4_t v;
+#else
+	float v[4];
+#endif
+};
+
+inline const char* SimdBackendName()
+{
+#if defined(PR_SIMD_SSE)
+	return "SSE";
+#elif defined(PR_SIMD_NEON)
+	return "NEON";
+#else
+	return "Scalar";
+#endif
+}
+
+// Creating and reading
+inline Float4 SimdSet(float x, float y, float z, float w)
+{
+#if defined(PR_SIMD_SSE)
+	return { _mm_setr_ps(x, y, z, w) };
+#elif defined(PR_SIMD_NEON)
+	float values[4] = { x, y, z, w };
+	return { vld1q_f32(values) };
+#else
+	return { { x, y, z, w } };
+#endif
+}
+
+inline Float4 SimdSplat(float value)
+{
+#if defined(PR_SIMD_SSE)
+	return { _mm_set1_ps(value) };
+#elif defined(PR_SIMD_NEON)
+	return { vdupq_n_f32(value) };
+#else
+	return { { value, value, value, value } };
+#endif
+}
+
+// Reads 4 floats. The address doesn't have to be aligned
+inline Float4 SimdLoad(const float* values)
+{
+#if defined(PR_SIMD_SSE)
+	return { _mm_loadu_ps(values) };
+#elif defined(PR_SIMD_NEON)
+	return { vld1q_f32(values) };
+#else
+	return { { values[0], values[1], values[2], values[3] } };
+#endif
+}
+
+inline void SimdStore(float* values, Float4 a)
+{
+#if defined(PR_SIMD_SSE)
+	_mm_storeu_ps(values, a.v);
+#elif defined(PR_SIMD_NEON)
+	vst1q_f32(values, a.v);
+#else
+	for (int i = 0; i < 4; i++)
+		values[i] = a.v[i];
+#endif
+}
+
+inline float SimdGetX(Float4 a)
+{
+#if defined(PR_SIMD_SSE)
+	return _mm_cvtss_f32(a.v);
+#elif defined(PR_SIMD_NEON)
+	return vgetq_lane_f32(a.v, 0);
+#else
+	return a.v[0];
+#endif
+}
+
+// Arithmetic, one lane at a time
+inline Float4 operator+(Float4 a, Float4 b)
+{
+#if defined(PR_SIMD_SSE)
+	return { _mm_add_ps(a.v, b.v) };
+#elif defined(PR_SIMD_NEON)
+	return { vaddq_f32(a.v, b.v) };
+#else
+	return { { a.v[0] + b.v[0], a.v[1] + b.v[1], a.v[2] + b.v[2], a.v[3] + b.v[3] } };
+#endif
+}
+
+inline Float4 operator-(Float4 a, Float4 b)
+{
+#if defined(PR_SIMD_SSE)
+	return { _mm_sub_ps(a.v, b.v) };
+#elif defined(PR_SIMD_NEON)
+	return { vsubq_f32(a.v, b.v) };
+#else
+	return { { a.v[0] - b.v[0], a.v[1] - b.v[1], a.v[2] - b.v[2], a.v[3] - b.v[3] } };
+#endif
+}
+
+inline Float4 operator*(Float4 a, Float4 b)
+{
+#if defined(PR_SIMD_SSE)
+	return { _mm_mul_ps(a.v, b.v) };
+#elif defined(PR_SIMD_NEON)
+	return { vmulq_f32(a.v, b.v) };
+#else
+	return { { a.v[0] * b.v[0], a.v[1] * b.v[1], a.v[2] * b.v[2], a.v[3] * b.v[3] } };
+#endif
+}
+
+inline Float4 operator/(Float4 a, Float4 b)
+{
+#if defined(PR_SIMD_SSE)
+	return { _mm_div_ps(a.v, b.v) };
+#elif defined(PR_SIMD_NEON)
+	return { vdivq_f32(a.v, b.v) };
+#else
+	return { { a.v[0] / b.v[0], a.v[1] / b.v[1], a.v[2] / b.v[2], a.v[3] / b.v[3] } };
+#endif
+}
+
+inline Float4 SimdMin(Float4 a, Float4 b)
+{
+#if defined(PR_SIMD_SSE)
+	return { _mm_min_ps(a.v, b.v) };
+#elif defined(PR_SIMD_NEON)
+	return { vminq_f32(a.v, b.v) };
+#else
+	return { { a.v[0] < b.v[0] ? a.v[0] : b.v[0], a.v[1] < b.v[1] ? a.v[1] : b.v[1], a.v[2] < b.v[2] ? a.v[2] : b.v[2], a.v[3] < b.v[3] ? a.v[3] : b.v[3] } };
+#endif
+}
+
+inline Float4 SimdMax(Float4 a, Float4 b)
+{
+#if defined(PR_SIMD_SSE)
+	return { _mm_max_ps(a.v, b.v) };
+#elif defined(PR_SIMD_NEON)
+	return { vmaxq_f32(a.v, b.v) };
+#else
+	return { { a.v[0] > b.v[0] ? a.v[0] : b.v[0], a.v[1] > b.v[1] ? a.v[1] : b.v[1], a.v[2] > b.v[2] ? a.v[2] : b.v[2], a.v[3] > b.v[3] ? a.v[3] : b.v[3] } };
+#endif
+}
+
+inline Float4 SimdSqrt(Float4 a)
+{
+#if defined(PR_SIMD_SSE)
+	return { _mm_sqrt_ps(a.v) };
+#elif defined(PR_SIMD_NEON)
+	return { vsqrtq_f32(a.v) };
+#else
+	return { { std::sqrt(a.v[0]), std::sqrt(a.v[1]), std::sqrt(a.v[2]), std::sqrt(a.v[3]) } };
+#endif
+}
+
+// Sum of all 4 lanes, in every lane. Always added as (x + y) + (z + w), so every backend rounds the same way
+inline Float4 SimdHorizontalAdd(Float4 a)
+{
+#if defined(PR_SIMD_SSE)
+	__m128 pairs = _mm_add_ps(a.v, _mm_shuffle_ps(a.v, a.v, _MM_SHUFFLE(2, 3, 0, 1)));	// (x + y, x + y, z + w, z + w)
+	return { _mm_add_ps(pairs, _mm_shuffle_ps(pairs, pairs, _MM_SHUFFLE(1, 0, 3, 2))) };
+#elif defined(PR_SIMD_NEON)
+	float32x4_t pairs = vaddq_f32(a.v, vrev64q_f32(a.v));
+	return { vaddq_f32(pairs, vextq_f32(pairs, pairs, 2)) };
+#else
+	float sum = (a.v[0] + a.v[1]) + (a.v[2] + a.v[3]);
+	return { { sum, sum, sum, sum } };
+#endif
+}
+
+inline Float4 SimdDot4(Float4 a, Float4 b)
+{
+	return SimdHorizontalAdd(a * b);
+}
+
+// (y, z, x, w), used for the cross product
+inline Float4 SimdRotateXYZ(Float4 a)
+{
+#if defined(PR_SIMD_SSE)
+	return { _mm_shuffle_ps(a.v, a.v, _MM_SHUFFLE(3, 0, 2, 1)) };
+#elif defined(PR_SIMD_NEON)
+	float values[4];
+	vst1q_f32(values, a.v);
+	float rotated[4] = { values[1], values[2], values[0], values[3] };
+	return { vld1q_f32(rotated) };
+#else
+	return { { a.v[1], a.v[2], a.v[0], a.v[3] } };
+#endif
+}
+
+// a.yzx * b.zxy - a.zxy * b.yzx, written with one fewer shuffle. The w lane ends up as 0
+inline Float4 SimdCross3(Float4 a, Float4 b)
+{
+	Float4 c = a * SimdRotateXYZ(b) - SimdRotateXYZ(a) * b;
+	return SimdRotateXYZ(c);
+}
+
+// a + (b - a) * t
+inline Float4 SimdLerp(Float4 a, Float4 b, Float4 t)
+{
+	return a + (b - a) * t;
+}
@@ -0,0 +1,152 @@
+#pragma once
+
+#include <cstdint>
+#include <utility>
+
+#include "DynamicArray.h"
+
+// A container for things that are added and removed all the time (particles, entities, the vertices of something being edited), where every element gets a key
+// that keeps working no matter what else is added or removed. Adding, removing and finding by key are all O(1)
+//
+// The values themselves are kept packed together in one array, so walking over all of them is as fast as walking a vector. Removing one moves the last value
+// into its place (an unordered erase), so the order changes
+// Keys don't point at the values but at a slot, and the slot knows where its value currently is. Every time a slot is reused its generation goes up,
+// so an old key to a removed value is simply not found any more, instead of finding whatever was added in its place
+//
+// Pointers and references to the values are only good until the next Insert or Erase, like with a vector. Keep the key instead
+
+struct SlotMapKey
+{
+	uint32_t Index = UINT32_MAX;
+	uint32_t Generation = 0;
+
+	bool operator==(const SlotMapKey& other) const { return Index == other.Index && Generation == other.Generation; }
+	bool operator!=(const SlotMapKey& other) const { return !(*this == other); }
+};
+
+template<typename T>
+class SlotMap
+{
+private:
+	struct Slot
+	{
+		uint32_t Index;			// Where the value is in m_Values while the slot is used, and the next free slot while it isn't
+		uint32_t Generation;
+	};
+
+	DynamicArray<T> m_Values;
+	DynamicArray<uint32_t> m_ValueSlots;	// The slot of every value, so the slot of the value moved by an erase can be pointed at its new place
+	DynamicArray<Slot> m_Slots;
+	uint32_t m_FreeSlot = UINT32_MAX;
+
+	Slot* FindSlot(SlotMapKey key)
+	{
+		if (key.Index >= m_Slots.Size())
+			return nullptr;
+		Slot& slot = m_Slots[key.Index];
+		return slot.Generation == key.Generation ? &slot : nullptr;
+	}
+
+	const Slot* FindSlot(SlotMapKey key) const
+	{
+		return const_cast<SlotMap*>(this)->FindSlot(key);
+	}
+public:
+	template<typename... Args>
+	SlotMapKey Emplace(Args&&... arguments)
+	{
+		m_Values.EmplaceBack(std::forward<Args>(arguments)...);
+
+		uint32_t index = m_FreeSlot;
+		if (index != UINT32_MAX)
+			m_FreeSlot = m_Slots[index].Index;
+		else
+		{
+			index = (uint32_t)m_Slots.Size();
+			m_Slots.PushBack({ 0, 0 });
+		}
+		Slot& slot = m_Slots[index];
+		slot.Index = (uint32_t)m_ValueSlots.Size();
+		m_ValueSlots.PushBack(index);
+		return { index, slot.Generation };
+	}
+
+	SlotMapKey Insert(const T& value) { return Emplace(value); }
+	SlotMapKey Insert(T&& value) { return Emplace(std::move(value)); }
+
+	// False when the key was already erased (or never came from this map)
+	bool Erase(SlotMapKey key)
+	{
+		Slot* slot = FindSlot(key);
+		if (!slot)
+			return false;
+
+		uint32_t index = slot->Index;
+		uint32_t moved = m_ValueSlots.Back();
+		m_Values.UnorderedErase(index);
+		m_ValueSlots.UnorderedErase(index);
+		m_Slots[moved].Index = index;
+
+		slot->Generation++;
+		slot->Index = m_FreeSlot;
+		m_FreeSlot = key.Index;
+		return true;
+	}
+
+	// The value with that key, or nullptr if it has been erased
+	T* Find(SlotMapKey key)
+	{
+		const Slot* slot = FindSlot(key);
+		return slot ? &m_Values[slot->Index] : nullptr;
+	}
+
+	const T* Find(SlotMapKey key) const
+	{
+		const Slot* slot = FindSlot(key);
+		return slot ? &m_Values[slot->Index] : nullptr;
+	}
+
+	bool Contains(SlotMapKey key) const { return FindSlot(key) != nullptr; }
+
+	// Only for keys that are known to be in the map
+	T& operator[](SlotMapKey key) { return m_Values[m_Slots[key.Index].Index]; }
+	const T& operator[](SlotMapKey key) const { return m_Values[m_Slots[key.Index].Index]; }
+
+	// The key of the value at Data()[index], for going back from a walk over the values to their keys
+	SlotMapKey KeyAt(size_t index) const
+	{
+		uint32_t slot = m_ValueSlots[index];
+		return { slot, m_Slots[slot].Generation };
+	}
+
+	void Reserve(size_t capacity)
+	{
+		m_Values.Reserve(capacity);
+		m_ValueSlots.Reserve(capacity);
+		m_Slots.Reserve(capacity);
+	}
+
+	// Erases everything. Every key given out so far stops working
+	void Clear()
+	{
+		for (uint32_t slot : m_ValueSlots)
+		{
+			m_Slots[slot].Generation++;
+			m_Slots[slot].Index = m_FreeSlot;
+			m_FreeSlot = slot;
+		}
+		m_Values.Clear();
+		m_ValueSlots.Clear();
+	}
+
+	T* Data() { return m_Values.Data(); }
+	const T* Data() const { return m_Values.Data(); }
+	size_t Size() const { return m_Values.Size(); }
+	bool Empty() const { return m_Values.Empty(); }
+
+	// The values, packed together in no particular order
+	T* begin() { return m_Values.begin(); }
+	T* end() { return m_Values.end(); }
+	const T* begin() const { return m_Values.begin(); }
+	const T* end() const { return m_Values.end(); }
+};
@@ -0,0 +1,41 @@
+#pragma once
+
+#include <cstddef>
+#include <type_traits>
+#include <vector>
+
+// A pointer and a size: a view of some contiguous elements that someone else owns (std::span only arrived in C++20)
+// Like a std::string_view, it is cheap to copy and should be passed by value
+template<typename T>
+class Span
+{
+private:
+	T* m_Data = nullptr;
+	size_t m_Size = 0;
+public:
+	Span() = default;
+	Span(T* data, size_t size)
+		: m_Data(data), m_Size(size) {}
+
+	template<typename U, typename = std::enable_if_t<std::is_convertible_v<U*, T*>>>
+	Span(std::vector<U>& vector)
+		: m_Data(vector.data()), m_Size(vector.size()) {}
+	template<typename U, typename = std::enable_if_t<std::is_convertible_v<const U*, T*>>>
+	Span(const std::vector<U>& vector)
+		: m_Data(vector.data()), m_Size(vector.size()) {}
+
+	// A Span<T> can always be used where a Span<const T> is wanted
+	template<typename U, typename = std::enable_if_t<std::is_convertible_v<U*, T*> && !std::is_same_v<U, T>>>
+	Span(Span<U> other)
+		: m_Data(other.Data()), m_Size(other.Size()) {}
+
+	T* Data() const { return m_Data; }
+	size_t Size() const { return m_Size; }
+	bool Empty() const { return m_Size == 0; }
+
+	T& operator[](size_t index) const { return m_Data[index]; }
+	T* begin() const { return m_Data; }
+	T* end() const { return m_Data + m_Size; }
+
+	Span Subspan(size_t offset, size_t count) const { return Span(m_Data + offset, count); }
+};
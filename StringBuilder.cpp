@@ -0,0 +1,103 @@
+#include "StringBuilder.h"
+
+void StringBuilder::AddChunk(size_t minimumCapacity)
+{
+	size_t capacity = FirstChunkSize;
+	if (!m_Chunks.empty())
+		capacity = m_Chunks.back().Capacity * 2 < MaxChunkSize ? m_Chunks.back().Capacity * 2 : MaxChunkSize;
+	// A piece bigger than that gets a chunk of its own size, so it doesn't have to be cut up
+	if (capacity < minimumCapacity)
+		capacity = minimumCapacity;
+
+	// new char[] without () leaves the characters uninitialised, they are about to be written anyway
+	m_Chunks.push_back({ std::unique_ptr<char[]>(new char[capacity]), m_Size, 0, capacity });
+}
+
+size_t StringBuilder::FindChunk(size_t offset) const
+{
+	// The chunk starts are sorted, so binary search for the last one that starts at or before offset
+	size_t low = 0, high = m_Chunks.size();
+	while (high - low > 1)
+	{
+		size_t middle = (low + high) / 2;
+		if (m_Chunks[middle].Start <= offset)
+			low = middle;
+		else
+			high = middle;
+	}
+	return low;
+}
+
+StringBuilder& StringBuilder::AppendToNewChunk(std::string_view string)
+{
+	const char* data = string.data();
+	size_t size = string.size();
+
+	// Fill what is left of the last chunk, then start a new one big enough for the rest
+	if (!m_Chunks.empty())
+	{
+		Chunk& chunk = m_Chunks.back();
+		size_t count = chunk.Capacity - chunk.Size < size ? chunk.Capacity - chunk.Size : size;
+		memcpy(chunk.Data.get() + chunk.Size, data, count);
+		chunk.Size += count;
+		m_Size += count;
+		data += count;
+		size -= count;
+	}
+
+	if (size > 0)
+	{
+		AddChunk(size);
+		Chunk& chunk = m_Chunks.back();
+		memcpy(chunk.Data.get(), data, size);
+		chunk.Size = size;
+		m_Size += size;
+	}
+	return *this;
+}
+
+void StringBuilder::Clear()
+{
+	m_Chunks.clear();
+	m_Size = 0;
+}
+
+char StringBuilder::operator[](size_t offset) const
+{
+	const Chunk& chunk = m_Chunks[FindChunk(offset)];
+	return chunk.Data[offset - chunk.Start];
+}
+
+void StringBuilder::CopyTo(char* destination, size_t offset, size_t size) const
+{
+	ForEachPiece(offset, size, [&](std::string_view piece)
+	{
+		memcpy(destination, piece.data(), piece.size());
+		destination += piece.size();
+	});
+}
+
+std::string StringBuilder::ToStdString() const
+{
+	return Slice(0, m_Size).ToStdString();
+}
+
+StringClass StringBuilder::ToStringClass() const
+{
+	return Slice(0, m_Size).ToStringClass();
+}
+
+std::string StringSlice::ToStdString() const
+{
+	// std::string can't be resized without setting the new characters, so they are zeroed once before being overwritten
+	std::string string(m_Size, '\0');
+	CopyTo(&string[0]);
+	return string;
+}
+
+StringClass StringSlice::ToStringClass() const
+{
+	StringClass string = StringClass::CreateUninitialized(m_Size);
+	CopyTo(string.Data());
+	return string;
+}
@@ -0,0 +1,144 @@
+#pragma once
+
+#include <cstddef>
+#include <cstring>
+#include <memory>
+#include <string>
+#include <string_view>
+#include <vector>
+
+#include "StringClass.h"
+
+class StringSlice;
+
+// Builds one big string out of lots of small pieces
+// cppString += " hello" in a loop has to reallocate the string and copy everything in it every time it runs out of room
+// StringBuilder keeps the characters in a list of chunks instead. When a chunk is full it starts a new one, and the characters already written never move
+// So appending costs the same however big the string is, and the whole string is only copied once, by ToStdString() or ToStringClass() at the end
+//
+// Chunks start small and double in size up to MaxChunkSize, so a short string doesn't waste memory and a huge one doesn't need thousands of chunks
+// Slice() gives a view of part of the string without copying it. Slices stay valid while more is appended, until the builder is cleared or destroyed
+class StringBuilder
+{
+public:
+	static constexpr size_t FirstChunkSize = 256;
+	static constexpr size_t MaxChunkSize = 1 << 20;
+private:
+	struct Chunk
+	{
+		std::unique_ptr<char[]> Data;
+		size_t Start;		// Where the chunk's first character is in the whole string
+		size_t Size;
+		size_t Capacity;
+	};
+
+	std::vector<Chunk> m_Chunks;
+	size_t m_Size = 0;
+
+	void AddChunk(size_t minimumCapacity);
+	StringBuilder& AppendToNewChunk(std::string_view string);
+	// The chunk that holds the character at offset
+	size_t FindChunk(size_t offset) const;
+public:
+	StringBuilder() = default;
+
+	// Inline, because nearly every piece fits in the last chunk and that is only a memcpy
+	StringBuilder& Append(std::string_view string)
+	{
+		if (string.empty())
+			return *this;
+		if (m_Chunks.empty() || m_Chunks.back().Capacity - m_Chunks.back().Size < string.size())
+			return AppendToNewChunk(string);
+		Chunk& chunk = m_Chunks.back();
+		memcpy(chunk.Data.get() + chunk.Size, string.data(), string.size());
+		chunk.Size += string.size();
+		m_Size += string.size();
+		return *this;
+	}
+	StringBuilder& Append(char character)
+	{
+		if (m_Chunks.empty() || m_Chunks.back().Size == m_Chunks.back().Capacity)
+			AddChunk(1);
+		Chunk& chunk = m_Chunks.back();
+		chunk.Data[chunk.Size++] = character;
+		m_Size++;
+		return *this;
+	}
+
+	StringBuilder& operator+=(std::string_view string) { return Append(string); }
+	StringBuilder& operator+=(char character) { return Append(character); }
+
+	size_t Size() const { return m_Size; }
+	bool Empty() const { return m_Size == 0; }
+	size_t ChunkCount() const { return m_Chunks.size(); }
+	void Clear();
+
+	char operator[](size_t offset) const;
+
+	// Calls function(std::string_view) for each piece of the characters from offset to offset + size, in order
+	template<typename F>
+	void ForEachPiece(size_t offset, size_t size, F&& function) const
+	{
+		if (size == 0)
+			return;
+		for (size_t i = FindChunk(offset); size > 0; i++)
+		{
+			const Chunk& chunk = m_Chunks[i];
+			size_t begin = offset - chunk.Start;
+			size_t count = chunk.Size - begin < size ? chunk.Size - begin : size;
+			function(std::string_view(chunk.Data.get() + begin, count));
+			offset += count;
+			size -= count;
+		}
+	}
+
+	// Copies size characters starting at offset to destination
+	void CopyTo(char* destination, size_t offset, size_t size) const;
+
+	StringSlice Slice(size_t offset, size_t size) const;
+
+	// One allocation of exactly the right size, and one copy of every character
+	std::string ToStdString() const;
+	StringClass ToStringClass() const;
+};
+
+// Part of a StringBuilder's string, without a copy of the characters
+class StringSlice
+{
+private:
+	const StringBuilder* m_Builder = nullptr;
+	size_t m_Offset = 0;
+	size_t m_Size = 0;
+public:
+	StringSlice() = default;
+	StringSlice(const StringBuilder& builder, size_t offset, size_t size)
+		: m_Builder(&builder), m_Offset(offset), m_Size(size) {}
+
+	size_t Size() const { return m_Size; }
+	bool Empty() const { return m_Size == 0; }
+	char operator[](size_t index) const { return (*m_Builder)[m_Offset + index]; }
+
+	// A slice of this slice, so offset counts from the start of this one
+	StringSlice Slice(size_t offset, size_t size) const { return StringSlice(*m_Builder, m_Offset + offset, size); }
+
+	template<typename F>
+	void ForEachPiece(F&& function) const
+	{
+		if (m_Builder)
+			m_Builder->ForEachPiece(m_Offset, m_Size, function);
+	}
+
+	void CopyTo(char* destination) const
+	{
+		if (m_Builder)
+			m_Builder->CopyTo(destination, m_Offset, m_Size);
+	}
+
+	std::string ToStdString() const;
+	StringClass ToStringClass() const;
+};
+
+inline StringSlice StringBuilder::Slice(size_t offset, size_t size) const
+{
+	return StringSlice(*this, offset, size);
+}
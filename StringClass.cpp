@@ -0,0 +1,88 @@
+#include "StringClass.h"
+
+#include <stdexcept>
+
+char* StringClass::Allocate(size_t size, MonotonicArena* arena)
+{
+	if (size <= InlineCapacity)
+	{
+		m_Inline[size] = 0;
+		m_Inline[s_FlagIndex] = (char)size;
+		return m_Inline;
+	}
+
+	// The size and capacity are stored in 32 bits, to keep the string small. Like std::string, a string that is too long throws instead of being cut short
+	if (size > UINT32_MAX)
+		throw std::length_error("StringClass can't hold more than 4 GB");
+
+	m_Heap.Data = arena ? arena->Allocate<char>(size + 1) : new char[size + 1];
+	m_Heap.Data[size] = 0;   // Adding our own NULL termination character
+	m_Heap.Size = (uint32_t)size;
+	m_Heap.Capacity = (uint32_t)size;
+	m_Inline[s_FlagIndex] = (char)(arena ? s_ArenaFlag : s_HeapFlag);
+	return m_Heap.Data;
+}
+
+void StringClass::Assign(const char* string, size_t size)
+{
+	memcpy(Allocate(size), string, size);   // This copies our memory from string in to the buffer
+}
+
+StringClass StringClass::CreateUninitialized(size_t size, MonotonicArena* arena)
+{
+	StringClass string;
+	string.Allocate(size, arena);
+	return string;
+}
+
+StringClass& StringClass::operator=(const StringClass& other)
+{
+	if (this == &other)
+		return *this;
+
+	// Reuse our heap or arena buffer when the other string fits in it, instead of freeing it and allocating another one
+	size_t size = other.Size();
+	if (!IsInline() && size <= m_Heap.Capacity)
+	{
+		memcpy(m_Heap.Data, other.Data(), size);
+		m_Heap.Data[size] = 0;
+		m_Heap.Size = (uint32_t)size;
+		return *this;
+	}
+
+	// The old buffer is only freed once the new one exists, so if allocating throws this string still has its old characters
+	char* oldBuffer = OwnsBuffer() ? m_Heap.Data : nullptr;
+	Assign(other.Data(), size);
+	delete[] oldBuffer;
+	return *this;
+}
+
+size_t StringClass::Count(std::string_view pattern) const
+{
+	if (pattern.empty())
+		return 0;
+	size_t count = 0;
+	for (size_t position = Find(pattern); position != StringNotFound; position = Find(pattern, position + pattern.size()))
+		count++;
+	return count;
+}
+
+std::vector<std::string_view> StringClass::Split(std::string_view separator) const
+{
+	std::vector<std::string_view> parts;
+	std::string_view string = View();
+	if (separator.empty())
+	{
+		parts.push_back(string);
+		return parts;
+	}
+
+	size_t start = 0;
+	for (size_t position = Find(separator); position != StringNotFound; position = Find(separator, start))
+	{
+		parts.push_back(string.substr(start, position - start));
+		start = position + separator.size();
+	}
+	parts.push_back(string.substr(start));
+	return parts;
+}
@@ -0,0 +1,141 @@
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+#include <cstring>
+#include <iostream>
+#include <string_view>
+#include <vector>
+
+#include "MonotonicArena.h"
+#include "StringSearch.h"
+
+// Copying and Copy constructors
+// Our own string class. It owns its characters and always keeps a NULL termination character after them
+//
+// Small string optimisation: most strings in a programme are short, like "Cherno". Allocating a buffer on the heap for them costs far more than copying the characters
+// So a string of up to 22 characters is stored inside the object itself, in the 24 bytes the heap pointer, size and capacity would use anyway
+// The last of those bytes says which one it is: the size of an inline string (0 to 22), s_HeapFlag when the characters are on the heap, or s_ArenaFlag when they are in an arena
+//
+// Longer strings can also take their characters from a MonotonicArena, so a scope full of strings is freed with one Reset() instead of a delete[] each
+// Those strings never free anything themselves. They must not be used once the arena is reset, but copies of them get their own heap buffer and can outlive it
+class StringClass
+{
+public:
+	static constexpr size_t InlineCapacity = 22;
+private:
+	struct HeapBuffer
+	{
+		char* Data;
+		uint32_t Size;
+		uint32_t Capacity;	// Not counting the NULL termination character
+	};
+
+	static constexpr unsigned char s_HeapFlag = 0xFF;
+	static constexpr unsigned char s_ArenaFlag = 0xFE;
+	static constexpr size_t s_FlagIndex = InlineCapacity + 1;
+
+	union
+	{
+		HeapBuffer m_Heap;
+		char m_Inline[InlineCapacity + 2];	// The characters, the NULL termination character, then the flag
+	};
+
+	bool IsInline() const { return (unsigned char)m_Inline[s_FlagIndex] <= InlineCapacity; }
+	// Only heap buffers are ours to delete[]. Arena memory is freed by the arena
+	bool OwnsBuffer() const { return (unsigned char)m_Inline[s_FlagIndex] == s_HeapFlag; }
+	void SetEmpty()
+	{
+		m_Inline[0] = 0;
+		m_Inline[s_FlagIndex] = 0;
+	}
+	// Sets the size and the NULL termination character, and returns where the characters go. Doesn't free the old buffer
+	char* Allocate(size_t size, MonotonicArena* arena = nullptr);
+	void Assign(const char* string, size_t size);
+public:
+	StringClass() { SetEmpty(); }
+	StringClass(const char* string)
+		: StringClass(string, StringLength(string)) {}
+	StringClass(const char* string, size_t size) { Assign(string, size); }
+	StringClass(std::string_view string)
+		: StringClass(string.data(), string.size()) {}
+	// Strings too long to fit inline take their characters from the arena
+	StringClass(std::string_view string, MonotonicArena& arena)
+	{
+		memcpy(Allocate(string.size(), &arena), string.data(), string.size());
+	}
+
+	// A string of size characters that haven't been set yet, for code that is about to write all of them through Data() anyway
+	static StringClass CreateUninitialized(size_t size, MonotonicArena* arena = nullptr);
+
+	// Our copy constructor. A copy constructor takes a reference to a variable with the same type
+	// A copy constructor that only initialises member variables is the default one C++ supplies us with.
+	// That would copy the pointer to the heap buffer, and both strings would delete[] it. So we make a deep copy, copying the memory contents instead of the memory address
+	// If we don't want to allow copying, we can make the copy constructor equal to delete;
+	StringClass(const StringClass& other)
+		: StringClass(other.Data(), other.Size()) {}
+
+	// Our move constructor. The other string is about to be thrown away (it is a temporary, or was std::move'd), so we can just take its buffer instead of copying it
+	// All 24 bytes are copied whichever way the string is stored, and the other string is left empty so its destructor has nothing to delete
+	// It must be noexcept, or std::vector copies the strings instead of moving them when it grows
+	StringClass(StringClass&& other) noexcept
+	{
+		memcpy(m_Inline, other.m_Inline, sizeof(m_Inline));
+		other.SetEmpty();
+	}
+
+	StringClass& operator=(const StringClass& other);
+	StringClass& operator=(StringClass&& other) noexcept
+	{
+		if (this != &other)
+		{
+			if (OwnsBuffer())
+				delete[] m_Heap.Data;
+			memcpy(m_Inline, other.m_Inline, sizeof(m_Inline));
+			other.SetEmpty();
+		}
+		return *this;
+	}
+
+	~StringClass()
+	{
+		if (OwnsBuffer())
+			delete[] m_Heap.Data;  // To prevent memory leaks
+	}
+
+	const char* Data() const { return IsInline() ? m_Inline : m_Heap.Data; }
+	char* Data() { return IsInline() ? m_Inline : m_Heap.Data; }
+	const char* CStr() const { return Data(); }
+	size_t Size() const { return IsInline() ? (size_t)m_Inline[s_FlagIndex] : m_Heap.Size; }
+	size_t Capacity() const { return IsInline() ? InlineCapacity : m_Heap.Capacity; }
+	bool Empty() const { return Size() == 0; }
+	// True when the characters are inside the object, so it never allocated
+	bool IsSmall() const { return IsInline(); }
+	bool IsInArena() const { return (unsigned char)m_Inline[s_FlagIndex] == s_ArenaFlag; }
+
+	char& operator[](size_t index) { return Data()[index]; }
+	const char& operator[](size_t index) const { return Data()[index]; }
+
+	std::string_view View() const { return std::string_view(Data(), Size()); }
+	operator std::string_view() const { return View(); }
+
+	// Searching uses the SIMD versions in StringSearch.h. Positions count from the start of the string
+	size_t Find(std::string_view pattern, size_t start = 0) const { return FindString(View(), pattern, start); }
+	bool Contains(std::string_view pattern) const { return Find(pattern) != StringNotFound; }
+	// Occurrences that don't overlap, so "aaaa" contains "aa" twice
+	size_t Count(std::string_view pattern) const;
+	// The parts between the separators. They point into this string, so they are only valid while it is alive and unchanged
+	std::vector<std::string_view> Split(std::string_view separator) const;
+
+	bool operator==(const StringClass& other) const { return View() == other.View(); }
+	bool operator!=(const StringClass& other) const { return !(*this == other); }
+};
+
+static_assert(sizeof(StringClass) == 24, "StringClass should be exactly the size of its inline buffer");
+
+// Overloading an operator to allow us to print our string to the console
+inline std::ostream& operator<<(std::ostream& stream, const StringClass& string)
+{
+	stream.write(string.Data(), string.Size());
+	return stream;
+}
@@ -0,0 +1,35 @@
+#include "StringSearch.h"
+#include "StringSearchImpl.h"
+
+namespace
+{
+	// The plain C++ version. It is always there, and the others have to give exactly the same results
+	struct ScalarIsa
+	{
+		static constexpr size_t Width = 1;
+	};
+}
+
+// Each of these lives in its own .cpp file, which is compiled for that instruction set
+// They return nullptr when this build doesn't have a version for it (for example on ARM)
+const StringSearchTable* GetStringSearchSse2();
+const StringSearchTable* GetStringSearchAvx2();
+
+const StringSearchTable* GetStringSearch(SimdLevel level)
+{
+	// Calling an AVX2 function on a CPU without AVX2 crashes the programme, so never hand one out
+	if (!GetCpuFeatures().Supports(level))
+		return nullptr;
+
+	switch (level)
+	{
+	case SimdLevel::Scalar:
+	{
+		static const StringSearchTable s_Table = MakeStringSearchTable<ScalarIsa>(SimdLevel::Scalar);
+		return &s_Table;
+	}
+	case SimdLevel::Sse2: return GetStringSearchSse2();
+	case SimdLevel::Avx2: return GetStringSearchAvx2();
+	default: return nullptr;	// SSE4.2's string instructions are slower than comparing the first and last characters with SSE2, and AVX-512 isn't worth it for this
+	}
+}
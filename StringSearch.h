@@ -0,0 +1,58 @@
+#pragma once
+
+#include <cstddef>
+#include <string_view>
+
+#include "CpuFeatures.h"
+
+// Substring search and string length, for scanning big buffers
+// The SIMD versions look for the first and the last character of the pattern at the same time, 16 (SSE2) or 32 (AVX2) positions at once
+// Only the positions where both match are compared in full, and in normal text that is very few of them, so whole registers of text are skipped in one step
+// The length scan compares a whole register with 0 at a time. It only reads aligned registers, which can't cross into the next page of memory, so it never crashes by reading past the end
+// Every version gives the same results. The best one the CPU supports is picked the first time one is called
+
+// Returned by Find when the pattern isn't there
+inline constexpr size_t StringNotFound = (size_t)-1;
+
+struct StringSearchTable
+{
+	SimdLevel Level;
+
+	// Where pattern first appears in text, or StringNotFound. An empty pattern is found at 0
+	size_t (*Find)(const char* text, size_t size, const char* pattern, size_t patternSize);
+	// The same as strlen
+	size_t (*Length)(const char* string);
+};
+
+// The table for a specific level, or nullptr if this CPU (or this build) doesn't have it. Useful for comparing them
+const StringSearchTable* GetStringSearch(SimdLevel level);
+
+// The fastest table this CPU supports, picked once
+inline const StringSearchTable& GetStringSearch()
+{
+	static const StringSearchTable& s_Table = []() -> const StringSearchTable&
+	{
+		SimdLevel best = GetCpuFeatures().BestLevel();
+		for (int level = (int)best; level > (int)SimdLevel::Scalar; level--)
+		{
+			if (const StringSearchTable* table = GetStringSearch((SimdLevel)level))
+				return *table;
+		}
+		return *GetStringSearch(SimdLevel::Scalar);
+	}();
+	return s_Table;
+}
+
+inline size_t StringLength(const char* string)
+{
+	return GetStringSearch().Length(string);
+}
+
+// Searches text from start onwards. Returns the position in the whole of text
+inline size_t FindString(std::string_view text, std::string_view pattern, size_t start = 0)
+{
+	if (start > text.size())
+		return StringNotFound;
+	size_t position = GetStringSearch().Find(text.data() + start, text.size() - start, pattern.data(), pattern.size());
+	return position == StringNotFound ? StringNotFound : start + position;
+}
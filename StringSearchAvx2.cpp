@@ -0,0 +1,52 @@
+// Everything we include must come before the #pragma below. Otherwise it would be compiled for AVX2 too, and the linker could pick that version for the whole programme
+#include "StringSearch.h"
+
+#include <cstdint>
+#include <cstring>
+
+#if defined(PR_X86)
+#include <immintrin.h>
+
+// MSVC lets us use any intrinsic anywhere. GCC and Clang have to be told which instructions the functions below are allowed to use
+#if defined(__clang__)
+#pragma clang attribute push(__attribute__((target("avx2"))), apply_to = function)
+#elif defined(__GNUC__)
+#pragma GCC push_options
+#pragma GCC target("avx2")
+#endif
+
+#include "StringSearchImpl.h"
+
+namespace
+{
+	// 32 characters per register
+	struct Avx2
+	{
+		using Register = __m256i;
+		static constexpr size_t Width = 32;
+
+		static Register Load(const char* characters) { return _mm256_loadu_si256(reinterpret_cast<const __m256i*>(characters)); }
+		PR_NO_SANITIZE_ADDRESS static Register LoadAligned(const char* characters) { return _mm256_load_si256(reinterpret_cast<const __m256i*>(characters)); }
+		static Register Splat(char character) { return _mm256_set1_epi8(character); }
+		static Register Equal(Register a, Register b) { return _mm256_cmpeq_epi8(a, b); }
+		static Register And(Register a, Register b) { return _mm256_and_si256(a, b); }
+		static Register Or(Register a, Register b) { return _mm256_or_si256(a, b); }
+		static uint32_t Mask(Register a) { return (uint32_t)_mm256_movemask_epi8(a); }
+	};
+}
+
+const StringSearchTable* GetStringSearchAvx2()
+{
+	static const StringSearchTable s_Table = MakeStringSearchTable<Avx2>(SimdLevel::Avx2);
+	return &s_Table;
+}
+
+#if defined(__clang__)
+#pragma clang attribute pop
+#elif defined(__GNUC__)
+#pragma GCC pop_options
+#endif
+
+#else
+const StringSearchTable* GetStringSearchAvx2() { return nullptr; }
+#endif
@@ -0,0 +1,120 @@
+#pragma once
+
+// The bodies of the string search functions, written once for every instruction set
+// Only included by the StringSearch*.cpp files. Each one describes its registers in a small struct (see Sse2 in StringSearchSse2.cpp) and passes it in as Isa:
+//   Register, Width (characters per register), Load, LoadAligned, Splat,
+//   Equal (all bits set in each character that is the same in a and b), And, Or, Mask (one bit per character, the top bit of each)
+// The scalar version has a Width of 1 and only runs the plain loops, which also finish off what is left after the last full register
+// Each .cpp file compiles this for a different CPU, and the linker must never mix those versions up. So everything in here is static,
+// and each Isa struct is in an anonymous namespace: several files have one called Avx2 (Vector2Kernels and Utf too), and their inline functions would otherwise have the same names
+
+#include <cstddef>
+#include <cstdint>
+#include <cstring>
+
+#include "StringSearch.h"
+
+#if defined(_MSC_VER)
+#include <intrin.h>
+#endif
+
+// The length scan reads whole aligned registers, so it can read a few characters before the start of the string and after its NULL termination character
+// That is always safe, but AddressSanitizer can't know it and would report it. Used on LengthKernel and on each Isa's LoadAligned
+#if defined(__clang__) || defined(__GNUC__)
+#define PR_NO_SANITIZE_ADDRESS __attribute__((no_sanitize_address))
+#else
+#define PR_NO_SANITIZE_ADDRESS
+#endif
+
+// The position of the lowest set bit. mask must not be 0
+static inline unsigned LowestBit(uint32_t mask)
+{
+#if defined(_MSC_VER)
+	unsigned long index;
+	_BitScanForward(&index, mask);
+	return (unsigned)index;
+#else
+	return (unsigned)__builtin_ctz(mask);
+#endif
+}
+
+template<typename Isa>
+static size_t FindKernel(const char* text, size_t size, const char* pattern, size_t patternSize)
+{
+	if (patternSize == 0)
+		return 0;
+	if (patternSize > size)
+		return StringNotFound;
+
+	size_t last = patternSize - 1;
+	size_t i = 0;
+	if constexpr (Isa::Width > 1)
+	{
+		typename Isa::Register first = Isa::Splat(pattern[0]);
+		typename Isa::Register lastCharacter = Isa::Splat(pattern[last]);
+		// Each step checks the 2 * Width positions starting at i. The last characters they need go up to i + last + 2 * Width - 1
+		// Usually neither register has a match, and that is found out with one Mask instead of two
+		for (; i + last + 2 * Isa::Width <= size; i += 2 * Isa::Width)
+		{
+			typename Isa::Register low = Isa::And(Isa::Equal(first, Isa::Load(text + i)), Isa::Equal(lastCharacter, Isa::Load(text + i + last)));
+			typename Isa::Register high = Isa::And(Isa::Equal(first, Isa::Load(text + i + Isa::Width)), Isa::Equal(lastCharacter, Isa::Load(text + i + Isa::Width + last)));
+			if (Isa::Mask(Isa::Or(low, high)) == 0)
+				continue;
+
+			for (size_t half = 0; half < 2; half++)
+			{
+				uint32_t mask = Isa::Mask(half == 0 ? low : high);
+				while (mask != 0)
+				{
+					size_t position = i + half * Isa::Width + LowestBit(mask);
+					// The first and last characters already match
+					if (patternSize <= 2 || memcmp(text + position + 1, pattern + 1, patternSize - 2) == 0)
+						return position;
+					mask &= mask - 1;	// Clears the lowest set bit
+				}
+			}
+		}
+	}
+	for (; i + last < size; i++)
+	{
+		if (text[i] == pattern[0] && text[i + last] == pattern[last] && memcmp(text + i, pattern, patternSize) == 0)
+			return i;
+	}
+	return StringNotFound;
+}
+
+template<typename Isa>
+PR_NO_SANITIZE_ADDRESS static size_t LengthKernel(const char* string)
+{
+	const char* character = string;
+	if constexpr (Isa::Width > 1)
+	{
+		// Start with the aligned register the string starts in, and ignore the characters in it that come before the string
+		size_t offset = (uintptr_t)string & (Isa::Width - 1);
+		const char* block = string - offset;
+		typename Isa::Register zero = Isa::Splat(0);
+		uint32_t mask = Isa::Mask(Isa::Equal(zero, Isa::LoadAligned(block))) >> offset;
+		if (mask != 0)
+			return LowestBit(mask);
+
+		for (block += Isa::Width;; block += Isa::Width)
+		{
+			mask = Isa::Mask(Isa::Equal(zero, Isa::LoadAligned(block)));
+			if (mask != 0)
+				return (size_t)(block - string) + LowestBit(mask);
+		}
+	}
+	while (*character != 0)
+		character++;
+	return (size_t)(character - string);
+}
+
+template<typename Isa>
+static StringSearchTable MakeStringSearchTable(SimdLevel level)
+{
+	StringSearchTable table;
+	table.Level = level;
+	table.Find = FindKernel<Isa>;
+	table.Length = LengthKernel<Isa>;
+	return table;
+}
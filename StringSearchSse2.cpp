@@ -0,0 +1,52 @@
+// Everything we include must come before the #pragma below. Otherwise it would be compiled for SSE2 too, and the linker could pick that version for the whole programme
+#include "StringSearch.h"
+
+#include <cstdint>
+#include <cstring>
+
+#if defined(PR_X86)
+#include <emmintrin.h>
+
+// MSVC lets us use any intrinsic anywhere. GCC and Clang have to be told which instructions the functions below are allowed to use
+#if defined(__clang__)
+#pragma clang attribute push(__attribute__((target("sse2"))), apply_to = function)
+#elif defined(__GNUC__)
+#pragma GCC push_options
+#pragma GCC target("sse2")
+#endif
+
+#include "StringSearchImpl.h"
+
+namespace
+{
+	// 16 characters per register
+	struct Sse2
+	{
+		using Register = __m128i;
+		static constexpr size_t Width = 16;
+
+		static Register Load(const char* characters) { return _mm_loadu_si128(reinterpret_cast<const __m128i*>(characters)); }
+		PR_NO_SANITIZE_ADDRESS static Register LoadAligned(const char* characters) { return _mm_load_si128(reinterpret_cast<const __m128i*>(characters)); }
+		static Register Splat(char character) { return _mm_set1_epi8(character); }
+		static Register Equal(Register a, Register b) { return _mm_cmpeq_epi8(a, b); }
+		static Register And(Register a, Register b) { return _mm_and_si128(a, b); }
+		static Register Or(Register a, Register b) { return _mm_or_si128(a, b); }
+		static uint32_t Mask(Register a) { return (uint32_t)_mm_movemask_epi8(a); }
+	};
+}
+
+const StringSearchTable* GetStringSearchSse2()
+{
+	static const StringSearchTable s_Table = MakeStringSearchTable<Sse2>(SimdLevel::Sse2);
+	return &s_Table;
+}
+
+#if defined(__clang__)
+#pragma clang attribute pop
+#elif defined(__GNUC__)
+#pragma GCC pop_options
+#endif
+
+#else
+const StringSearchTable* GetStringSearchSse2() { return nullptr; }
+#endif
@@ -0,0 +1,156 @@
+#include "TextToFloat.h"
+
+#include <charconv>
+#include <cstdint>
+#include <cstring>
+#include <limits>
+
+// Every one of these is exactly representable, so multiplying or dividing by them rounds only once
+static const float s_FloatPowersOf10[11] = { 1e0f, 1e1f, 1e2f, 1e3f, 1e4f, 1e5f, 1e6f, 1e7f, 1e8f, 1e9f, 1e10f };
+static const double s_DoublePowersOf10[23] =
+{
+	1e0, 1e1, 1e2, 1e3, 1e4, 1e5, 1e6, 1e7, 1e8, 1e9, 1e10, 1e11,
+	1e12, 1e13, 1e14, 1e15, 1e16, 1e17, 1e18, 1e19, 1e20, 1e21, 1e22,
+};
+
+static bool IsDigit(char c)
+{
+	return (unsigned char)(c - '0') < 10;
+}
+
+// Exact for everything, and only reached by the numbers the fast paths can't do
+// big says which way a number that doesn't fit in a float is out of range
+static const char* ReadFloatSlow(const char* text, const char* end, float& value, bool negative, bool big)
+{
+	// from_chars doesn't take a '+'
+	const char* start = text;
+	if (start < end && *start == '+')
+	{
+		start++;
+		if (start < end && *start == '-')
+			return nullptr;
+	}
+
+	std::from_chars_result result = std::from_chars(start, end, value);
+	if (result.ec == std::errc::invalid_argument)
+		return nullptr;
+	if (result.ec == std::errc::result_out_of_range)
+	{
+		value = big ? std::numeric_limits<float>::infinity() : 0.0f;
+		if (negative)
+			value = -value;
+	}
+	return result.ptr;
+}
+
+const char* ReadFloat(const char* text, const char* end, float& value)
+{
+	const char* p = text;
+	bool negative = false;
+	if (p < end && (*p == '-' || *p == '+'))
+	{
+		negative = *p == '-';
+		p++;
+	}
+
+	// The number is mantissa * 10^exponent. The mantissa holds up to 19 significant digits, which always fit in 64 bits
+	uint64_t mantissa = 0;
+	int digits = 0;				// Leading zeros don't count
+	int exponent = 0;
+	bool truncated = false;		// Digits that didn't fit in the mantissa were not all 0
+	const char* integerStart = p;
+	for (; p < end && IsDigit(*p); p++)
+	{
+		if (digits < 19)
+		{
+			mantissa = mantissa * 10 + (uint64_t)(*p - '0');
+			digits += mantissa != 0;
+		}
+		else
+		{
+			exponent++;
+			truncated |= *p != '0';
+		}
+	}
+	bool anyDigits = p != integerStart;
+
+	if (p < end && *p == '.')
+	{
+		p++;
+		const char* fractionStart = p;
+		for (; p < end && IsDigit(*p); p++)
+		{
+			if (digits < 19)
+			{
+				mantissa = mantissa * 10 + (uint64_t)(*p - '0');
+				digits += mantissa != 0;
+				exponent--;
+			}
+			else
+				truncated |= *p != '0';
+		}
+		anyDigits |= p != fractionStart;
+	}
+
+	// "inf", "nan", or not a number at all
+	if (!anyDigits)
+		return ReadFloatSlow(text, end, value, negative, true);
+
+	// An 'e' without digits after it isn't part of the number
+	if (p < end && (*p == 'e' || *p == 'E'))
+	{
+		const char* e = p + 1;
+		bool negativeExponent = false;
+		if (e < end && (*e == '-' || *e == '+'))
+		{
+			negativeExponent = *e == '-';
+			e++;
+		}
+		if (e < end && IsDigit(*e))
+		{
+			int written = 0;
+			for (; e < end && IsDigit(*e); e++)
+			{
+				if (written < 100000)
+					written = written * 10 + (*e - '0');
+			}
+			exponent += negativeExponent ? -written : written;
+			p = e;
+		}
+	}
+
+	if (!truncated)
+	{
+		if (mantissa == 0)
+		{
+			value = negative ? -0.0f : 0.0f;
+			return p;
+		}
+
+		// Both the mantissa and the power of 10 are exact floats, so this is one correctly rounded operation
+		if (mantissa <= (1 << 24) && exponent >= -10 && exponent <= 10)
+		{
+			float result = (float)mantissa;
+			result = exponent < 0 ? result / s_FloatPowersOf10[-exponent] : result * s_FloatPowersOf10[exponent];
+			value = negative ? -result : result;
+			return p;
+		}
+
+		// The same in double. The double is correctly rounded, but rounding it again to a float can only go wrong when it lies exactly halfway between
+		// two floats (the 29 bits a float doesn't have are 100...0). Then the slow path decides. The result is always well inside the range of a float here
+		if (mantissa <= (1ull << 53) && exponent >= -22 && exponent <= 22)
+		{
+			double result = (double)mantissa;
+			result = exponent < 0 ? result / s_DoublePowersOf10[-exponent] : result * s_DoublePowersOf10[exponent];
+			uint64_t bits;
+			memcpy(&bits, &result, sizeof(bits));
+			if ((bits & 0x1FFFFFFF) != 0x10000000)
+			{
+				value = (float)(negative ? -result : result);
+				return p;
+			}
+		}
+	}
+
+	return ReadFloatSlow(text, end, value, negative, digits + exponent > 0);
+}
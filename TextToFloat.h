@@ -0,0 +1,13 @@
+#pragma once
+
+// Fast text to float, for reading millions of numbers out of text files (see FloatToText.h for the other way round)
+// iostream's >> goes through locales, stream state and virtual calls for every number, and strtof needs a 0 terminated string and depends on the locale
+//
+// Nearly every number in a mesh file has at most 7 or so significant digits and a small exponent. Those are read into an integer and then
+// multiplied or divided by an exact power of 10 in one float operation, which gives the correctly rounded float with no further work
+// Anything else (long numbers, big exponents, inf and nan) goes to std::from_chars, so every result is exactly what strtof would have given
+
+// Reads the number at the start of [text, end): an optional sign, digits with an optional '.', and an optional exponent ("-1.5e-3")
+// No whitespace is skipped. Returns a pointer to just after the number, or nullptr if there is no number there (value is left alone then)
+// Numbers too big for a float become infinity, and ones too small become 0
+const char* ReadFloat(const char* text, const char* end, float& value);
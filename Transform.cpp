@@ -0,0 +1,77 @@
+#include "Transform.h"
+
+#include <cassert>
+
+#include "JobSystem.h"
+#include "Simd.h"
+
+// Small enough that a chunk stays in the cache, big enough that handing out chunks costs nothing in comparison
+static const size_t s_ChunkSize = 16384;
+
+// One vertex at a time: the matrix columns stay in 4 registers, each vertex is 3 multiplies and 3 adds
+// A Vertex is 12 bytes, so the 4th lane is stored to a temporary instead of over the next vertex
+static void TransformVerticesAoS(const Matrix4& matrix, const Vertex* in, Vertex* out, size_t count)
+{
+	Float4 c0 = matrix.Columns[0].ToSimd();
+	Float4 c1 = matrix.Columns[1].ToSimd();
+	Float4 c2 = matrix.Columns[2].ToSimd();
+	Float4 c3 = matrix.Columns[3].ToSimd();
+	for (size_t i = 0; i < count; i++)
+	{
+		Float4 result = c0 * SimdSplat(in[i].x) + c1 * SimdSplat(in[i].y) + c2 * SimdSplat(in[i].z) + c3;
+		float values[4];
+		SimdStore(values, result);
+		out[i] = Vertex(values[0], values[1], values[2]);
+	}
+}
+
+// 4 vertices at a time: with separate x, y and z arrays each register holds the same component of 4 vertices, so nothing has to be shuffled
+// Each matrix element is splatted once, outside the loop. The adds happen in the same order as Matrix4 * Vector4, so the results are identical
+static void TransformVerticesSoA(const Matrix4& matrix, const float* x, const float* y, const float* z, float* outX, float* outY, float* outZ, size_t count)
+{
+	Float4 m[4][4];
+	for (int column = 0; column < 4; column++)
+	{
+		for (int row = 0; row < 4; row++)
+			m[row][column] = SimdSplat(matrix.Get(row, column));
+	}
+
+	size_t i = 0;
+	for (; i + 4 <= count; i += 4)
+	{
+		Float4 vx = SimdLoad(x + i), vy = SimdLoad(y + i), vz = SimdLoad(z + i);
+		Float4 rx = m[0][0] * vx + m[0][1] * vy + m[0][2] * vz + m[0][3];
+		Float4 ry = m[1][0] * vx + m[1][1] * vy + m[1][2] * vz + m[1][3];
+		Float4 rz = m[2][0] * vx + m[2][1] * vy + m[2][2] * vz + m[2][3];
+		SimdStore(outX + i, rx);
+		SimdStore(outY + i, ry);
+		SimdStore(outZ + i, rz);
+	}
+	for (; i < count; i++)
+	{
+		Vector3 result = TransformPoint(matrix, Vector3(x[i], y[i], z[i]));
+		outX[i] = result.x;
+		outY[i] = result.y;
+		outZ[i] = result.z;
+	}
+}
+
+void TransformVertices(const Matrix4& matrix, Span<const Vertex> in, Span<Vertex> out, size_t maxThreads)
+{
+	assert(in.Size() == out.Size());
+	JobSystem::Get().ParallelFor(out.Size(), s_ChunkSize, [&](size_t begin, size_t end)
+	{
+		TransformVerticesAoS(matrix, in.Data() + begin, out.Data() + begin, end - begin);
+	}, maxThreads);
+}
+
+void TransformVertices(const Matrix4& matrix, ConstVertexSoASpan in, VertexSoASpan out, size_t maxThreads)
+{
+	size_t size = out.Size();
+	assert(in.X.Size() == size && in.Y.Size() == size && in.Z.Size() == size && out.Y.Size() == size && out.Z.Size() == size);
+	JobSystem::Get().ParallelFor(size, s_ChunkSize, [&](size_t begin, size_t end)
+	{
+		TransformVerticesSoA(matrix, in.X.Data() + begin, in.Y.Data() + begin, in.Z.Data() + begin,
+			out.X.Data() + begin, out.Y.Data() + begin, out.Z.Data() + begin, end - begin);
+	}, maxThreads);
+}
@@ -0,0 +1,54 @@
+#pragma once
+
+#include <cstddef>
+
+#include "Matrix.h"
+#include "Quaternion.h"
+#include "Span.h"
+#include "Vector.h"
+#include "Vertex.h"
+
+// Position, rotation and scale of an object, the way an editor shows them
+// ToMatrix combines them into one matrix that scales first, then rotates, then moves
+struct Transform
+{
+	Vector3 Position;
+	Quaternion Rotation;
+	Vector3 Scale = Vector3(1.0f, 1.0f, 1.0f);
+
+	constexpr Matrix4 ToMatrix() const
+	{
+		Matrix3 rotation = ToMatrix3(Rotation);
+		Matrix3 linear(rotation.Columns[0] * Scale.x, rotation.Columns[1] * Scale.y, rotation.Columns[2] * Scale.z);
+		return Matrix4(linear, Position);
+	}
+
+	constexpr Vector3 TransformPoint(const Vector3& point) const { return Rotate(Rotation, point * Scale) + Position; }
+};
+
+// Separate x, y and z arrays of vertices. Use ConstVertexSoASpan for inputs
+template<typename T>
+struct BasicVertexSoASpan
+{
+	Span<T> X;
+	Span<T> Y;
+	Span<T> Z;
+
+	BasicVertexSoASpan() = default;
+	BasicVertexSoASpan(Span<T> x, Span<T> y, Span<T> z)
+		: X(x), Y(y), Z(z) {}
+	template<typename U>
+	BasicVertexSoASpan(const BasicVertexSoASpan<U>& other)
+		: X(other.X), Y(other.Y), Z(other.Z) {}
+
+	size_t Size() const { return X.Size(); }
+};
+using VertexSoASpan = BasicVertexSoASpan<float>;
+using ConstVertexSoASpan = BasicVertexSoASpan<const float>;
+
+// Applies one matrix to every vertex (as a point, so the translation moves it)
+// Arrays bigger than a few thousand vertices are split over the threads of the JobSystem. maxThreads limits that (0 means all of them)
+// Every version gives exactly the same floats as TransformPoint(matrix, Vector3(x, y, z)). out can be the same array as in
+// in and out must have the same number of vertices (and X, Y and Z the same number of floats)
+void TransformVertices(const Matrix4& matrix, Span<const Vertex> in, Span<Vertex> out, size_t maxThreads = 0);
+void TransformVertices(const Matrix4& matrix, ConstVertexSoASpan in, VertexSoASpan out, size_t maxThreads = 0);
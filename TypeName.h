@@ -0,0 +1,63 @@
+#pragma once
+
+#include <cstdint>
+#include <string_view>
+
+// Compile-time type names
+// The compiler already writes the name of every template argument into the name of the function it is instantiating (__PRETTY_FUNCTION__ or __FUNCSIG__)
+// That string lives in static memory for the whole programme, so we can cut the type name out of it and hand out a std::string_view to it
+// No allocation and no copy ever happens, and the hash is worked out by the compiler
+
+// 64-bit FNV-1a hash. Simple, and good enough for telling type names apart
+constexpr uint64_t HashString(std::string_view string)
+{
+	uint64_t hash = 14695981039346656037ull;
+	for (char c : string)
+	{
+		hash ^= (uint64_t)(unsigned char)c;
+		hash *= 1099511628211ull;
+	}
+	return hash;
+}
+
+template<typename T>
+constexpr std::string_view ExtractTypeName()
+{
+#if defined(_MSC_VER)
+	// "class std::basic_string_view<char,struct std::char_traits<char> > __cdecl ExtractTypeName<class InheritingClass>(void)"
+	std::string_view signature = __FUNCSIG__;
+	size_t start = signature.find("ExtractTypeName<") + sizeof("ExtractTypeName<") - 1;
+	size_t end = signature.rfind(">(void)");
+	std::string_view name = signature.substr(start, end - start);
+	for (std::string_view keyword : { std::string_view("class "), std::string_view("struct "), std::string_view("enum ") })
+	{
+		if (name.substr(0, keyword.size()) == keyword)
+			name.remove_prefix(keyword.size());
+	}
+	return name;
+#else
+	// GCC: "constexpr std::string_view ExtractTypeName() [with T = InheritingClass; std::string_view = std::basic_string_view<char>]"
+	// Clang: "std::string_view ExtractTypeName() [T = InheritingClass]"
+	std::string_view signature = __PRETTY_FUNCTION__;
+	size_t start = signature.find("T = ") + sizeof("T = ") - 1;
+	// From the back, because array types have a ] of their own ("int [3]")
+	size_t end = signature.rfind(';');
+	if (end == std::string_view::npos || end < start)
+		end = signature.rfind(']');
+	return signature.substr(start, end - start);
+#endif
+}
+
+// Both members are constants, so TypeInfo<T>::Name and TypeInfo<T>::Hash cost nothing to read at runtime
+template<typename T>
+struct TypeInfo
+{
+	static constexpr std::string_view Name = ExtractTypeName<T>();
+	static constexpr uint64_t Hash = HashString(Name);
+};
+
+template<typename T>
+constexpr std::string_view TypeName() { return TypeInfo<T>::Name; }
+
+template<typename T>
+constexpr uint64_t TypeHash() { return TypeInfo<T>::Hash; }
@@ -0,0 +1,265 @@
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+#include <string_view>
+#include <type_traits>
+#include <vector>
+
+#include "TypeName.h"
+
+// Runtime reflection
+// Every type we register gets a TypeDescriptor: its name, its size, functions to create and destroy it, and a list of its fields
+// Types are looked up by their 64-bit TypeHash<T>(), so finding one never compares strings
+// Everything in here is plain data and function pointers, so code that walks over objects (a serializer, an editor) doesn't need virtual calls
+
+struct FieldDescriptor
+{
+	std::string_view Name;
+	size_t Offset;				// In bytes from the start of the object
+	size_t Size;
+	uint64_t Type;				// TypeHash<T>() of the field's type
+	std::string_view TypeName;
+
+	void* Get(void* object) const { return static_cast<char*>(object) + Offset; }
+	const void* Get(const void* object) const { return static_cast<const char*>(object) + Offset; }
+};
+
+struct TypeDescriptor
+{
+	std::string_view Name;
+	uint64_t Hash = 0;
+	uint64_t BaseType = 0;		// 0 if this type was registered without a base
+	size_t Size = 0;
+	size_t Alignment = 0;
+	void* (*Create)() = nullptr;		// nullptr if the type has no default constructor
+	void (*Destroy)(void* object) = nullptr;
+	std::vector<FieldDescriptor> Fields;
+
+	const FieldDescriptor* FindField(std::string_view name) const
+	{
+		for (const FieldDescriptor& field : Fields)
+		{
+			if (field.Name == name)
+				return &field;
+		}
+		return nullptr;
+	}
+};
+
+// Gets the name, offset and type of a member in one go: builder.REFLECT_FIELD(Car, price)
+// The offset comes from a pointer to the member, not offsetof, because offsetof is only guaranteed for standard layout types (and Car holds a std::string)
+#define REFLECT_FIELD(Class, Member) Field(#Member, &Class::Member)
+
+class TypeRegistry;
+
+// Returned by TypeRegistry::Register<T>() to add the fields
+template<typename T>
+class TypeBuilder
+{
+private:
+	TypeRegistry& m_Registry;
+	size_t m_Index;
+
+	// Some memory the size of a T, so member and base class pointers can be applied to it to see where they point. No T is ever made in it
+	static char* Storage()
+	{
+		alignas(T) static char s_Storage[sizeof(T)];
+		return s_Storage;
+	}
+public:
+	TypeBuilder(TypeRegistry& registry, size_t index)
+		: m_Registry(registry), m_Index(index) {}
+
+	template<typename FieldType>
+	TypeBuilder& Field(std::string_view name, size_t offset);
+	// The member can belong to T or to one of its base classes
+	template<typename FieldType, typename Owner>
+	TypeBuilder& Field(std::string_view name, FieldType Owner::* member);
+
+	// Copies the fields of an already registered base class, so a Mercedes also has every field of a Car
+	template<typename Base>
+	TypeBuilder& Inherits();
+};
+
+class TypeRegistry
+{
+private:
+	static constexpr uint32_t s_EmptySlot = 0xffffffff;
+
+	std::vector<TypeDescriptor> m_Types;
+	std::vector<uint32_t> m_Table;	// Index into m_Types for every slot of the perfect hash table
+	uint64_t m_Seed = 0;
+	uint64_t m_Mask = 0;
+
+	template<typename T>
+	friend class TypeBuilder;
+public:
+	static TypeRegistry& Get()
+	{
+		static TypeRegistry s_Instance;
+		return s_Instance;
+	}
+
+	// Registering a type again starts its description over, instead of adding a second entry with the same hash (which Build() could never separate)
+	template<typename T>
+	TypeBuilder<T> Register()
+	{
+		if (const TypeDescriptor* existing = FindRegistered(TypeHash<T>()))
+		{
+			size_t index = existing - m_Types.data();
+			m_Types[index].BaseType = 0;
+			m_Types[index].Fields.clear();
+			return TypeBuilder<T>(*this, index);
+		}
+
+		TypeDescriptor type;
+		type.Name = TypeName<T>();
+		type.Hash = TypeHash<T>();
+		type.Size = sizeof(T);
+		type.Alignment = alignof(T);
+		if constexpr (std::is_default_constructible_v<T>)
+			type.Create = []() -> void* { return new T(); };
+		type.Destroy = [](void* object) { delete static_cast<T*>(object); };
+
+		m_Types.push_back(type);
+		return TypeBuilder<T>(*this, m_Types.size() - 1);
+	}
+
+	// Builds the lookup table. Call this once every type has been registered, at startup (and again if you register more types later)
+	// We keep trying seeds for our hash until every registered type lands in its own slot: a "perfect" hash with no collisions
+	// Finding a type is then one hash, one array read and one compare to make sure it isn't an unregistered type that landed in the same slot
+	// Returns false if no seed worked even with a table many times bigger than needed, which means two different types have the same 64-bit TypeHash
+	// Only the first of those can be found then, everything else still works
+	bool Build()
+	{
+		size_t tableSize = 1;
+		while (tableSize < m_Types.size() * 2)	// At most half full, so a working seed turns up after a few tries
+			tableSize *= 2;
+		const size_t maxTableSize = tableSize * 64;
+
+		for (; tableSize <= maxTableSize; tableSize *= 2)
+		{
+			m_Mask = tableSize - 1;
+			for (m_Seed = 1; m_Seed <= 1000; m_Seed++)
+			{
+				m_Table.assign(tableSize, s_EmptySlot);
+
+				bool collision = false;
+				for (size_t i = 0; i < m_Types.size() && !collision; i++)
+				{
+					uint32_t& slot = m_Table[Slot(m_Types[i].Hash)];
+					if (slot != s_EmptySlot)
+						collision = true;
+					slot = (uint32_t)i;
+				}
+				if (!collision)
+					return true;
+			}
+		}
+
+		m_Mask = maxTableSize - 1;
+		m_Seed = 1;
+		m_Table.assign(maxTableSize, s_EmptySlot);
+		for (size_t i = 0; i < m_Types.size(); i++)
+		{
+			uint32_t& slot = m_Table[Slot(m_Types[i].Hash)];
+			if (slot == s_EmptySlot)
+				slot = (uint32_t)i;
+		}
+		return false;
+	}
+
+	const TypeDescriptor* Find(uint64_t hash) const
+	{
+		if (m_Table.empty())
+			return nullptr;
+
+		uint32_t index = m_Table[Slot(hash)];
+		if (index == s_EmptySlot || m_Types[index].Hash != hash)
+			return nullptr;
+		return &m_Types[index];
+	}
+
+	template<typename T>
+	const TypeDescriptor* Find() const { return Find(TypeHash<T>()); }
+
+	// Returns nullptr for unknown types or types without a default constructor. Free the object with the descriptor's Destroy()
+	void* Create(uint64_t hash) const
+	{
+		const TypeDescriptor* type = Find(hash);
+		return type && type->Create ? type->Create() : nullptr;
+	}
+
+	const std::vector<TypeDescriptor>& GetTypes() const { return m_Types; }
+private:
+	// Only used while registering, before the table exists
+	const TypeDescriptor* FindRegistered(uint64_t hash) const
+	{
+		for (const TypeDescriptor& type : m_Types)
+		{
+			if (type.Hash == hash)
+				return &type;
+		}
+		return nullptr;
+	}
+
+	size_t Slot(uint64_t hash) const
+	{
+		// Mixes the bits of the hash with the seed (the finaliser from MurmurHash3), then keeps as many bits as the table needs
+		hash ^= m_Seed * 0x9e3779b97f4a7c15ull;
+		hash ^= hash >> 33;
+		hash *= 0xff51afd7ed558ccdull;
+		hash ^= hash >> 33;
+		return (size_t)(hash & m_Mask);
+	}
+};
+
+template<typename T>
+template<typename FieldType>
+TypeBuilder<T>& TypeBuilder<T>::Field(std::string_view name, size_t offset)
+{
+	FieldDescriptor field;
+	field.Name = name;
+	field.Offset = offset;
+	field.Size = sizeof(FieldType);
+	field.Type = TypeHash<FieldType>();
+	field.TypeName = TypeName<FieldType>();
+	m_Registry.m_Types[m_Index].Fields.push_back(field);
+	return *this;
+}
+
+template<typename T>
+template<typename FieldType, typename Owner>
+TypeBuilder<T>& TypeBuilder<T>::Field(std::string_view name, FieldType Owner::* member)
+{
+	static_assert(std::is_base_of_v<Owner, T>, "The member doesn't belong to T or one of its base classes");
+
+	T* object = reinterpret_cast<T*>(Storage());
+	size_t offset = reinterpret_cast<char*>(&(object->*member)) - Storage();
+	return Field<FieldType>(name, offset);
+}
+
+template<typename T>
+template<typename Base>
+TypeBuilder<T>& TypeBuilder<T>::Inherits()
+{
+	static_assert(std::is_base_of_v<Base, T>, "T does not inherit from Base");
+
+	// Where the Base part sits inside a T. This is 0 for single inheritance, but not always with multiple inheritance
+	// We need some address to do the cast with, and it must not be nullptr because casting nullptr always gives nullptr
+	T* derived = reinterpret_cast<T*>(Storage());
+	size_t baseOffset = reinterpret_cast<char*>(static_cast<Base*>(derived)) - Storage();
+
+	TypeDescriptor& type = m_Registry.m_Types[m_Index];
+	type.BaseType = TypeHash<Base>();
+	if (const TypeDescriptor* base = m_Registry.FindRegistered(TypeHash<Base>()))
+	{
+		for (FieldDescriptor field : base->Fields)
+		{
+			field.Offset += baseOffset;
+			type.Fields.push_back(field);
+		}
+	}
+	return *this;
+}
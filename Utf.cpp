@@ -0,0 +1,149 @@
+#include "Utf.h"
+#include "UtfImpl.h"
+
+namespace
+{
+	// The plain C++ version. It is always there, and the others have to give exactly the same results
+	struct ScalarIsa
+	{
+		static constexpr size_t Width = 1;
+	};
+}
+
+// Each of these lives in its own .cpp file, which is compiled for that instruction set
+// They return nullptr when this build doesn't have a version for it (for example on ARM)
+const UtfTable* GetUtfSse42();
+const UtfTable* GetUtfAvx2();
+
+const UtfTable* GetUtf(SimdLevel level)
+{
+	// Calling an AVX2 function on a CPU without AVX2 crashes the programme, so never hand one out
+	if (!GetCpuFeatures().Supports(level))
+		return nullptr;
+
+	switch (level)
+	{
+	case SimdLevel::Scalar:
+	{
+		static const UtfTable s_Table = MakeUtfTable<ScalarIsa>(SimdLevel::Scalar);
+		return &s_Table;
+	}
+	case SimdLevel::Sse42: return GetUtfSse42();
+	case SimdLevel::Avx2: return GetUtfAvx2();
+	default: return nullptr;	// The validator needs byte shuffles, which SSE2 doesn't have. AVX-512 isn't worth it for this
+	}
+}
+
+bool ValidateUtf8(Span<const char> text)
+{
+	return GetUtf().ValidateUtf8(text.Data(), text.Size());
+}
+
+size_t Utf8ToUtf16(Span<const char> text, Span<char16_t> out)
+{
+	if (out.Size() < text.Size())
+		return UtfInvalid;
+	return GetUtf().Utf8ToUtf16(text.Data(), text.Size(), out.Data());
+}
+
+size_t Utf8ToUtf32(Span<const char> text, Span<char32_t> out)
+{
+	if (out.Size() < text.Size())
+		return UtfInvalid;
+	return GetUtf().Utf8ToUtf32(text.Data(), text.Size(), out.Data());
+}
+
+size_t Utf16ToUtf8(Span<const char16_t> text, Span<char> out)
+{
+	if (out.Size() < 3 * text.Size())
+		return UtfInvalid;
+	return GetUtf().Utf16ToUtf8(text.Data(), text.Size(), out.Data());
+}
+
+size_t Utf32ToUtf8(Span<const char32_t> text, Span<char> out)
+{
+	if (out.Size() < 4 * text.Size())
+		return UtfInvalid;
+	return GetUtf().Utf32ToUtf8(text.Data(), text.Size(), out.Data());
+}
+
+// Nothing to gain from SIMD between UTF-16 and UTF-32 for now, both are a unit per character for nearly all text
+size_t Utf16ToUtf32(Span<const char16_t> text, Span<char32_t> out)
+{
+	if (out.Size() < text.Size())
+		return UtfInvalid;
+
+	size_t i = 0, written = 0;
+	while (i < text.Size())
+	{
+		char32_t character = text[i++];
+		if (character >= 0xD800 && character <= 0xDFFF)
+		{
+			if (character > 0xDBFF || i == text.Size() || text[i] < 0xDC00 || text[i] > 0xDFFF)
+				return UtfInvalid;
+			character = 0x10000 + ((character - 0xD800) << 10) + (text[i++] - 0xDC00);
+		}
+		out[written++] = character;
+	}
+	return written;
+}
+
+size_t Utf32ToUtf16(Span<const char32_t> text, Span<char16_t> out)
+{
+	if (out.Size() < 2 * text.Size())
+		return UtfInvalid;
+
+	size_t written = 0;
+	for (char32_t character : text)
+	{
+		if (character > 0x10FFFF || (character >= 0xD800 && character <= 0xDFFF))
+			return UtfInvalid;
+		written += EncodeUtf16(character, out.Data() + written);
+	}
+	return written;
+}
+
+bool Utf8ToUtf16(std::string_view text, std::u16string& out)
+{
+	out.resize(text.size());
+	size_t written = GetUtf().Utf8ToUtf16(text.data(), text.size(), &out[0]);
+	out.resize(written == UtfInvalid ? 0 : written);
+	return written != UtfInvalid;
+}
+
+bool Utf8ToUtf32(std::string_view text, std::u32string& out)
+{
+	out.resize(text.size());
+	size_t written = GetUtf().Utf8ToUtf32(text.data(), text.size(), &out[0]);
+	out.resize(written == UtfInvalid ? 0 : written);
+	return written != UtfInvalid;
+}
+
+// StringClass can't shrink, so the UTF-8 size is counted first. It is exact for valid text, and the conversion fails on anything else anyway
+// The SIMD versions store a whole register of bytes even when only some of them are ASCII, so every unit has to count for at least one byte, even on invalid text
+// That is why a surrogate pair is counted as 3 + 1 rather than 4 + 0
+bool Utf16ToUtf8(std::u16string_view text, StringClass& out)
+{
+	size_t size = 0;
+	for (char16_t unit : text)
+		size += unit < 0x80 ? 1 : unit < 0x800 ? 2 : unit < 0xDC00 ? 3 : unit < 0xE000 ? 1 : 3;
+
+	StringClass string = StringClass::CreateUninitialized(size);
+	if (size > 0 && GetUtf().Utf16ToUtf8(text.data(), text.size(), string.Data()) != size)
+		return false;
+	out = std::move(string);
+	return true;
+}
+
+bool Utf32ToUtf8(std::u32string_view text, StringClass& out)
+{
+	size_t size = 0;
+	for (char32_t character : text)
+		size += character < 0x80 ? 1 : character < 0x800 ? 2 : character < 0x10000 ? 3 : 4;
+
+	StringClass string = StringClass::CreateUninitialized(size);
+	if (size > 0 && GetUtf().Utf32ToUtf8(text.data(), text.size(), string.Data()) != size)
+		return false;
+	out = std::move(string);
+	return true;
+}
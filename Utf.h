@@ -0,0 +1,71 @@
+#pragma once
+
+#include <cstddef>
+#include <string>
+#include <string_view>
+
+#include "CpuFeatures.h"
+#include "Span.h"
+#include "StringClass.h"
+
+// Converting text between UTF-8, UTF-16 and UTF-32, and checking that it is valid
+// UTF-8 uses 1 to 4 bytes per character (code point), UTF-16 one or two 16-bit units (a surrogate pair), UTF-32 always one 32-bit unit
+//
+// Invalid input is never converted: overlong UTF-8, surrogates encoded in UTF-8 or UTF-32, unpaired UTF-16 surrogates, values above U+10FFFF, cut off sequences
+// Then the functions return UtfInvalid and what is in the output is undefined
+//
+// Most text is mostly ASCII, so every conversion loads a whole register of characters at once and copies the ASCII ones at the start of it straight across
+// Everything else goes through a plain decoder, which no longer has to check anything because the text was validated first
+// UTF-8 is validated with SIMD too, 16 (SSE4.2) or 32 (AVX2) bytes at a time, by looking up the top and bottom 4 bits of each byte and the byte before it in small tables
+// Every version gives the same results. The best one the CPU supports is picked the first time one is called
+
+inline constexpr size_t UtfInvalid = (size_t)-1;
+
+// The functions that have SIMD versions. The others are always scalar
+struct UtfTable
+{
+	SimdLevel Level;
+
+	bool (*ValidateUtf8)(const char* text, size_t size);
+	// These return how many units they wrote, or UtfInvalid. The output must be big enough (see below)
+	size_t (*Utf8ToUtf16)(const char* text, size_t size, char16_t* out);
+	size_t (*Utf8ToUtf32)(const char* text, size_t size, char32_t* out);
+	size_t (*Utf16ToUtf8)(const char16_t* text, size_t size, char* out);
+	size_t (*Utf32ToUtf8)(const char32_t* text, size_t size, char* out);
+};
+
+// The table for a specific level, or nullptr if this CPU (or this build) doesn't have it. Useful for comparing them
+const UtfTable* GetUtf(SimdLevel level);
+
+// The fastest table this CPU supports, picked once
+inline const UtfTable& GetUtf()
+{
+	static const UtfTable& s_Table = []() -> const UtfTable&
+	{
+		SimdLevel best = GetCpuFeatures().BestLevel();
+		for (int level = (int)best; level > (int)SimdLevel::Scalar; level--)
+		{
+			if (const UtfTable* table = GetUtf((SimdLevel)level))
+				return *table;
+		}
+		return *GetUtf(SimdLevel::Scalar);
+	}();
+	return s_Table;
+}
+
+bool ValidateUtf8(Span<const char> text);
+
+// Each returns how many units it wrote to out, or UtfInvalid if the text is invalid or out is smaller than the most it could need:
+// Utf8ToUtf16, Utf8ToUtf32 and Utf16ToUtf32: text.Size(). Utf16ToUtf8: 3 * text.Size(). Utf32ToUtf8: 4 * text.Size(). Utf32ToUtf16: 2 * text.Size()
+size_t Utf8ToUtf16(Span<const char> text, Span<char16_t> out);
+size_t Utf8ToUtf32(Span<const char> text, Span<char32_t> out);
+size_t Utf16ToUtf8(Span<const char16_t> text, Span<char> out);
+size_t Utf32ToUtf8(Span<const char32_t> text, Span<char> out);
+size_t Utf16ToUtf32(Span<const char16_t> text, Span<char32_t> out);
+size_t Utf32ToUtf16(Span<const char32_t> text, Span<char16_t> out);
+
+// Whole strings, sized exactly. A StringClass (or any std::string_view) is taken as UTF-8. They return false if the text is invalid
+bool Utf8ToUtf16(std::string_view text, std::u16string& out);
+bool Utf8ToUtf32(std::string_view text, std::u32string& out);
+bool Utf16ToUtf8(std::u16string_view text, StringClass& out);
+bool Utf32ToUtf8(std::u32string_view text, StringClass& out);
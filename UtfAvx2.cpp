@@ -0,0 +1,104 @@
+// Everything we include must come before the #pragma below. Otherwise it would be compiled for AVX2 too, and the linker could pick that version for the whole programme
+#include "Utf.h"
+
+#include <cstdint>
+#include <cstring>
+
+#if defined(PR_X86)
+#include <immintrin.h>
+
+// MSVC lets us use any intrinsic anywhere. GCC and Clang have to be told which instructions the functions below are allowed to use
+#if defined(__clang__)
+#pragma clang attribute push(__attribute__((target("avx2"))), apply_to = function)
+#elif defined(__GNUC__)
+#pragma GCC push_options
+#pragma GCC target("avx2")
+#endif
+
+#include "UtfImpl.h"
+
+namespace
+{
+	// 32 bytes per register. Shuffles and alignr work on each 16 byte half ("lane") separately, which is why the tables are loaded into both and Previous needs an extra step
+	struct Avx2
+	{
+		using Register = __m256i;
+		static constexpr size_t Width = 32;
+
+		static Register Load(const char* bytes) { return _mm256_loadu_si256(reinterpret_cast<const __m256i*>(bytes)); }
+		static Register LoadTable(const uint8_t* table) { return _mm256_broadcastsi128_si256(_mm_loadu_si128(reinterpret_cast<const __m128i*>(table))); }
+		static Register Zero() { return _mm256_setzero_si256(); }
+		static Register Splat(uint8_t value) { return _mm256_set1_epi8((char)value); }
+		static Register And(Register a, Register b) { return _mm256_and_si256(a, b); }
+		static Register Or(Register a, Register b) { return _mm256_or_si256(a, b); }
+		static Register Xor(Register a, Register b) { return _mm256_xor_si256(a, b); }
+		static Register SaturatingSubtract(Register a, Register b) { return _mm256_subs_epu8(a, b); }
+		static Register ShiftRight4(Register a) { return _mm256_and_si256(_mm256_srli_epi16(a, 4), _mm256_set1_epi8(0x0F)); }
+		static Register Lookup(Register table, Register indices) { return _mm256_shuffle_epi8(table, indices); }
+		// The permute makes a register of the last lane of previous and the first lane of input, so each lane of input can take its bytes from the lane before it
+		template<int N>
+		static Register Previous(Register input, Register previous)
+		{
+			return _mm256_alignr_epi8(input, _mm256_permute2x128_si256(previous, input, 0x21), 16 - N);
+		}
+		static bool Any(Register a) { return !_mm256_testz_si256(a, a); }
+		static uint32_t NonAscii(Register a) { return (uint32_t)_mm256_movemask_epi8(a); }
+
+		static void WidenTo16(char16_t* out, Register a)
+		{
+			_mm256_storeu_si256(reinterpret_cast<__m256i*>(out), _mm256_cvtepu8_epi16(_mm256_castsi256_si128(a)));
+			_mm256_storeu_si256(reinterpret_cast<__m256i*>(out + 16), _mm256_cvtepu8_epi16(_mm256_extracti128_si256(a, 1)));
+		}
+
+		static void WidenTo32(char32_t* out, Register a)
+		{
+			__m128i low = _mm256_castsi256_si128(a);
+			__m128i high = _mm256_extracti128_si256(a, 1);
+			_mm256_storeu_si256(reinterpret_cast<__m256i*>(out), _mm256_cvtepu8_epi32(low));
+			_mm256_storeu_si256(reinterpret_cast<__m256i*>(out + 8), _mm256_cvtepu8_epi32(_mm_srli_si128(low, 8)));
+			_mm256_storeu_si256(reinterpret_cast<__m256i*>(out + 16), _mm256_cvtepu8_epi32(high));
+			_mm256_storeu_si256(reinterpret_cast<__m256i*>(out + 24), _mm256_cvtepu8_epi32(_mm_srli_si128(high, 8)));
+		}
+
+		// Clamping every unit to 0x80 first makes each one that isn't ASCII come out of the (signed, saturating) packs as 0x80
+		// The packs work within each lane, so the results come out with their 8 byte (or 4 byte) pieces in the wrong order and are permuted back
+		static uint32_t NarrowAscii16(const char16_t* text, char* out)
+		{
+			Register limit = _mm256_set1_epi16(0x80);
+			Register a = _mm256_min_epu16(_mm256_loadu_si256(reinterpret_cast<const __m256i*>(text)), limit);
+			Register b = _mm256_min_epu16(_mm256_loadu_si256(reinterpret_cast<const __m256i*>(text + 16)), limit);
+			Register bytes = _mm256_permute4x64_epi64(_mm256_packus_epi16(a, b), _MM_SHUFFLE(3, 1, 2, 0));
+			_mm256_storeu_si256(reinterpret_cast<__m256i*>(out), bytes);
+			return (uint32_t)_mm256_movemask_epi8(bytes);
+		}
+
+		static uint32_t NarrowAscii32(const char32_t* text, char* out)
+		{
+			Register limit = _mm256_set1_epi32(0x80);
+			Register a = _mm256_min_epu32(_mm256_loadu_si256(reinterpret_cast<const __m256i*>(text)), limit);
+			Register b = _mm256_min_epu32(_mm256_loadu_si256(reinterpret_cast<const __m256i*>(text + 8)), limit);
+			Register c = _mm256_min_epu32(_mm256_loadu_si256(reinterpret_cast<const __m256i*>(text + 16)), limit);
+			Register d = _mm256_min_epu32(_mm256_loadu_si256(reinterpret_cast<const __m256i*>(text + 24)), limit);
+			Register packed = _mm256_packus_epi16(_mm256_packs_epi32(a, b), _mm256_packs_epi32(c, d));
+			Register bytes = _mm256_permutevar8x32_epi32(packed, _mm256_setr_epi32(0, 4, 1, 5, 2, 6, 3, 7));
+			_mm256_storeu_si256(reinterpret_cast<__m256i*>(out), bytes);
+			return (uint32_t)_mm256_movemask_epi8(bytes);
+		}
+	};
+}
+
+const UtfTable* GetUtfAvx2()
+{
+	static const UtfTable s_Table = MakeUtfTable<Avx2>(SimdLevel::Avx2);
+	return &s_Table;
+}
+
+#if defined(__clang__)
+#pragma clang attribute pop
+#elif defined(__GNUC__)
+#pragma GCC pop_options
+#endif
+
+#else
+const UtfTable* GetUtfAvx2() { return nullptr; }
+#endif
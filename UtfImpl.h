@@ -0,0 +1,417 @@
+#pragma once
+
+// The bodies of the UTF functions, written once for every instruction set
+// Only included by the Utf*.cpp files. Each one describes its registers in a small struct (see Sse42 in UtfSse42.cpp) and passes it in as Isa:
+//   Register, Width (bytes per register), Load, Zero, Splat, And, Or, Xor, SaturatingSubtract (per byte, stopping at 0),
+//   ShiftRight4 (the top 4 bits of each byte), LoadTable (16 bytes, in every 16 byte lane), Lookup (one table byte per index byte),
+//   Previous<N> (the register as if it started N bytes earlier, taking those bytes from the end of previous), Any (any bit set), NonAscii (a bit for each byte with its top bit set),
+//   WidenTo16 and WidenTo32 (store Width bytes as Width UTF-16 or UTF-32 units),
+//   NarrowAscii16 and NarrowAscii32 (store the next Width units as Width bytes, which are only right for the ASCII ones, and return a bit for each unit that isn't ASCII)
+// The scalar version has a Width of 1 and only runs the plain code, which also handles everything that isn't ASCII
+// Each .cpp file compiles this for a different CPU, and the linker must never mix those versions up. So everything in here is static,
+// and each Isa struct is in an anonymous namespace, because Avx2 and ScalarIsa are also the names of the ones in StringSearch and Vector2Kernels
+
+#include <cstddef>
+#include <cstdint>
+#include <cstring>
+
+#include "Utf.h"
+
+#if defined(_MSC_VER)
+#include <intrin.h>
+#endif
+
+// How many of the characters at the start are ASCII, from a mask with a bit set for each one that isn't
+template<size_t Width>
+static inline size_t AsciiPrefix(uint32_t nonAscii)
+{
+	if (nonAscii == 0)
+		return Width;
+#if defined(_MSC_VER)
+	unsigned long index;
+	_BitScanForward(&index, nonAscii);
+	return (size_t)index;
+#else
+	return (size_t)__builtin_ctz(nonAscii);
+#endif
+}
+
+// Each byte of UTF-8 is one of:
+//   0xxxxxxx  ASCII, a whole character
+//   10xxxxxx  a continuation byte, which carries 6 more bits of the character
+//   110xxxxx, 1110xxxx, 11110xxx  the first byte of a 2, 3 or 4 byte character
+// Apart from the lengths, a few more combinations aren't allowed: C0 and C1 (overlong, the character fits in 1 byte), E0 80-9F and F0 80-8F (overlong),
+// ED A0-BF (surrogates, which only exist in UTF-16) and F4 90-BF or F5-FF (above U+10FFFF)
+static bool ValidateUtf8Scalar(const unsigned char* text, size_t size)
+{
+	size_t i = 0;
+	while (i < size)
+	{
+		unsigned char lead = text[i];
+		if (lead < 0x80)
+		{
+			i++;
+			continue;
+		}
+
+		size_t length;
+		unsigned char low = 0x80, high = 0xBF;	// What the second byte may be
+		if (lead >= 0xC2 && lead <= 0xDF)
+			length = 2;
+		else if (lead >= 0xE0 && lead <= 0xEF)
+		{
+			length = 3;
+			if (lead == 0xE0)
+				low = 0xA0;
+			else if (lead == 0xED)
+				high = 0x9F;
+		}
+		else if (lead >= 0xF0 && lead <= 0xF4)
+		{
+			length = 4;
+			if (lead == 0xF0)
+				low = 0x90;
+			else if (lead == 0xF4)
+				high = 0x8F;
+		}
+		else
+			return false;
+
+		if (size - i < length || text[i + 1] < low || text[i + 1] > high)
+			return false;
+		for (size_t k = 2; k < length; k++)
+		{
+			if ((text[i + k] & 0xC0) != 0x80)
+				return false;
+		}
+		i += length;
+	}
+	return true;
+}
+
+// Only for text that has already been validated, starting at a byte that isn't ASCII. Returns how many bytes it used
+static inline size_t DecodeUtf8(const unsigned char* text, char32_t& character)
+{
+	if (text[0] < 0xE0)
+	{
+		character = ((char32_t)(text[0] & 0x1F) << 6) | (text[1] & 0x3F);
+		return 2;
+	}
+	if (text[0] < 0xF0)
+	{
+		character = ((char32_t)(text[0] & 0x0F) << 12) | ((char32_t)(text[1] & 0x3F) << 6) | (text[2] & 0x3F);
+		return 3;
+	}
+	character = ((char32_t)(text[0] & 0x07) << 18) | ((char32_t)(text[1] & 0x3F) << 12) | ((char32_t)(text[2] & 0x3F) << 6) | (text[3] & 0x3F);
+	return 4;
+}
+
+// character must be valid (not a surrogate, at most U+10FFFF). Returns how many bytes it wrote
+static inline size_t EncodeUtf8(char32_t character, char* out)
+{
+	if (character < 0x80)
+	{
+		out[0] = (char)character;
+		return 1;
+	}
+	if (character < 0x800)
+	{
+		out[0] = (char)(0xC0 | (character >> 6));
+		out[1] = (char)(0x80 | (character & 0x3F));
+		return 2;
+	}
+	if (character < 0x10000)
+	{
+		out[0] = (char)(0xE0 | (character >> 12));
+		out[1] = (char)(0x80 | ((character >> 6) & 0x3F));
+		out[2] = (char)(0x80 | (character & 0x3F));
+		return 3;
+	}
+	out[0] = (char)(0xF0 | (character >> 18));
+	out[1] = (char)(0x80 | ((character >> 12) & 0x3F));
+	out[2] = (char)(0x80 | ((character >> 6) & 0x3F));
+	out[3] = (char)(0x80 | (character & 0x3F));
+	return 4;
+}
+
+// Characters above U+FFFF become a surrogate pair. Returns how many units it wrote
+static inline size_t EncodeUtf16(char32_t character, char16_t* out)
+{
+	if (character < 0x10000)
+	{
+		out[0] = (char16_t)character;
+		return 1;
+	}
+	character -= 0x10000;
+	out[0] = (char16_t)(0xD800 + (character >> 10));
+	out[1] = (char16_t)(0xDC00 + (character & 0x3FF));
+	return 2;
+}
+
+// The SIMD validator (the "lookup" algorithm by John Keiser and Daniel Lemire)
+// Every error can be spotted from two neighbouring bytes, except a missing or extra continuation byte after a 3 or 4 byte lead
+// Each possible error gets a bit. The three tables give, for the top 4 bits of the first byte, the bottom 4 bits of the first byte and the top 4 bits of the second byte,
+// which errors that value allows. A bit that survives all three (ANDed together) is an error
+enum : uint8_t
+{
+	Utf8TooShort = 1 << 0,		// A lead byte followed by ASCII or another lead byte
+	Utf8TooLong = 1 << 1,		// ASCII followed by a continuation byte
+	Utf8Overlong3 = 1 << 2,		// E0 80-9F
+	Utf8TooLarge = 1 << 3,		// Above U+10FFFF
+	Utf8Surrogate = 1 << 4,		// ED A0-BF
+	Utf8Overlong2 = 1 << 5,		// C0 or C1
+	Utf8TooLarge1000 = 1 << 6,	// Shares a bit with Utf8Overlong4, because they can be told apart by the first byte
+	Utf8Overlong4 = 1 << 6,		// F0 80-8F
+	Utf8TwoContinuations = 1 << 7,	// Two continuation bytes in a row. Only an error when the byte 2 or 3 before isn't a 3 or 4 byte lead, which is checked separately
+	Utf8Carry = Utf8TooShort | Utf8TooLong | Utf8TwoContinuations,
+};
+
+static const uint8_t s_Utf8Byte1High[16] =
+{
+	// 0xxx: ASCII
+	Utf8TooLong, Utf8TooLong, Utf8TooLong, Utf8TooLong, Utf8TooLong, Utf8TooLong, Utf8TooLong, Utf8TooLong,
+	// 10xx: continuation
+	Utf8TwoContinuations, Utf8TwoContinuations, Utf8TwoContinuations, Utf8TwoContinuations,
+	// 1100, 1101: 2 byte lead
+	Utf8TooShort | Utf8Overlong2, Utf8TooShort,
+	// 1110: 3 byte lead
+	Utf8TooShort | Utf8Overlong3 | Utf8Surrogate,
+	// 1111: 4 byte lead
+	Utf8TooShort | Utf8TooLarge | Utf8TooLarge1000 | Utf8Overlong4,
+};
+
+static const uint8_t s_Utf8Byte1Low[16] =
+{
+	Utf8Carry | Utf8Overlong3 | Utf8Overlong2 | Utf8Overlong4,	// xxxx0000
+	Utf8Carry | Utf8Overlong2,									// xxxx0001
+	Utf8Carry, Utf8Carry,
+	Utf8Carry | Utf8TooLarge,									// xxxx0100
+	Utf8Carry | Utf8TooLarge | Utf8TooLarge1000,				// xxxx0101 and up
+	Utf8Carry | Utf8TooLarge | Utf8TooLarge1000,
+	Utf8Carry | Utf8TooLarge | Utf8TooLarge1000,
+	Utf8Carry | Utf8TooLarge | Utf8TooLarge1000,
+	Utf8Carry | Utf8TooLarge | Utf8TooLarge1000,
+	Utf8Carry | Utf8TooLarge | Utf8TooLarge1000,
+	Utf8Carry | Utf8TooLarge | Utf8TooLarge1000,
+	Utf8Carry | Utf8TooLarge | Utf8TooLarge1000,
+	Utf8Carry | Utf8TooLarge | Utf8TooLarge1000 | Utf8Surrogate,	// xxxx1101
+	Utf8Carry | Utf8TooLarge | Utf8TooLarge1000,
+	Utf8Carry | Utf8TooLarge | Utf8TooLarge1000,
+};
+
+static const uint8_t s_Utf8Byte2High[16] =
+{
+	// 0xxx: ASCII
+	Utf8TooShort, Utf8TooShort, Utf8TooShort, Utf8TooShort, Utf8TooShort, Utf8TooShort, Utf8TooShort, Utf8TooShort,
+	// 1000, 1001, 101x: continuation
+	Utf8TooLong | Utf8Overlong2 | Utf8TwoContinuations | Utf8Overlong3 | Utf8TooLarge1000 | Utf8Overlong4,
+	Utf8TooLong | Utf8Overlong2 | Utf8TwoContinuations | Utf8Overlong3 | Utf8TooLarge,
+	Utf8TooLong | Utf8Overlong2 | Utf8TwoContinuations | Utf8Surrogate | Utf8TooLarge,
+	Utf8TooLong | Utf8Overlong2 | Utf8TwoContinuations | Utf8Surrogate | Utf8TooLarge,
+	// 11xx: lead
+	Utf8TooShort, Utf8TooShort, Utf8TooShort, Utf8TooShort,
+};
+
+template<typename Isa>
+static bool ValidateUtf8Kernel(const char* text, size_t size)
+{
+	if constexpr (Isa::Width == 1)
+		return ValidateUtf8Scalar(reinterpret_cast<const unsigned char*>(text), size);
+	else
+	{
+		using Register = typename Isa::Register;
+		const Register byte1High = Isa::LoadTable(s_Utf8Byte1High);
+		const Register byte1Low = Isa::LoadTable(s_Utf8Byte1Low);
+		const Register byte2High = Isa::LoadTable(s_Utf8Byte2High);
+		const Register lowBits = Isa::Splat(0x0F);
+
+		Register error = Isa::Zero();
+		Register previous = Isa::Zero();
+
+		// No shortcut for registers that are all ASCII: in text that mixes the two, whether the next one is would be guessed wrong all the time, and that costs more than the checks
+		auto check = [&](Register input)
+		{
+			Register previous1 = Isa::template Previous<1>(input, previous);
+			Register specialCases = Isa::And(Isa::And(Isa::Lookup(byte1High, Isa::ShiftRight4(previous1)), Isa::Lookup(byte1Low, Isa::And(previous1, lowBits))),
+				Isa::Lookup(byte2High, Isa::ShiftRight4(input)));
+
+			// Continuation bytes that follow a 3 byte lead by 2, or a 4 byte lead by 2 or 3, have to be there, and are the only places two continuations in a row are fine
+			// Those leads become >= 0x80 after the saturating subtract, everything else becomes < 0x80
+			Register previous2 = Isa::template Previous<2>(input, previous);
+			Register previous3 = Isa::template Previous<3>(input, previous);
+			Register mustContinue = Isa::And(Isa::Or(Isa::SaturatingSubtract(previous2, Isa::Splat(0xE0 - 0x80)), Isa::SaturatingSubtract(previous3, Isa::Splat(0xF0 - 0x80))), Isa::Splat(0x80));
+			error = Isa::Or(error, Isa::Xor(mustContinue, specialCases));
+
+			previous = input;
+		};
+
+		size_t i = 0;
+		for (; i + Isa::Width <= size; i += Isa::Width)
+			check(Isa::Load(text + i));
+
+		// The rest, padded with zeros. Zeros are ASCII, so a character cut off at the end is caught like any other that is too short
+		char last[32] = {};
+		if (i < size)
+			memcpy(last, text + i, size - i);
+		check(Isa::Load(last));
+
+		return !Isa::Any(error);
+	}
+}
+
+template<typename Isa>
+static size_t Utf8ToUtf16Kernel(const char* text, size_t size, char16_t* out)
+{
+	if (!ValidateUtf8Kernel<Isa>(text, size))
+		return UtfInvalid;
+
+	const unsigned char* bytes = reinterpret_cast<const unsigned char*>(text);
+	size_t i = 0, written = 0;
+	while (i < size)
+	{
+		if (bytes[i] < 0x80)
+		{
+			if constexpr (Isa::Width > 1)
+			{
+				while (i + Isa::Width <= size)
+				{
+					// Widens all of them, but only keeps the ASCII ones at the start. The rest are written over next
+					typename Isa::Register input = Isa::Load(text + i);
+					Isa::WidenTo16(out + written, input);
+					size_t ascii = AsciiPrefix<Isa::Width>(Isa::NonAscii(input));
+					i += ascii;
+					written += ascii;
+					if (ascii < Isa::Width)
+						break;
+				}
+			}
+			// The last few ASCII characters before the end
+			while (i < size && bytes[i] < 0x80)
+				out[written++] = bytes[i++];
+			continue;
+		}
+
+		char32_t character;
+		i += DecodeUtf8(bytes + i, character);
+		written += EncodeUtf16(character, out + written);
+	}
+	return written;
+}
+
+template<typename Isa>
+static size_t Utf8ToUtf32Kernel(const char* text, size_t size, char32_t* out)
+{
+	if (!ValidateUtf8Kernel<Isa>(text, size))
+		return UtfInvalid;
+
+	const unsigned char* bytes = reinterpret_cast<const unsigned char*>(text);
+	size_t i = 0, written = 0;
+	while (i < size)
+	{
+		if (bytes[i] < 0x80)
+		{
+			if constexpr (Isa::Width > 1)
+			{
+				while (i + Isa::Width <= size)
+				{
+					// Widens all of them, but only keeps the ASCII ones at the start. The rest are written over next
+					typename Isa::Register input = Isa::Load(text + i);
+					Isa::WidenTo32(out + written, input);
+					size_t ascii = AsciiPrefix<Isa::Width>(Isa::NonAscii(input));
+					i += ascii;
+					written += ascii;
+					if (ascii < Isa::Width)
+						break;
+				}
+			}
+			while (i < size && bytes[i] < 0x80)
+				out[written++] = bytes[i++];
+			continue;
+		}
+
+		i += DecodeUtf8(bytes + i, out[written++]);
+	}
+	return written;
+}
+
+template<typename Isa>
+static size_t Utf16ToUtf8Kernel(const char16_t* text, size_t size, char* out)
+{
+	size_t i = 0, written = 0;
+	while (i < size)
+	{
+		if (text[i] < 0x80)
+		{
+			if constexpr (Isa::Width > 1)
+			{
+				while (i + Isa::Width <= size)
+				{
+					size_t ascii = AsciiPrefix<Isa::Width>(Isa::NarrowAscii16(text + i, out + written));
+					i += ascii;
+					written += ascii;
+					if (ascii < Isa::Width)
+						break;
+				}
+			}
+			while (i < size && text[i] < 0x80)
+				out[written++] = (char)text[i++];
+			continue;
+		}
+
+		char32_t character = text[i++];
+		if (character >= 0xD800 && character <= 0xDFFF)
+		{
+			// Has to be a high surrogate followed by a low one
+			if (character > 0xDBFF || i == size || text[i] < 0xDC00 || text[i] > 0xDFFF)
+				return UtfInvalid;
+			character = 0x10000 + ((character - 0xD800) << 10) + (text[i++] - 0xDC00);
+		}
+		written += EncodeUtf8(character, out + written);
+	}
+	return written;
+}
+
+template<typename Isa>
+static size_t Utf32ToUtf8Kernel(const char32_t* text, size_t size, char* out)
+{
+	size_t i = 0, written = 0;
+	while (i < size)
+	{
+		if (text[i] < 0x80)
+		{
+			if constexpr (Isa::Width > 1)
+			{
+				while (i + Isa::Width <= size)
+				{
+					size_t ascii = AsciiPrefix<Isa::Width>(Isa::NarrowAscii32(text + i, out + written));
+					i += ascii;
+					written += ascii;
+					if (ascii < Isa::Width)
+						break;
+				}
+			}
+			while (i < size && text[i] < 0x80)
+				out[written++] = (char)text[i++];
+			continue;
+		}
+
+		char32_t character = text[i++];
+		if (character > 0x10FFFF || (character >= 0xD800 && character <= 0xDFFF))
+			return UtfInvalid;
+		written += EncodeUtf8(character, out + written);
+	}
+	return written;
+}
+
+template<typename Isa>
+static UtfTable MakeUtfTable(SimdLevel level)
+{
+	UtfTable table;
+	table.Level = level;
+	table.ValidateUtf8 = ValidateUtf8Kernel<Isa>;
+	table.Utf8ToUtf16 = Utf8ToUtf16Kernel<Isa>;
+	table.Utf8ToUtf32 = Utf8ToUtf32Kernel<Isa>;
+	table.Utf16ToUtf8 = Utf16ToUtf8Kernel<Isa>;
+	table.Utf32ToUtf8 = Utf32ToUtf8Kernel<Isa>;
+	return table;
+}
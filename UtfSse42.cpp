@@ -0,0 +1,100 @@
+// Everything we include must come before the #pragma below. Otherwise it would be compiled for SSE4.2 too, and the linker could pick that version for the whole programme
+#include "Utf.h"
+
+#include <cstdint>
+#include <cstring>
+
+#if defined(PR_X86)
+#include <immintrin.h>
+
+// MSVC lets us use any intrinsic anywhere. GCC and Clang have to be told which instructions the functions below are allowed to use
+// Only the SSSE3 byte shuffle and the SSE4.1 widening and unsigned minimum are newer than SSE2, and every CPU with SSE4.2 has them
+#if defined(__clang__)
+#pragma clang attribute push(__attribute__((target("sse4.2"))), apply_to = function)
+#elif defined(__GNUC__)
+#pragma GCC push_options
+#pragma GCC target("sse4.2")
+#endif
+
+#include "UtfImpl.h"
+
+namespace
+{
+	// 16 bytes per register
+	struct Sse42
+	{
+		using Register = __m128i;
+		static constexpr size_t Width = 16;
+
+		static Register Load(const char* bytes) { return _mm_loadu_si128(reinterpret_cast<const __m128i*>(bytes)); }
+		static Register LoadTable(const uint8_t* table) { return _mm_loadu_si128(reinterpret_cast<const __m128i*>(table)); }
+		static Register Zero() { return _mm_setzero_si128(); }
+		static Register Splat(uint8_t value) { return _mm_set1_epi8((char)value); }
+		static Register And(Register a, Register b) { return _mm_and_si128(a, b); }
+		static Register Or(Register a, Register b) { return _mm_or_si128(a, b); }
+		static Register Xor(Register a, Register b) { return _mm_xor_si128(a, b); }
+		static Register SaturatingSubtract(Register a, Register b) { return _mm_subs_epu8(a, b); }
+		// There is no 8-bit shift, so shift 16-bit units and clear the bits that came in from the byte above
+		static Register ShiftRight4(Register a) { return _mm_and_si128(_mm_srli_epi16(a, 4), _mm_set1_epi8(0x0F)); }
+		static Register Lookup(Register table, Register indices) { return _mm_shuffle_epi8(table, indices); }
+		template<int N>
+		static Register Previous(Register input, Register previous) { return _mm_alignr_epi8(input, previous, 16 - N); }
+		static bool Any(Register a) { return !_mm_testz_si128(a, a); }
+		static uint32_t NonAscii(Register a) { return (uint32_t)_mm_movemask_epi8(a); }
+
+		static void WidenTo16(char16_t* out, Register a)
+		{
+			Register zero = _mm_setzero_si128();
+			_mm_storeu_si128(reinterpret_cast<__m128i*>(out), _mm_unpacklo_epi8(a, zero));
+			_mm_storeu_si128(reinterpret_cast<__m128i*>(out + 8), _mm_unpackhi_epi8(a, zero));
+		}
+
+		static void WidenTo32(char32_t* out, Register a)
+		{
+			for (int i = 0; i < 4; i++)
+			{
+				_mm_storeu_si128(reinterpret_cast<__m128i*>(out + 4 * i), _mm_cvtepu8_epi32(a));
+				a = _mm_srli_si128(a, 4);
+			}
+		}
+
+		// The packs saturate, and treat their input as signed. Clamping every unit to 0x80 first makes each one that isn't ASCII come out as 0x80, with the top bit set
+		static uint32_t NarrowAscii16(const char16_t* text, char* out)
+		{
+			Register limit = _mm_set1_epi16(0x80);
+			Register a = _mm_min_epu16(_mm_loadu_si128(reinterpret_cast<const __m128i*>(text)), limit);
+			Register b = _mm_min_epu16(_mm_loadu_si128(reinterpret_cast<const __m128i*>(text + 8)), limit);
+			Register bytes = _mm_packus_epi16(a, b);
+			_mm_storeu_si128(reinterpret_cast<__m128i*>(out), bytes);
+			return (uint32_t)_mm_movemask_epi8(bytes);
+		}
+
+		static uint32_t NarrowAscii32(const char32_t* text, char* out)
+		{
+			Register limit = _mm_set1_epi32(0x80);
+			Register a = _mm_min_epu32(_mm_loadu_si128(reinterpret_cast<const __m128i*>(text)), limit);
+			Register b = _mm_min_epu32(_mm_loadu_si128(reinterpret_cast<const __m128i*>(text + 4)), limit);
+			Register c = _mm_min_epu32(_mm_loadu_si128(reinterpret_cast<const __m128i*>(text + 8)), limit);
+			Register d = _mm_min_epu32(_mm_loadu_si128(reinterpret_cast<const __m128i*>(text + 12)), limit);
+			Register bytes = _mm_packus_epi16(_mm_packs_epi32(a, b), _mm_packs_epi32(c, d));
+			_mm_storeu_si128(reinterpret_cast<__m128i*>(out), bytes);
+			return (uint32_t)_mm_movemask_epi8(bytes);
+		}
+	};
+}
+
+const UtfTable* GetUtfSse42()
+{
+	static const UtfTable s_Table = MakeUtfTable<Sse42>(SimdLevel::Sse42);
+	return &s_Table;
+}
+
+#if defined(__clang__)
+#pragma clang attribute pop
+#elif defined(__GNUC__)
+#pragma GCC pop_options
+#endif
+
+#else
+const UtfTable* GetUtfSse42() { return nullptr; }
+#endif
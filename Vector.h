@@ -0,0 +1,302 @@
+#pragma once
+
+#include <cmath>
+#include <iostream>
+
+#include "ConstexprMath.h"
+#include "Simd.h"
+
+// 2, 3 and 4 component vectors
+// Vector3 and Vector4 do their maths with the SIMD wrappers in Simd.h
+// Vector2 stays plain floats: moving 2 floats in and out of a 4-wide register costs more than the one instruction it saves
+// (for lots of Vector2s at once, working on whole arrays is what makes SIMD worth it)
+// Everything is constexpr, so constant vectors and the maths on them can be worked out by the compiler (see ConstexprMath.h)
+
+struct Vector2
+{
+	float x, y;
+
+	constexpr Vector2()
+		: x(0.0f), y(0.0f) {}
+	constexpr Vector2(float x, float y)
+		: x(x), y(y) {}
+
+	// Add function to avoid operator overloading
+	constexpr Vector2 Add(const Vector2& other) const
+	{
+		return Vector2(x + other.x, y + other.y);
+	}
+	// Add function with operator overloads
+	constexpr Vector2 operator+(const Vector2& other) const
+	{
+		//return Vector2(x + other.x, y + other.y);
+		return Add(other);
+	}
+
+	constexpr Vector2 operator-(const Vector2& other) const
+	{
+		return Vector2(x - other.x, y - other.y);
+	}
+
+	constexpr Vector2 Multiply(const Vector2& other) const
+	{
+		return Vector2(x * other.x, y * other.y);
+	}
+	constexpr Vector2 operator*(const Vector2& other) const
+	{
+		//return Vector2(x * other.x, y * other.y);
+		return Multiply(other);
+	}
+
+	constexpr Vector2 operator*(float scale) const
+	{
+		return Vector2(x * scale, y * scale);
+	}
+
+	constexpr Vector2 operator/(const Vector2& other) const
+	{
+		return Vector2(x / other.x, y / other.y);
+	}
+
+	constexpr bool operator==(const Vector2& other) const
+	{
+		return other.x == x && other.y == y;
+	}
+
+	constexpr bool operator!=(const Vector2& other) const
+	{
+		return other.x != x || other.y != y;
+	}
+};
+
+struct Vector3
+{
+	float x, y, z;
+
+	constexpr Vector3()
+		: x(0.0f), y(0.0f), z(0.0f) {}
+	constexpr Vector3(float x, float y, float z)
+		: x(x), y(y), z(z) {}
+
+	// The unused 4th lane is always 0, so it doesn't change dot products or lengths
+	Float4 ToSimd() const { return SimdSet(x, y, z, 0.0f); }
+	static Vector3 FromSimd(Float4 value)
+	{
+		float values[4];
+		SimdStore(values, value);
+		return Vector3(values[0], values[1], values[2]);
+	}
+
+	// The SIMD registers can't be used while compiling, so constant expressions take the plain float path. It rounds exactly like the SIMD one
+	constexpr Vector3 operator+(const Vector3& other) const
+	{
+		if (IsConstantEvaluated())
+			return Vector3(x + other.x, y + other.y, z + other.z);
+		return FromSimd(ToSimd() + other.ToSimd());
+	}
+	constexpr Vector3 operator-(const Vector3& other) const
+	{
+		if (IsConstantEvaluated())
+			return Vector3(x - other.x, y - other.y, z - other.z);
+		return FromSimd(ToSimd() - other.ToSimd());
+	}
+	constexpr Vector3 operator*(const Vector3& other) const
+	{
+		if (IsConstantEvaluated())
+			return Vector3(x * other.x, y * other.y, z * other.z);
+		return FromSimd(ToSimd() * other.ToSimd());
+	}
+	constexpr Vector3 operator*(float scale) const
+	{
+		if (IsConstantEvaluated())
+			return Vector3(x * scale, y * scale, z * scale);
+		return FromSimd(ToSimd() * SimdSplat(scale));
+	}
+	constexpr Vector3 operator/(const Vector3& other) const
+	{
+		if (IsConstantEvaluated())
+			return Vector3(x / other.x, y / other.y, z / other.z);
+		return FromSimd(ToSimd() / SimdSet(other.x, other.y, other.z, 1.0f));	// 1 in the last lane, so we don't divide 0 by 0
+	}
+
+	constexpr bool operator==(const Vector3& other) const { return x == other.x && y == other.y && z == other.z; }
+	constexpr bool operator!=(const Vector3& other) const { return !(*this == other); }
+};
+
+// Aligned to 16 bytes so the whole vector can be loaded into a register in one go
+struct alignas(16) Vector4
+{
+	float x, y, z, w;
+
+	constexpr Vector4()
+		: x(0.0f), y(0.0f), z(0.0f), w(0.0f) {}
+	constexpr Vector4(float x, float y, float z, float w)
+		: x(x), y(y), z(z), w(w) {}
+
+	Float4 ToSimd() const { return SimdLoad(&x); }
+	static Vector4 FromSimd(Float4 value)
+	{
+		Vector4 result;
+		SimdStore(&result.x, value);
+		return result;
+	}
+
+	constexpr Vector4 operator+(const Vector4& other) const
+	{
+		if (IsConstantEvaluated())
+			return Vector4(x + other.x, y + other.y, z + other.z, w + other.w);
+		return FromSimd(ToSimd() + other.ToSimd());
+	}
+	constexpr Vector4 operator-(const Vector4& other) const
+	{
+		if (IsConstantEvaluated())
+			return Vector4(x - other.x, y - other.y, z - other.z, w - other.w);
+		return FromSimd(ToSimd() - other.ToSimd());
+	}
+	constexpr Vector4 operator*(const Vector4& other) const
+	{
+		if (IsConstantEvaluated())
+			return Vector4(x * other.x, y * other.y, z * other.z, w * other.w);
+		return FromSimd(ToSimd() * other.ToSimd());
+	}
+	constexpr Vector4 operator*(float scale) const
+	{
+		if (IsConstantEvaluated())
+			return Vector4(x * scale, y * scale, z * scale, w * scale);
+		return FromSimd(ToSimd() * SimdSplat(scale));
+	}
+	constexpr Vector4 operator/(const Vector4& other) const
+	{
+		if (IsConstantEvaluated())
+			return Vector4(x / other.x, y / other.y, z / other.z, w / other.w);
+		return FromSimd(ToSimd() / other.ToSimd());
+	}
+
+	constexpr bool operator==(const Vector4& other) const { return x == other.x && y == other.y && z == other.z && w == other.w; }
+	constexpr bool operator!=(const Vector4& other) const { return !(*this == other); }
+};
+
+// Vector2
+constexpr float Dot(const Vector2& a, const Vector2& b) { return a.x * b.x + a.y * b.y; }
+constexpr float Length(const Vector2& a) { return Sqrt(Dot(a, a)); }
+// A vector with length 0 has no direction, so it is returned unchanged
+constexpr Vector2 Normalize(const Vector2& a)
+{
+	float length = Length(a);
+	return length > 0.0f ? Vector2(a.x / length, a.y / length) : a;
+}
+constexpr Vector2 Lerp(const Vector2& a, const Vector2& b, float t) { return a + (b - a) * t; }
+constexpr Vector2 Min(const Vector2& a, const Vector2& b) { return Vector2(a.x < b.x ? a.x : b.x, a.y < b.y ? a.y : b.y); }
+constexpr Vector2 Max(const Vector2& a, const Vector2& b) { return Vector2(a.x > b.x ? a.x : b.x, a.y > b.y ? a.y : b.y); }
+
+// Vector3
+// The constant expression paths add in the same order as SimdHorizontalAdd: (x + y) + (z + w), with w always 0
+constexpr float Dot(const Vector3& a, const Vector3& b)
+{
+	if (IsConstantEvaluated())
+		return (a.x * b.x + a.y * b.y) + (a.z * b.z + 0.0f);
+	return SimdGetX(SimdDot4(a.ToSimd(), b.ToSimd()));
+}
+constexpr Vector3 Cross(const Vector3& a, const Vector3& b)
+{
+	if (IsConstantEvaluated())
+		return Vector3(a.y * b.z - a.z * b.y, a.z * b.x - a.x * b.z, a.x * b.y - a.y * b.x);
+	return Vector3::FromSimd(SimdCross3(a.ToSimd(), b.ToSimd()));
+}
+constexpr float Length(const Vector3& a)
+{
+	if (IsConstantEvaluated())
+		return ConstexprSqrt(Dot(a, a));
+	return SimdGetX(SimdSqrt(SimdDot4(a.ToSimd(), a.ToSimd())));
+}
+constexpr Vector3 Normalize(const Vector3& a)
+{
+	if (IsConstantEvaluated())
+	{
+		float length = Length(a);
+		return length > 0.0f ? Vector3(a.x / length, a.y / length, a.z / length) : a;
+	}
+	Float4 value = a.ToSimd();
+	Float4 length = SimdSqrt(SimdDot4(value, value));
+	return SimdGetX(length) > 0.0f ? Vector3::FromSimd(value / length) : a;
+}
+constexpr Vector3 Lerp(const Vector3& a, const Vector3& b, float t)
+{
+	if (IsConstantEvaluated())
+		return a + (b - a) * t;
+	return Vector3::FromSimd(SimdLerp(a.ToSimd(), b.ToSimd(), SimdSplat(t)));
+}
+constexpr Vector3 Min(const Vector3& a, const Vector3& b)
+{
+	if (IsConstantEvaluated())
+		return Vector3(a.x < b.x ? a.x : b.x, a.y < b.y ? a.y : b.y, a.z < b.z ? a.z : b.z);
+	return Vector3::FromSimd(SimdMin(a.ToSimd(), b.ToSimd()));
+}
+constexpr Vector3 Max(const Vector3& a, const Vector3& b)
+{
+	if (IsConstantEvaluated())
+		return Vector3(a.x > b.x ? a.x : b.x, a.y > b.y ? a.y : b.y, a.z > b.z ? a.z : b.z);
+	return Vector3::FromSimd(SimdMax(a.ToSimd(), b.ToSimd()));
+}
+
+// Vector4
+constexpr float Dot(const Vector4& a, const Vector4& b)
+{
+	if (IsConstantEvaluated())
+		return (a.x * b.x + a.y * b.y) + (a.z * b.z + a.w * b.w);
+	return SimdGetX(SimdDot4(a.ToSimd(), b.ToSimd()));
+}
+constexpr float Length(const Vector4& a)
+{
+	if (IsConstantEvaluated())
+		return ConstexprSqrt(Dot(a, a));
+	return SimdGetX(SimdSqrt(SimdDot4(a.ToSimd(), a.ToSimd())));
+}
+constexpr Vector4 Normalize(const Vector4& a)
+{
+	if (IsConstantEvaluated())
+	{
+		float length = Length(a);
+		return length > 0.0f ? Vector4(a.x / length, a.y / length, a.z / length, a.w / length) : a;
+	}
+	Float4 value = a.ToSimd();
+	Float4 length = SimdSqrt(SimdDot4(value, value));
+	return SimdGetX(length) > 0.0f ? Vector4::FromSimd(value / length) : a;
+}
+constexpr Vector4 Lerp(const Vector4& a, const Vector4& b, float t)
+{
+	if (IsConstantEvaluated())
+		return a + (b - a) * t;
+	return Vector4::FromSimd(SimdLerp(a.ToSimd(), b.ToSimd(), SimdSplat(t)));
+}
+constexpr Vector4 Min(const Vector4& a, const Vector4& b)
+{
+	if (IsConstantEvaluated())
+		return Vector4(a.x < b.x ? a.x : b.x, a.y < b.y ? a.y : b.y, a.z < b.z ? a.z : b.z, a.w < b.w ? a.w : b.w);
+	return Vector4::FromSimd(SimdMin(a.ToSimd(), b.ToSimd()));
+}
+constexpr Vector4 Max(const Vector4& a, const Vector4& b)
+{
+	if (IsConstantEvaluated())
+		return Vector4(a.x > b.x ? a.x : b.x, a.y > b.y ? a.y : b.y, a.z > b.z ? a.z : b.z, a.w > b.w ? a.w : b.w);
+	return Vector4::FromSimd(SimdMax(a.ToSimd(), b.ToSimd()));
+}
+
+// Overloading the bitwise shift left operator
+inline std::ostream& operator<<(std::ostream& stream, const Vector2& other)
+{
+	stream << "(" << other.x << " | " << other.y << ")";
+	return stream;
+}
+
+inline std::ostream& operator<<(std::ostream& stream, const Vector3& other)
+{
+	stream << "(" << other.x << " | " << other.y << " | " << other.z << ")";
+	return stream;
+}
+
+inline std::ostream& operator<<(std::ostream& stream, const Vector4& other)
+{
+	stream << "(" << other.x << " | " << other.y << " | " << other.z << " | " << other.w << ")";
+	return stream;
+}
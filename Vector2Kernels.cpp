@@ -0,0 +1,37 @@
+#include "Vector2Kernels.h"
+#include "Vector2KernelsImpl.h"
+
+namespace
+{
+	// The plain C++ version. It is always there, and the others have to give exactly the same results
+	struct ScalarIsa
+	{
+		static constexpr size_t Width = 1;
+	};
+}
+
+// Each of these lives in its own .cpp file, which is compiled for that instruction set
+// They return nullptr when this build doesn't have a version for it (for example on ARM)
+const Vector2KernelTable* GetVector2KernelsSse2();
+const Vector2KernelTable* GetVector2KernelsAvx2();
+const Vector2KernelTable* GetVector2KernelsAvx512();
+
+const Vector2KernelTable* GetVector2Kernels(SimdLevel level)
+{
+	// Calling an AVX2 function on a CPU without AVX2 crashes the programme, so never hand one out
+	if (!GetCpuFeatures().Supports(level))
+		return nullptr;
+
+	switch (level)
+	{
+	case SimdLevel::Scalar:
+	{
+		static const Vector2KernelTable s_Table = MakeVector2KernelTable<ScalarIsa>(SimdLevel::Scalar);
+		return &s_Table;
+	}
+	case SimdLevel::Sse2: return GetVector2KernelsSse2();
+	case SimdLevel::Avx2: return GetVector2KernelsAvx2();
+	case SimdLevel::Avx512: return GetVector2KernelsAvx512();
+	default: return nullptr;	// Nothing here needs SSE4.2, the SSE2 version is used instead
+	}
+}
@@ -0,0 +1,156 @@
+#pragma once
+
+#include <cstddef>
+
+#include "CpuFeatures.h"
+#include "Span.h"
+#include "Vector.h"
+
+// Bulk versions of the Vector2 maths, working on whole arrays at once
+// There is a version for arrays of Vector2 (x y x y x y ...) and one for separate x and y arrays (x x x ... and y y y ...), known as SoA: Structure of Arrays
+// Every function exists in Scalar, SSE2, AVX2 and AVX-512 versions. The best one the CPU supports is picked the first time one is called
+// All versions round exactly like the scalar Vector2 operators do, so which one runs never changes the results
+// The output may be the same array as an input. All spans passed to one call must have the same size
+
+// Separate x and y arrays. Use ConstVector2SoASpan for inputs
+template<typename T>
+struct BasicVector2SoASpan
+{
+	Span<T> X;
+	Span<T> Y;
+
+	BasicVector2SoASpan() = default;
+	BasicVector2SoASpan(Span<T> x, Span<T> y)
+		: X(x), Y(y) {}
+	template<typename U>
+	BasicVector2SoASpan(const BasicVector2SoASpan<U>& other)
+		: X(other.X), Y(other.Y) {}
+
+	size_t Size() const { return X.Size(); }
+};
+using Vector2SoASpan = BasicVector2SoASpan<float>;
+using ConstVector2SoASpan = BasicVector2SoASpan<const float>;
+
+// One function pointer per kernel
+// The element wise ones work on plain float arrays, because adding Vector2s is the same as adding their floats. Their count is the number of floats
+// "Interleaved" kernels take x y x y arrays, "Split" kernels take separate x and y arrays. Their count is the number of Vector2s
+struct Vector2KernelTable
+{
+	SimdLevel Level;
+
+	void (*Add)(const float* a, const float* b, float* out, size_t count);
+	void (*Multiply)(const float* a, const float* b, float* out, size_t count);
+	void (*MultiplyAdd)(const float* a, const float* b, const float* c, float* out, size_t count);	// a * b + c, rounded after each step like the operators
+	void (*Scale)(const float* a, float scale, float* out, size_t count);
+
+	void (*DotInterleaved)(const float* a, const float* b, float* out, size_t count);
+	void (*LengthInterleaved)(const float* a, float* out, size_t count);
+	void (*NormalizeInterleaved)(const float* a, float* out, size_t count);
+
+	void (*DotSplit)(const float* ax, const float* ay, const float* bx, const float* by, float* out, size_t count);
+	void (*LengthSplit)(const float* x, const float* y, float* out, size_t count);
+	void (*NormalizeSplit)(const float* x, const float* y, float* outX, float* outY, size_t count);
+};
+
+// The table for a specific level, or nullptr if this CPU (or this build) doesn't have it. Useful for comparing them
+const Vector2KernelTable* GetVector2Kernels(SimdLevel level);
+
+// The fastest table this CPU supports, picked once
+inline const Vector2KernelTable& GetVector2Kernels()
+{
+	static const Vector2KernelTable& s_Table = []() -> const Vector2KernelTable&
+	{
+		SimdLevel best = GetCpuFeatures().BestLevel();
+		for (int level = (int)best; level > (int)SimdLevel::Scalar; level--)
+		{
+			if (const Vector2KernelTable* table = GetVector2Kernels((SimdLevel)level))
+				return *table;
+		}
+		return *GetVector2Kernels(SimdLevel::Scalar);
+	}();
+	return s_Table;
+}
+
+// A Vector2 is just two floats, so an array of them can be used as an array of floats
+inline const float* AsFloats(Span<const Vector2> vectors) { return reinterpret_cast<const float*>(vectors.Data()); }
+inline float* AsFloats(Span<Vector2> vectors) { return reinterpret_cast<float*>(vectors.Data()); }
+
+// Vector2 arrays
+inline void Add(Span<const Vector2> a, Span<const Vector2> b, Span<Vector2> out)
+{
+	GetVector2Kernels().Add(AsFloats(a), AsFloats(b), AsFloats(out), out.Size() * 2);
+}
+
+inline void Multiply(Span<const Vector2> a, Span<const Vector2> b, Span<Vector2> out)
+{
+	GetVector2Kernels().Multiply(AsFloats(a), AsFloats(b), AsFloats(out), out.Size() * 2);
+}
+
+inline void MultiplyAdd(Span<const Vector2> a, Span<const Vector2> b, Span<const Vector2> c, Span<Vector2> out)
+{
+	GetVector2Kernels().MultiplyAdd(AsFloats(a), AsFloats(b), AsFloats(c), AsFloats(out), out.Size() * 2);
+}
+
+inline void Scale(Span<const Vector2> a, float scale, Span<Vector2> out)
+{
+	GetVector2Kernels().Scale(AsFloats(a), scale, AsFloats(out), out.Size() * 2);
+}
+
+inline void Dot(Span<const Vector2> a, Span<const Vector2> b, Span<float> out)
+{
+	GetVector2Kernels().DotInterleaved(AsFloats(a), AsFloats(b), out.Data(), out.Size());
+}
+
+inline void Length(Span<const Vector2> a, Span<float> out)
+{
+	GetVector2Kernels().LengthInterleaved(AsFloats(a), out.Data(), out.Size());
+}
+
+inline void Normalize(Span<const Vector2> a, Span<Vector2> out)
+{
+	GetVector2Kernels().NormalizeInterleaved(AsFloats(a), AsFloats(out), out.Size());
+}
+
+// Separate x and y arrays
+inline void Add(ConstVector2SoASpan a, ConstVector2SoASpan b, Vector2SoASpan out)
+{
+	const Vector2KernelTable& kernels = GetVector2Kernels();
+	kernels.Add(a.X.Data(), b.X.Data(), out.X.Data(), out.Size());
+	kernels.Add(a.Y.Data(), b.Y.Data(), out.Y.Data(), out.Size());
+}
+
+inline void Multiply(ConstVector2SoASpan a, ConstVector2SoASpan b, Vector2SoASpan out)
+{
+	const Vector2KernelTable& kernels = GetVector2Kernels();
+	kernels.Multiply(a.X.Data(), b.X.Data(), out.X.Data(), out.Size());
+	kernels.Multiply(a.Y.Data(), b.Y.Data(), out.Y.Data(), out.Size());
+}
+
+inline void MultiplyAdd(ConstVector2SoASpan a, ConstVector2SoASpan b, ConstVector2SoASpan c, Vector2SoASpan out)
+{
+	const Vector2KernelTable& kernels = GetVector2Kernels();
+	kernels.MultiplyAdd(a.X.Data(), b.X.Data(), c.X.Data(), out.X.Data(), out.Size());
+	kernels.MultiplyAdd(a.Y.Data(), b.Y.Data(), c.Y.Data(), out.Y.Data(), out.Size());
+}
+
+inline void Scale(ConstVector2SoASpan a, float scale, Vector2SoASpan out)
+{
+	const Vector2KernelTable& kernels = GetVector2Kernels();
+	kernels.Scale(a.X.Data(), scale, out.X.Data(), out.Size());
+	kernels.Scale(a.Y.Data(), scale, out.Y.Data(), out.Size());
+}
+
+inline void Dot(ConstVector2SoASpan a, ConstVector2SoASpan b, Span<float> out)
+{
+	GetVector2Kernels().DotSplit(a.X.Data(), a.Y.Data(), b.X.Data(), b.Y.Data(), out.Data(), out.Size());
+}
+
+inline void Length(ConstVector2SoASpan a, Span<float> out)
+{
+	GetVector2Kernels().LengthSplit(a.X.Data(), a.Y.Data(), out.Data(), out.Size());
+}
+
+inline void Normalize(ConstVector2SoASpan a, Vector2SoASpan out)
+{
+	GetVector2Kernels().NormalizeSplit(a.X.Data(), a.Y.Data(), out.X.Data(), out.Y.Data(), out.Size());
+}
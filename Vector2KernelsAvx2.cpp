@@ -0,0 +1,64 @@
+// Everything we include must come before the #pragma below. Otherwise it would be compiled for AVX2 too, and the linker could pick that version for the whole programme
+#include "Vector2Kernels.h"
+
+#if defined(PR_X86)
+#include <immintrin.h>
+
+// MSVC lets us use any intrinsic anywhere. GCC and Clang have to be told which instructions the functions below are allowed to use
+// GCC would also turn a * b + c into a fused multiply-add when it can, which rounds differently than the scalar version
+#if defined(__clang__)
+#pragma clang attribute push(__attribute__((target("avx2"))), apply_to = function)
+#elif defined(__GNUC__)
+#pragma GCC push_options
+#pragma GCC target("avx2")
+#pragma GCC optimize("fp-contract=off")
+#endif
+
+#include "Vector2KernelsImpl.h"
+
+namespace
+{
+	// 8 floats per register. Most AVX instructions work on two separate 4 float halves ("lanes"), which is why Compress needs an extra step
+	struct Avx2
+	{
+		using Register = __m256;
+		static constexpr size_t Width = 8;
+
+		static Register Load(const float* values) { return _mm256_loadu_ps(values); }
+		static void Store(float* values, Register a) { _mm256_storeu_ps(values, a); }
+		static Register Splat(float value) { return _mm256_set1_ps(value); }
+		static Register Add(Register a, Register b) { return _mm256_add_ps(a, b); }
+		static Register Multiply(Register a, Register b) { return _mm256_mul_ps(a, b); }
+		static Register Divide(Register a, Register b) { return _mm256_div_ps(a, b); }
+		static Register Sqrt(Register a) { return _mm256_sqrt_ps(a); }
+		static Register SwapPairs(Register a) { return _mm256_permute_ps(a, _MM_SHUFFLE(2, 3, 0, 1)); }
+
+		// The shuffle gives 0 1 4 5 | 2 3 6 7, then we swap the middle two pairs of floats to get 0 1 2 3 4 5 6 7
+		static Register Compress(Register low, Register high)
+		{
+			Register even = _mm256_shuffle_ps(low, high, _MM_SHUFFLE(2, 0, 2, 0));
+			return _mm256_castpd_ps(_mm256_permute4x64_pd(_mm256_castps_pd(even), _MM_SHUFFLE(3, 1, 2, 0)));
+		}
+
+		static Register SelectIfPositive(Register condition, Register a, Register b)
+		{
+			return _mm256_blendv_ps(b, a, _mm256_cmp_ps(condition, _mm256_setzero_ps(), _CMP_GT_OQ));
+		}
+	};
+}
+
+const Vector2KernelTable* GetVector2KernelsAvx2()
+{
+	static const Vector2KernelTable s_Table = MakeVector2KernelTable<Avx2>(SimdLevel::Avx2);
+	return &s_Table;
+}
+
+#if defined(__clang__)
+#pragma clang attribute pop
+#elif defined(__GNUC__)
+#pragma GCC pop_options
+#endif
+
+#else
+const Vector2KernelTable* GetVector2KernelsAvx2() { return nullptr; }
+#endif
@@ -0,0 +1,72 @@
+// Everything we include must come before the #pragma below. Otherwise it would be compiled for AVX-512 too, and the linker could pick that version for the whole programme
+#include "Vector2Kernels.h"
+
+#if defined(PR_X86)
+// GCC 12 warns about the deliberately undefined registers inside its own AVX-512 header (_mm512_undefined_ps and friends)
+#if defined(__GNUC__) && !defined(__clang__)
+#pragma GCC diagnostic push
+#pragma GCC diagnostic ignored "-Wmaybe-uninitialized"
+#endif
+#include <immintrin.h>
+#if defined(__GNUC__) && !defined(__clang__)
+#pragma GCC diagnostic pop
+#endif
+
+// MSVC lets us use any intrinsic anywhere. GCC and Clang have to be told which instructions the functions below are allowed to use
+// GCC would also turn a * b + c into a fused multiply-add when it can, which rounds differently than the scalar version
+#if defined(__clang__)
+#pragma clang attribute push(__attribute__((target("avx512f"))), apply_to = function)
+#elif defined(__GNUC__)
+#pragma GCC push_options
+#pragma GCC target("avx512f")
+#pragma GCC optimize("fp-contract=off")
+#endif
+
+#include "Vector2KernelsImpl.h"
+
+namespace
+{
+	// 16 floats per register. AVX-512 has real mask registers, so selecting doesn't need any bit tricks
+	struct Avx512
+	{
+		using Register = __m512;
+		static constexpr size_t Width = 16;
+
+		static Register Load(const float* values) { return _mm512_loadu_ps(values); }
+		static void Store(float* values, Register a) { _mm512_storeu_ps(values, a); }
+		static Register Splat(float value) { return _mm512_set1_ps(value); }
+		static Register Add(Register a, Register b) { return _mm512_add_ps(a, b); }
+		static Register Multiply(Register a, Register b) { return _mm512_mul_ps(a, b); }
+		static Register Divide(Register a, Register b) { return _mm512_div_ps(a, b); }
+		static Register Sqrt(Register a) { return _mm512_sqrt_ps(a); }
+		static Register SwapPairs(Register a) { return _mm512_permute_ps(a, _MM_SHUFFLE(2, 3, 0, 1)); }
+
+		// Picks floats 0, 2, 4 ... from both registers at once. Indices 16 and up mean the second register
+		static Register Compress(Register low, Register high)
+		{
+			__m512i even = _mm512_setr_epi32(0, 2, 4, 6, 8, 10, 12, 14, 16, 18, 20, 22, 24, 26, 28, 30);
+			return _mm512_permutex2var_ps(low, even, high);
+		}
+
+		static Register SelectIfPositive(Register condition, Register a, Register b)
+		{
+			return _mm512_mask_blend_ps(_mm512_cmp_ps_mask(condition, _mm512_setzero_ps(), _CMP_GT_OQ), b, a);
+		}
+	};
+}
+
+const Vector2KernelTable* GetVector2KernelsAvx512()
+{
+	static const Vector2KernelTable s_Table = MakeVector2KernelTable<Avx512>(SimdLevel::Avx512);
+	return &s_Table;
+}
+
+#if defined(__clang__)
+#pragma clang attribute pop
+#elif defined(__GNUC__)
+#pragma GCC pop_options
+#endif
+
+#else
+const Vector2KernelTable* GetVector2KernelsAvx512() { return nullptr; }
+#endif
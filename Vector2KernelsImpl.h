@@ -0,0 +1,211 @@
+#pragma once
+
+// The bodies of the Vector2 kernels, written once for every instruction set
+// Only included by the Vector2Kernels*.cpp files. Each one describes its registers in a small struct (see Sse2 in Vector2KernelsSse2.cpp) and passes it in as Isa:
+//   Register, Width (floats per register), Load, Store, Splat, Add, Multiply, Divide, Sqrt,
+//   SwapPairs (swaps every two neighbouring floats), Compress (the even floats of two registers, in one register),
+//   SelectIfPositive (a where condition > 0, b everywhere else)
+// The scalar version has a Width of 1 and only runs the plain loops at the end of each function, which also finish off what is left after the last full register
+// Each .cpp file compiles this for a different CPU, and the linker must never mix those versions up. So everything in here is static,
+// and each Isa struct is in an anonymous namespace, because the string search and UTF files have an Sse2, Avx2 and ScalarIsa of their own
+
+#include <cmath>
+#include <cstddef>
+
+template<typename Isa>
+static void AddKernel(const float* a, const float* b, float* out, size_t count)
+{
+	size_t i = 0;
+	if constexpr (Isa::Width > 1)
+	{
+		for (; i + Isa::Width <= count; i += Isa::Width)
+			Isa::Store(out + i, Isa::Add(Isa::Load(a + i), Isa::Load(b + i)));
+	}
+	for (; i < count; i++)
+		out[i] = a[i] + b[i];
+}
+
+template<typename Isa>
+static void MultiplyKernel(const float* a, const float* b, float* out, size_t count)
+{
+	size_t i = 0;
+	if constexpr (Isa::Width > 1)
+	{
+		for (; i + Isa::Width <= count; i += Isa::Width)
+			Isa::Store(out + i, Isa::Multiply(Isa::Load(a + i), Isa::Load(b + i)));
+	}
+	for (; i < count; i++)
+		out[i] = a[i] * b[i];
+}
+
+// Not a fused multiply-add instruction: that rounds only once and would give slightly different results than a * b + c with the operators
+template<typename Isa>
+static void MultiplyAddKernel(const float* a, const float* b, const float* c, float* out, size_t count)
+{
+	size_t i = 0;
+	if constexpr (Isa::Width > 1)
+	{
+		for (; i + Isa::Width <= count; i += Isa::Width)
+			Isa::Store(out + i, Isa::Add(Isa::Multiply(Isa::Load(a + i), Isa::Load(b + i)), Isa::Load(c + i)));
+	}
+	for (; i < count; i++)
+		out[i] = a[i] * b[i] + c[i];
+}
+
+template<typename Isa>
+static void ScaleKernel(const float* a, float scale, float* out, size_t count)
+{
+	size_t i = 0;
+	if constexpr (Isa::Width > 1)
+	{
+		typename Isa::Register s = Isa::Splat(scale);
+		for (; i + Isa::Width <= count; i += Isa::Width)
+			Isa::Store(out + i, Isa::Multiply(Isa::Load(a + i), s));
+	}
+	for (; i < count; i++)
+		out[i] = a[i] * scale;
+}
+
+// x y x y: after multiplying, adding every float to its neighbour gives the dot product in both the x and the y slot
+template<typename Isa>
+static void DotInterleavedKernel(const float* a, const float* b, float* out, size_t count)
+{
+	size_t i = 0;
+	if constexpr (Isa::Width > 1)
+	{
+		for (; i + Isa::Width <= count; i += Isa::Width)
+		{
+			typename Isa::Register low = Isa::Multiply(Isa::Load(a + i * 2), Isa::Load(b + i * 2));
+			typename Isa::Register high = Isa::Multiply(Isa::Load(a + i * 2 + Isa::Width), Isa::Load(b + i * 2 + Isa::Width));
+			low = Isa::Add(low, Isa::SwapPairs(low));
+			high = Isa::Add(high, Isa::SwapPairs(high));
+			Isa::Store(out + i, Isa::Compress(low, high));
+		}
+	}
+	for (; i < count; i++)
+		out[i] = a[i * 2] * b[i * 2] + a[i * 2 + 1] * b[i * 2 + 1];
+}
+
+template<typename Isa>
+static void LengthInterleavedKernel(const float* a, float* out, size_t count)
+{
+	size_t i = 0;
+	if constexpr (Isa::Width > 1)
+	{
+		for (; i + Isa::Width <= count; i += Isa::Width)
+		{
+			typename Isa::Register low = Isa::Load(a + i * 2);
+			typename Isa::Register high = Isa::Load(a + i * 2 + Isa::Width);
+			low = Isa::Multiply(low, low);
+			high = Isa::Multiply(high, high);
+			low = Isa::Add(low, Isa::SwapPairs(low));
+			high = Isa::Add(high, Isa::SwapPairs(high));
+			Isa::Store(out + i, Isa::Sqrt(Isa::Compress(low, high)));
+		}
+	}
+	for (; i < count; i++)
+		out[i] = std::sqrt(a[i * 2] * a[i * 2] + a[i * 2 + 1] * a[i * 2 + 1]);
+}
+
+// The length ends up in both the x and y slot, so we can divide without rearranging anything
+// Vectors with a length of 0 are copied unchanged, like Normalize(const Vector2&) does
+template<typename Isa>
+static void NormalizeInterleavedKernel(const float* a, float* out, size_t count)
+{
+	size_t floats = count * 2;
+	size_t i = 0;
+	if constexpr (Isa::Width > 1)
+	{
+		for (; i + Isa::Width <= floats; i += Isa::Width)
+		{
+			typename Isa::Register value = Isa::Load(a + i);
+			typename Isa::Register squared = Isa::Multiply(value, value);
+			typename Isa::Register length = Isa::Sqrt(Isa::Add(squared, Isa::SwapPairs(squared)));
+			Isa::Store(out + i, Isa::SelectIfPositive(length, Isa::Divide(value, length), value));
+		}
+	}
+	for (; i < floats; i += 2)
+	{
+		float x = a[i], y = a[i + 1];
+		float length = std::sqrt(x * x + y * y);
+		out[i] = length > 0.0f ? x / length : x;
+		out[i + 1] = length > 0.0f ? y / length : y;
+	}
+}
+
+template<typename Isa>
+static void DotSplitKernel(const float* ax, const float* ay, const float* bx, const float* by, float* out, size_t count)
+{
+	size_t i = 0;
+	if constexpr (Isa::Width > 1)
+	{
+		for (; i + Isa::Width <= count; i += Isa::Width)
+		{
+			typename Isa::Register x = Isa::Multiply(Isa::Load(ax + i), Isa::Load(bx + i));
+			typename Isa::Register y = Isa::Multiply(Isa::Load(ay + i), Isa::Load(by + i));
+			Isa::Store(out + i, Isa::Add(x, y));
+		}
+	}
+	for (; i < count; i++)
+		out[i] = ax[i] * bx[i] + ay[i] * by[i];
+}
+
+template<typename Isa>
+static void LengthSplitKernel(const float* x, const float* y, float* out, size_t count)
+{
+	size_t i = 0;
+	if constexpr (Isa::Width > 1)
+	{
+		for (; i + Isa::Width <= count; i += Isa::Width)
+		{
+			typename Isa::Register vx = Isa::Load(x + i);
+			typename Isa::Register vy = Isa::Load(y + i);
+			Isa::Store(out + i, Isa::Sqrt(Isa::Add(Isa::Multiply(vx, vx), Isa::Multiply(vy, vy))));
+		}
+	}
+	for (; i < count; i++)
+		out[i] = std::sqrt(x[i] * x[i] + y[i] * y[i]);
+}
+
+template<typename Isa>
+static void NormalizeSplitKernel(const float* x, const float* y, float* outX, float* outY, size_t count)
+{
+	size_t i = 0;
+	if constexpr (Isa::Width > 1)
+	{
+		for (; i + Isa::Width <= count; i += Isa::Width)
+		{
+			typename Isa::Register vx = Isa::Load(x + i);
+			typename Isa::Register vy = Isa::Load(y + i);
+			typename Isa::Register length = Isa::Sqrt(Isa::Add(Isa::Multiply(vx, vx), Isa::Multiply(vy, vy)));
+			Isa::Store(outX + i, Isa::SelectIfPositive(length, Isa::Divide(vx, length), vx));
+			Isa::Store(outY + i, Isa::SelectIfPositive(length, Isa::Divide(vy, length), vy));
+		}
+	}
+	for (; i < count; i++)
+	{
+		float length = std::sqrt(x[i] * x[i] + y[i] * y[i]);
+		float nx = length > 0.0f ? x[i] / length : x[i];
+		float ny = length > 0.0f ? y[i] / length : y[i];
+		outX[i] = nx;
+		outY[i] = ny;
+	}
+}
+
+template<typename Isa>
+static Vector2KernelTable MakeVector2KernelTable(SimdLevel level)
+{
+	Vector2KernelTable table;
+	table.Level = level;
+	table.Add = &AddKernel<Isa>;
+	table.Multiply = &MultiplyKernel<Isa>;
+	table.MultiplyAdd = &MultiplyAddKernel<Isa>;
+	table.Scale = &ScaleKernel<Isa>;
+	table.DotInterleaved = &DotInterleavedKernel<Isa>;
+	table.LengthInterleaved = &LengthInterleavedKernel<Isa>;
+	table.NormalizeInterleaved = &NormalizeInterleavedKernel<Isa>;
+	table.DotSplit = &DotSplitKernel<Isa>;
+	table.LengthSplit = &LengthSplitKernel<Isa>;
+	table.NormalizeSplit = &NormalizeSplitKernel<Isa>;
+	return table;
+}
@@ -0,0 +1,60 @@
+// Everything we include must come before the #pragma below. Otherwise it would be compiled for SSE2 too, and the linker could pick that version for the whole programme
+#include "Vector2Kernels.h"
+
+#if defined(PR_X86)
+#include <emmintrin.h>
+
+// MSVC lets us use any intrinsic anywhere. GCC and Clang have to be told which instructions the functions below are allowed to use
+// GCC would also turn a * b + c into a fused multiply-add when it can, which rounds differently than the scalar version
+#if defined(__clang__)
+#pragma clang attribute push(__attribute__((target("sse2"))), apply_to = function)
+#elif defined(__GNUC__)
+#pragma GCC push_options
+#pragma GCC target("sse2")
+#pragma GCC optimize("fp-contract=off")
+#endif
+
+#include "Vector2KernelsImpl.h"
+
+namespace
+{
+	// 4 floats per register
+	struct Sse2
+	{
+		using Register = __m128;
+		static constexpr size_t Width = 4;
+
+		static Register Load(const float* values) { return _mm_loadu_ps(values); }
+		static void Store(float* values, Register a) { _mm_storeu_ps(values, a); }
+		static Register Splat(float value) { return _mm_set1_ps(value); }
+		static Register Add(Register a, Register b) { return _mm_add_ps(a, b); }
+		static Register Multiply(Register a, Register b) { return _mm_mul_ps(a, b); }
+		static Register Divide(Register a, Register b) { return _mm_div_ps(a, b); }
+		static Register Sqrt(Register a) { return _mm_sqrt_ps(a); }
+		static Register SwapPairs(Register a) { return _mm_shuffle_ps(a, a, _MM_SHUFFLE(2, 3, 0, 1)); }
+		static Register Compress(Register low, Register high) { return _mm_shuffle_ps(low, high, _MM_SHUFFLE(2, 0, 2, 0)); }
+
+		// SSE2 has no blend instruction, so we do it with the bits: (mask & a) | (~mask & b)
+		static Register SelectIfPositive(Register condition, Register a, Register b)
+		{
+			Register mask = _mm_cmpgt_ps(condition, _mm_setzero_ps());
+			return _mm_or_ps(_mm_and_ps(mask, a), _mm_andnot_ps(mask, b));
+		}
+	};
+}
+
+const Vector2KernelTable* GetVector2KernelsSse2()
+{
+	static const Vector2KernelTable s_Table = MakeVector2KernelTable<Sse2>(SimdLevel::Sse2);
+	return &s_Table;
+}
+
+#if defined(__clang__)
+#pragma clang attribute pop
+#elif defined(__GNUC__)
+#pragma GCC pop_options
+#endif
+
+#else
+const Vector2KernelTable* GetVector2KernelsSse2() { return nullptr; }
+#endif
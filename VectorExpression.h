@@ -0,0 +1,156 @@
+#pragma once
+
+#include <cassert>
+#include <cstddef>
+#include <type_traits>
+#include <vector>
+
+#include "Vector.h"
+
+// Expression templates for arrays of Vector2
+// Normally result = pos + speed * powerup on whole arrays would first build a temporary array for speed * powerup, then add pos to it in a second loop
+// That means writing and reading a whole extra array. Here the operators don't calculate anything, they just return a small object that remembers what to do
+// Only when the expression is assigned to a Vector2Array does it run, in one loop: result[i] = pos[i] + speed[i] * powerup[i]
+// Each element is still worked out with Vector2's own operators, so the results are exactly the same as doing it one step at a time
+// (a single Vector2 doesn't need any of this: its temporaries live in registers and never touch memory)
+
+template<typename E>
+struct Vector2Expression	// Base class of everything that can be used in an expression (CRTP, see Dispatch.h)
+{
+	const E& Get() const { return static_cast<const E&>(*this); }
+};
+
+class Vector2Array : public Vector2Expression<Vector2Array>
+{
+private:
+	std::vector<Vector2> m_Data;
+public:
+	Vector2Array() = default;
+	explicit Vector2Array(size_t count, const Vector2& value = Vector2())
+		: m_Data(count, value) {}
+
+	// Evaluating an expression straight into a new array
+	template<typename E>
+	Vector2Array(const Vector2Expression<E>& expression)
+	{
+		*this = expression;
+	}
+
+	// This is the one loop that evaluates the whole expression
+	// It is fine for the array itself to be part of the expression (a = a + b), because element i only ever reads element i
+	// That is only true when the expression has the same size as the array already has: resizing would move the elements it reads
+	template<typename E>
+	Vector2Array& operator=(const Vector2Expression<E>& expression)
+	{
+		const E& e = expression.Get();
+		size_t size = e.Size();
+		m_Data.resize(size);
+		Vector2* data = m_Data.data();
+		for (size_t i = 0; i < size; i++)
+			data[i] = e[i];
+		return *this;
+	}
+
+	template<typename E>
+	Vector2Array& operator+=(const Vector2Expression<E>& expression)
+	{
+		const E& e = expression.Get();
+		assert(e.Size() == m_Data.size());
+		Vector2* data = m_Data.data();
+		for (size_t i = 0; i < m_Data.size(); i++)
+			data[i] = data[i] + e[i];
+		return *this;
+	}
+
+	Vector2& operator[](size_t index) { return m_Data[index]; }
+	const Vector2& operator[](size_t index) const { return m_Data[index]; }
+	size_t Size() const { return m_Data.size(); }
+	Vector2* Data() { return m_Data.data(); }
+	const Vector2* Data() const { return m_Data.data(); }
+	void Resize(size_t count) { m_Data.resize(count); }
+};
+
+// A single Vector2 used in an array expression, applied to every element (like pos + speed * powerup, where powerup is one Vector2)
+class Vector2Broadcast : public Vector2Expression<Vector2Broadcast>
+{
+private:
+	Vector2 m_Value;
+	size_t m_Size;
+public:
+	Vector2Broadcast(const Vector2& value, size_t size)
+		: m_Value(value), m_Size(size) {}
+
+	Vector2 operator[](size_t) const { return m_Value; }
+	size_t Size() const { return m_Size; }
+};
+
+// Arrays are kept as references, so nothing gets copied. Everything else is tiny and kept by value, because it is a temporary that would be gone by the time the expression runs
+template<typename E>
+using Vector2ExpressionStorage = std::conditional_t<std::is_same_v<E, Vector2Array>, const Vector2Array&, const E>;
+
+struct Vector2AddOperation { static Vector2 Apply(const Vector2& a, const Vector2& b) { return a + b; } };
+struct Vector2SubtractOperation { static Vector2 Apply(const Vector2& a, const Vector2& b) { return a - b; } };
+struct Vector2MultiplyOperation { static Vector2 Apply(const Vector2& a, const Vector2& b) { return a * b; } };
+struct Vector2DivideOperation { static Vector2 Apply(const Vector2& a, const Vector2& b) { return a / b; } };
+
+template<typename L, typename R, typename Operation>
+class Vector2BinaryExpression : public Vector2Expression<Vector2BinaryExpression<L, R, Operation>>
+{
+private:
+	Vector2ExpressionStorage<L> m_Left;
+	Vector2ExpressionStorage<R> m_Right;
+public:
+	Vector2BinaryExpression(const L& left, const R& right)
+		: m_Left(left), m_Right(right)
+	{
+		assert(left.Size() == right.Size());
+	}
+
+	Vector2 operator[](size_t index) const { return Operation::Apply(m_Left[index], m_Right[index]); }
+	size_t Size() const { return m_Left.Size(); }	// Both sides have the same size
+};
+
+template<typename E>
+class Vector2ScaleExpression : public Vector2Expression<Vector2ScaleExpression<E>>
+{
+private:
+	Vector2ExpressionStorage<E> m_Expression;
+	float m_Scale;
+public:
+	Vector2ScaleExpression(const E& expression, float scale)
+		: m_Expression(expression), m_Scale(scale) {}
+
+	Vector2 operator[](size_t index) const { return m_Expression[index] * m_Scale; }
+	size_t Size() const { return m_Expression.Size(); }
+};
+
+// The operators. Each one has a version for expression + expression, expression + Vector2 and Vector2 + expression
+#define VECTOR2_EXPRESSION_OPERATOR(Symbol, Operation)\
+template<typename L, typename R>\
+Vector2BinaryExpression<L, R, Operation> operator Symbol(const Vector2Expression<L>& left, const Vector2Expression<R>& right)\
+{\
+	return Vector2BinaryExpression<L, R, Operation>(left.Get(), right.Get());\
+}\
+template<typename L>\
+Vector2BinaryExpression<L, Vector2Broadcast, Operation> operator Symbol(const Vector2Expression<L>& left, const Vector2& right)\
+{\
+	return Vector2BinaryExpression<L, Vector2Broadcast, Operation>(left.Get(), Vector2Broadcast(right, left.Get().Size()));\
+}\
+template<typename R>\
+Vector2BinaryExpression<Vector2Broadcast, R, Operation> operator Symbol(const Vector2& left, const Vector2Expression<R>& right)\
+{\
+	return Vector2BinaryExpression<Vector2Broadcast, R, Operation>(Vector2Broadcast(left, right.Get().Size()), right.Get());\
+}
+
+VECTOR2_EXPRESSION_OPERATOR(+, Vector2AddOperation)
+VECTOR2_EXPRESSION_OPERATOR(-, Vector2SubtractOperation)
+VECTOR2_EXPRESSION_OPERATOR(*, Vector2MultiplyOperation)
+VECTOR2_EXPRESSION_OPERATOR(/, Vector2DivideOperation)
+
+#undef VECTOR2_EXPRESSION_OPERATOR
+
+template<typename E>
+Vector2ScaleExpression<E> operator*(const Vector2Expression<E>& expression, float scale)
+{
+	return Vector2ScaleExpression<E>(expression.Get(), scale);
+}
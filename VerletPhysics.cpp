@@ -0,0 +1,207 @@
+#include "VerletPhysics.h"
+
+#include "JobSystem.h"
+
+static const size_t s_BodyChunkSize = 4096;
+static const size_t s_ConstraintChunkSize = 1024;
+static const size_t s_CellChunkSize = 64;
+
+VerletWorld::VerletWorld(const Vector2& min, const Vector2& max)
+	: m_Min(min), m_Max(max)
+{
+}
+
+uint32_t VerletWorld::AddBody(const Vector2& position, float radius, float inverseMass)
+{
+	m_Positions.push_back(position);
+	m_PreviousPositions.push_back(position);
+	m_Radii.push_back(radius);
+	m_InverseMasses.push_back(inverseMass);
+	m_UsedColours.push_back(0);
+	if (radius > m_MaxRadius)
+		m_MaxRadius = radius;
+	return (uint32_t)(m_Positions.size() - 1);
+}
+
+void VerletWorld::AddConstraint(uint32_t a, uint32_t b)
+{
+	AddConstraint(a, b, Length(m_Positions[b] - m_Positions[a]));
+}
+
+// Greedy colouring: the first colour neither body has a constraint in yet
+// a and b already have at most deg(a) - 1 and deg(b) - 1 other constraints (deg being how many each ends up with), so this one gets one of the first deg(a) + deg(b) - 1 colours
+// A grid cloth (4 constraints per body) can never need more than 7, and added row by row like the benchmark does it only uses 4
+void VerletWorld::AddConstraint(uint32_t a, uint32_t b, float length)
+{
+	m_ConstraintCount++;
+	uint64_t used = m_UsedColours[a] | m_UsedColours[b];
+	if (used == ~0ull)
+	{
+		m_SerialConstraints.push_back({ a, b, length });
+		return;
+	}
+
+	size_t colour = 0;
+	while (used & (1ull << colour))
+		colour++;
+	if (colour == m_Colours.size())
+		m_Colours.emplace_back();
+	m_Colours[colour].push_back({ a, b, length });
+	m_UsedColours[a] |= 1ull << colour;
+	m_UsedColours[b] |= 1ull << colour;
+}
+
+void VerletWorld::Integrate(size_t begin, size_t end, float deltaTime)
+{
+	Vector2 acceleration = Gravity * (deltaTime * deltaTime);
+	for (size_t i = begin; i < end; i++)
+	{
+		if (m_InverseMasses[i] == 0.0f)
+			continue;
+		Vector2 position = m_Positions[i];
+		m_Positions[i] = position + (position - m_PreviousPositions[i]) * Damping + acceleration;
+		m_PreviousPositions[i] = position;
+	}
+}
+
+// Moves both bodies along the line between them, the lighter one further
+void VerletWorld::SolveConstraint(const DistanceConstraint& constraint)
+{
+	float weightA = m_InverseMasses[constraint.A];
+	float weightB = m_InverseMasses[constraint.B];
+	float totalWeight = weightA + weightB;
+	Vector2 delta = m_Positions[constraint.B] - m_Positions[constraint.A];
+	float distance = Length(delta);
+	if (totalWeight == 0.0f || distance == 0.0f)
+		return;
+
+	Vector2 correction = delta * ((distance - constraint.Length) / (distance * totalWeight));
+	m_Positions[constraint.A] = m_Positions[constraint.A] + correction * weightA;
+	m_Positions[constraint.B] = m_Positions[constraint.B] - correction * weightB;
+}
+
+// A counting sort of the bodies by cell. It keeps the bodies of each cell in index order, so the grid is the same every time
+void VerletWorld::BuildGrid()
+{
+	m_CellSize = m_MaxRadius > 0.0f ? m_MaxRadius * 2.0f : 1.0f;
+	m_GridWidth = (int)((m_Max.x - m_Min.x) / m_CellSize) + 1;
+	m_GridHeight = (int)((m_Max.y - m_Min.y) / m_CellSize) + 1;
+	size_t cellCount = (size_t)m_GridWidth * (size_t)m_GridHeight;
+
+	m_CellStarts.assign(cellCount + 1, 0);
+	m_BodyCells.resize(m_Positions.size());
+	for (size_t i = 0; i < m_Positions.size(); i++)
+	{
+		int x = (int)((m_Positions[i].x - m_Min.x) / m_CellSize);
+		int y = (int)((m_Positions[i].y - m_Min.y) / m_CellSize);
+		x = x < 0 ? 0 : x >= m_GridWidth ? m_GridWidth - 1 : x;
+		y = y < 0 ? 0 : y >= m_GridHeight ? m_GridHeight - 1 : y;
+		uint32_t cell = (uint32_t)(y * m_GridWidth + x);
+		m_BodyCells[i] = cell;
+		m_CellStarts[cell + 1]++;
+	}
+	for (size_t cell = 0; cell < cellCount; cell++)
+		m_CellStarts[cell + 1] += m_CellStarts[cell];
+
+	m_CellBodies.resize(m_Positions.size());
+	m_CellFill.assign(m_CellStarts.begin(), m_CellStarts.end() - 1);
+	for (size_t i = 0; i < m_Positions.size(); i++)
+		m_CellBodies[m_CellFill[m_BodyCells[i]]++] = (uint32_t)i;
+}
+
+void VerletWorld::CollideBodies(uint32_t a, uint32_t b)
+{
+	float weightA = m_InverseMasses[a];
+	float weightB = m_InverseMasses[b];
+	float totalWeight = weightA + weightB;
+	Vector2 delta = m_Positions[b] - m_Positions[a];
+	float minimum = m_Radii[a] + m_Radii[b];
+	float distanceSquared = Dot(delta, delta);
+	if (totalWeight == 0.0f || distanceSquared >= minimum * minimum || distanceSquared == 0.0f)
+		return;
+
+	float distance = Sqrt(distanceSquared);
+	Vector2 correction = delta * ((distance - minimum) / (distance * totalWeight));
+	m_Positions[a] = m_Positions[a] + correction * weightA;
+	m_Positions[b] = m_Positions[b] - correction * weightB;
+}
+
+// Pairs inside the cell, then with the neighbours to the right and the row above
+// Each pair of cells is only checked from one side, so this cell only writes to bodies in itself, the cells either side of it and the 3 cells above
+void VerletWorld::CollideCell(int cellX, int cellY)
+{
+	uint32_t cell = (uint32_t)(cellY * m_GridWidth + cellX);
+	for (uint32_t i = m_CellStarts[cell]; i < m_CellStarts[cell + 1]; i++)
+	{
+		uint32_t a = m_CellBodies[i];
+		for (uint32_t j = i + 1; j < m_CellStarts[cell + 1]; j++)
+			CollideBodies(a, m_CellBodies[j]);
+
+		static const int s_Neighbours[4][2] = { { 1, 0 }, { -1, 1 }, { 0, 1 }, { 1, 1 } };
+		for (const int* offset : s_Neighbours)
+		{
+			int x = cellX + offset[0], y = cellY + offset[1];
+			if (x < 0 || x >= m_GridWidth || y >= m_GridHeight)
+				continue;
+			uint32_t neighbour = (uint32_t)(y * m_GridWidth + x);
+			for (uint32_t j = m_CellStarts[neighbour]; j < m_CellStarts[neighbour + 1]; j++)
+				CollideBodies(a, m_CellBodies[j]);
+		}
+	}
+}
+
+void VerletWorld::KeepInside(size_t begin, size_t end)
+{
+	for (size_t i = begin; i < end; i++)
+	{
+		float radius = m_Radii[i];
+		Vector2& position = m_Positions[i];
+		position = Max(Min(position, m_Max - Vector2(radius, radius)), m_Min + Vector2(radius, radius));
+	}
+}
+
+void VerletWorld::Step(float deltaTime, size_t maxThreads)
+{
+	JobSystem& jobs = JobSystem::Get();
+	size_t bodyCount = m_Positions.size();
+
+	jobs.ParallelFor(bodyCount, s_BodyChunkSize, [&](size_t begin, size_t end) { Integrate(begin, end, deltaTime); }, maxThreads);
+	BuildGrid();
+
+	// Cell colours: x % 3 and y % 2. Cells of one colour are at least 3 apart in x or 2 apart in y, and a cell only reaches 1 to each side and 1 up
+	int columns = (m_GridWidth + 2) / 3;
+	int rows = (m_GridHeight + 1) / 2;
+
+	for (int iteration = 0; iteration < Iterations; iteration++)
+	{
+		for (const std::vector<DistanceConstraint>& colour : m_Colours)
+		{
+			jobs.ParallelFor(colour.size(), s_ConstraintChunkSize, [&](size_t begin, size_t end)
+			{
+				for (size_t i = begin; i < end; i++)
+					SolveConstraint(colour[i]);
+			}, maxThreads);
+		}
+		for (const DistanceConstraint& constraint : m_SerialConstraints)
+			SolveConstraint(constraint);
+
+		for (int colourY = 0; colourY < 2; colourY++)
+		{
+			for (int colourX = 0; colourX < 3; colourX++)
+			{
+				jobs.ParallelFor((size_t)columns * rows, s_CellChunkSize, [&](size_t begin, size_t end)
+				{
+					for (size_t i = begin; i < end; i++)
+					{
+						int x = colourX + 3 * (int)(i % columns);
+						int y = colourY + 2 * (int)(i / columns);
+						if (x < m_GridWidth && y < m_GridHeight)
+							CollideCell(x, y);
+					}
+				}, maxThreads);
+			}
+		}
+
+		jobs.ParallelFor(bodyCount, s_BodyChunkSize, [&](size_t begin, size_t end) { KeepInside(begin, end); }, maxThreads);
+	}
+}
@@ -0,0 +1,78 @@
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+#include <vector>
+
+#include "Span.h"
+#include "Vector.h"
+
+// Position based physics for thousands of circles, with Verlet integration
+// Bodies don't store a velocity: it is the difference between where they are and where they were last step
+// So fixing a constraint by moving a body also changes its velocity the right way, and the simulation stays stable with big time steps
+//
+// Each step moves the bodies, then a few times over: pulls connected bodies back to their distance, pushes overlapping circles apart and keeps everything inside the world
+// Both are split over the JobSystem without any locks, and without two threads ever writing the same body:
+// - Constraints are coloured so no two constraints of one colour share a body. One colour at a time, its constraints can be solved in any order on any thread
+// - Bodies are sorted into a grid of cells at least one circle wide, so circles can only touch circles in the same or a neighbouring cell.
+//   Cells are coloured in a 3 x 2 pattern, and cells of one colour are far enough apart that their neighbours never overlap
+// Every body is always updated in the same order with the same maths, so the result is exactly the same however many threads are used
+
+struct DistanceConstraint
+{
+	uint32_t A, B;
+	float Length;
+};
+
+class VerletWorld
+{
+private:
+	std::vector<Vector2> m_Positions;
+	std::vector<Vector2> m_PreviousPositions;
+	std::vector<float> m_Radii;
+	std::vector<float> m_InverseMasses;	// 0 means it never moves (pinned)
+	float m_MaxRadius = 0.0f;
+	Vector2 m_Min, m_Max;
+
+	std::vector<std::vector<DistanceConstraint>> m_Colours;	// The constraints, grouped by colour
+	std::vector<DistanceConstraint> m_SerialConstraints;	// The rare ones that didn't fit in any of the 64 colours, solved on one thread
+	std::vector<uint64_t> m_UsedColours;					// Per body, which colours its constraints already have
+	size_t m_ConstraintCount = 0;
+
+	// The grid: the bodies in cell i are m_CellBodies[m_CellStarts[i]] up to m_CellBodies[m_CellStarts[i + 1]]
+	float m_CellSize = 1.0f;
+	int m_GridWidth = 0, m_GridHeight = 0;
+	std::vector<uint32_t> m_CellStarts;
+	std::vector<uint32_t> m_CellBodies;
+	std::vector<uint32_t> m_BodyCells;
+	std::vector<uint32_t> m_CellFill;	// Where the next body of each cell goes while sorting
+
+	void Integrate(size_t begin, size_t end, float deltaTime);
+	void SolveConstraint(const DistanceConstraint& constraint);
+	void BuildGrid();
+	void CollideCell(int cellX, int cellY);
+	void CollideBodies(uint32_t a, uint32_t b);
+	void KeepInside(size_t begin, size_t end);
+public:
+	Vector2 Gravity = Vector2(0.0f, -9.81f);
+	int Iterations = 8;			// More iterations make constraints stiffer and stacks more solid, and take longer
+	float Damping = 0.999f;		// How much velocity is kept each step
+
+	// Everything stays inside the box from min to max
+	VerletWorld(const Vector2& min, const Vector2& max);
+
+	// Returns the index of the new body
+	uint32_t AddBody(const Vector2& position, float radius, float inverseMass = 1.0f);
+	// Keeps two bodies at the distance they are at now
+	void AddConstraint(uint32_t a, uint32_t b);
+	void AddConstraint(uint32_t a, uint32_t b, float length);
+
+	// maxThreads limits how many threads of the JobSystem are used (0 means all of them). It never changes the result
+	void Step(float deltaTime, size_t maxThreads = 0);
+
+	size_t BodyCount() const { return m_Positions.size(); }
+	size_t ConstraintCount() const { return m_ConstraintCount; }
+	size_t ColourCount() const { return m_Colours.size(); }
+	Span<const Vector2> GetPositions() const { return m_Positions; }
+	float GetRadius(uint32_t body) const { return m_Radii[body]; }
+};
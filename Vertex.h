@@ -0,0 +1,19 @@
+#pragma once
+
+#include <iostream>
+
+// Example classes and operators for std::vector
+struct Vertex
+{
+	float x, y, z;
+
+	Vertex()
+		: x(0.0f), y(0.0f), z(0.0f) {}
+	Vertex(float x, float y, float z)
+		: x(x), y(y), z(z) {}
+};
+inline std::ostream& operator<<(std::ostream& stream, const Vertex& vertex)
+{
+	stream << "(" << vertex.x << " | " << vertex.y << " | " << vertex.z << ")";
+	return stream;
+}